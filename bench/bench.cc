@@ -0,0 +1,168 @@
+#include "bench.h"
+#include "gurka.h"
+#include "loki/worker.h"
+#include "midgard/encoded.h"
+#include "midgard/logging.h"
+#include "midgard/util.h"
+#include "test.h"
+#include "thor/worker.h"
+#include "worker.h"
+
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+using namespace valhalla;
+
+// json for a list of locations
+std::string locations_json(const std::vector<midgard::PointLL>& points) {
+  std::ostringstream json;
+  json << std::fixed << std::setprecision(6) << '[';
+  for (size_t i = 0; i < points.size(); ++i) {
+    json << (i ? "," : "") << "{\"lat\":" << points[i].lat() << ",\"lon\":" << points[i].lng()
+         << '}';
+  }
+  json << ']';
+  return json.str();
+}
+
+// fills in the requests of a dataset from the locations they are made between
+void make_requests(bench::dataset_t& dataset,
+                   const midgard::PointLL& origin,
+                   const midgard::PointLL& destination,
+                   const std::vector<midgard::PointLL>& sources,
+                   const std::vector<midgard::PointLL>& targets,
+                   const midgard::PointLL& center,
+                   const int minutes) {
+  dataset.route = R"({"costing":"auto","locations":)" + locations_json({origin, destination}) + "}";
+  dataset.matrix = R"({"costing":"auto","sources":)" + locations_json(sources) +
+                   R"(,"targets":)" + locations_json(targets) + "}";
+  dataset.isochrone = R"({"costing":"auto","locations":)" + locations_json({center}) +
+                      R"(,"contours":[{"time":)" + std::to_string(minutes) + "}]}";
+
+  // the trace follows the route with a point every 50 meters like a gps would
+  auto api = bench::correlate(dataset, dataset.route, Options::route);
+  thor::thor_worker_t thor_worker(dataset.config, dataset.reader);
+  thor_worker.route(api);
+  auto shape =
+      midgard::decode<std::vector<midgard::PointLL>>(api.trip().routes(0).legs(0).shape());
+  shape = midgard::resample_spherical_polyline(shape, 50, false);
+  dataset.trace = gurka::detail::build_valhalla_request({"shape"}, {shape}, "auto", {}, "");
+}
+
+} // namespace
+
+namespace valhalla {
+namespace bench {
+
+const dataset_t& grid() {
+  static const dataset_t dataset = [] {
+    // a 7x7 grid of 200 meter blocks with alternating road classes
+    const std::string names = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvw";
+    constexpr size_t kSize = 7;
+    std::string ascii_map;
+    for (size_t row = 0; row < kSize; ++row) {
+      if (row > 0) {
+        for (int line = 0; line < 3; ++line) {
+          for (size_t column = 0; column < kSize; ++column) {
+            ascii_map += column ? "   |" : "|";
+          }
+          ascii_map += '\n';
+        }
+      }
+      for (size_t column = 0; column < kSize; ++column) {
+        ascii_map += (column ? "---" : "") + std::string(1, names[row * kSize + column]);
+      }
+      ascii_map += '\n';
+    }
+
+    gurka::ways ways;
+    for (size_t i = 0; i < kSize; ++i) {
+      std::string row, column;
+      for (size_t j = 0; j < kSize; ++j) {
+        row += names[i * kSize + j];
+        column += names[j * kSize + i];
+      }
+      ways[row] = {{"highway", i % 2 ? "residential" : "primary"},
+                   {"name", "Row " + std::to_string(i)}};
+      ways[column] = {{"highway", i % 3 ? "residential" : "secondary"},
+                      {"name", "Column " + std::to_string(i)}};
+    }
+
+    const auto layout = gurka::detail::map_to_coordinates(ascii_map, 50, {5.1, 52.1});
+    auto map = gurka::buildtiles(layout, ways, {}, {}, VALHALLA_BUILD_DIR "bench/data/grid");
+
+    dataset_t dataset;
+    dataset.name = "grid";
+    dataset.config = map.config;
+    dataset.reader = test::make_clean_graphreader(map.config.get_child("mjolnir"));
+    const auto& n = map.nodes;
+    make_requests(dataset, n.at("A"), n.at("w"), {n.at("A"), n.at("G"), n.at("q"), n.at("w")},
+                  {n.at("D"), n.at("V"), n.at("b"), n.at("t")}, n.at("Y"), 2);
+    return dataset;
+  }();
+  return dataset;
+}
+
+const dataset_t& utrecht() {
+  static const dataset_t dataset = [] {
+    dataset_t dataset;
+    dataset.name = "utrecht";
+    dataset.config = test::make_config(VALHALLA_BUILD_DIR "test/data/utrecht_tiles");
+    dataset.reader = test::make_clean_graphreader(dataset.config.get_child("mjolnir"));
+    const std::vector<midgard::PointLL> sources = {{5.101728, 52.106337},
+                                                   {5.089717, 52.111276},
+                                                   {5.081005, 52.103105},
+                                                   {5.06813, 52.103948}};
+    const std::vector<midgard::PointLL> targets = {{5.101497, 52.106126},
+                                                   {5.087099, 52.100469},
+                                                   {5.081005, 52.103105},
+                                                   {5.075254, 52.094273}};
+    make_requests(dataset, sources[0], targets[3], sources, targets, sources[2], 10);
+    return dataset;
+  }();
+  return dataset;
+}
+
+Api correlate(const dataset_t& dataset, const std::string& request, Options::Action action) {
+  Api api;
+  ParseApi(request, action, api);
+  loki::loki_worker_t loki_worker(dataset.config, dataset.reader);
+  switch (action) {
+    case Options::route:
+      loki_worker.route(api);
+      break;
+    case Options::sources_to_targets:
+      loki_worker.matrix(api);
+      break;
+    case Options::isochrone:
+      loki_worker.isochrones(api);
+      break;
+    default:
+      throw std::logic_error("No benchmark requests for " + Options_Action_Enum_Name(action));
+  }
+  thor::thor_worker_t::adjust_scores(*api.mutable_options());
+  return api;
+}
+
+sif::mode_costing_t costing(const Api& api, sif::TravelMode& mode) {
+  return sif::CostFactory().CreateModeCosting(api.options(), mode);
+}
+
+} // namespace bench
+} // namespace valhalla
+
+int main(int argc, char** argv) {
+  // the benchmarks shouldn't spend their time logging
+  valhalla::midgard::logging::Configure({{"type", ""}});
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "baldr/graphreader.h"
+#include "proto/api.pb.h"
+#include "sif/costfactory.h"
+
+#include <benchmark/benchmark.h>
+#include <boost/property_tree/ptree.hpp>
+
+#include <memory>
+#include <string>
+
+namespace valhalla {
+namespace bench {
+
+/**
+ * A tileset the benchmarks run against along with the requests they make of it. The tilesets are
+ * deterministic so that results can be compared between commits: the grid is generated by gurka
+ * from a fixed layout and the utrecht tiles are the ones the tests build from the checked in extract.
+ */
+struct dataset_t {
+  std::string name;
+  boost::property_tree::ptree config;
+  std::shared_ptr<baldr::GraphReader> reader;
+  // one of each kind of request the benchmarks make
+  std::string route;
+  std::string matrix;
+  std::string isochrone;
+  // a trace resampled from the shape of the route
+  std::string trace;
+};
+
+// benchmarks take one of these to be registered against each dataset
+using dataset_getter_t = const dataset_t& (*)();
+
+// the synthetic grid, built the first time it is asked for
+const dataset_t& grid();
+
+// the utrecht tiles of the tests
+const dataset_t& utrecht();
+
+/**
+ * Parses a request and runs it through loki, which is where everything past loki starts from
+ * @param dataset  the tileset the request is for
+ * @param request  the json request
+ * @param action   route, sources_to_targets or isochrone
+ * @return the request with its locations correlated to the graph
+ */
+Api correlate(const dataset_t& dataset, const std::string& request, Options::Action action);
+
+/**
+ * Makes the costing the request asks for
+ * @param api   the request
+ * @param mode  set to the travel mode of the costing
+ * @return the costing per travel mode
+ */
+sif::mode_costing_t costing(const Api& api, sif::TravelMode& mode);
+
+} // namespace bench
+} // namespace valhalla
@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+"""
+Fits the coefficients of thor's matrix cost model to the runs of the MatrixCostModel benchmarks and
+prints them as the thor.matrix_cost_model part of a valhalla config.
+
+The model of each algorithm and travel mode is
+
+  ms = fixed + per_location * (sources + targets)
+       + searches * (per_search_km * spread + per_search_km2 * spread^2)
+       + per_pair * sources * targets
+
+where CostMatrix has sources + targets searches and TimeDistanceMatrix min(sources, targets). The
+coefficients are fitted by least squares on the relative error, so small and large matrices count
+the same, and are kept non negative. They are fitted on the runs without a time, the time dependent
+factor then scales them to the runs with one.
+"""
+
+import json
+import sys
+from argparse import ArgumentParser
+from collections import defaultdict
+
+COEFFICIENTS = ['fixed', 'per_location', 'per_search_km', 'per_search_km2', 'per_pair']
+TO_MS = {'ns': 1e-6, 'us': 1e-3, 'ms': 1.0, 's': 1e3}
+
+
+def features(algorithm: str, sources: float, targets: float, spread: float) -> list:
+    searches = sources + targets if algorithm == 'costmatrix' else min(sources, targets)
+    return [1.0, sources + targets, searches * spread, searches * spread**2, sources * targets]
+
+
+def solve(a: list, b: list) -> list:
+    """solves a small linear system with gaussian elimination, singular columns come out as 0"""
+    n = len(b)
+    m = [row[:] + [b[i]] for i, row in enumerate(a)]
+    for c in range(n):
+        pivot = max(range(c, n), key=lambda r: abs(m[r][c]))
+        if abs(m[pivot][c]) < 1e-12:
+            continue
+        m[c], m[pivot] = m[pivot], m[c]
+        for r in range(n):
+            if r != c and m[r][c]:
+                f = m[r][c] / m[c][c]
+                m[r] = [x - f * y for x, y in zip(m[r], m[c])]
+    return [m[i][n] / m[i][i] if abs(m[i][i]) >= 1e-12 else 0.0 for i in range(n)]
+
+
+def fit(rows: list, times: list) -> list:
+    """non negative least squares on the relative error by dropping the most negative coefficient"""
+    # dividing every row by its time makes the residuals relative
+    rows = [[x / t for x in row] for row, t in zip(rows, times)]
+    active = list(range(len(COEFFICIENTS)))
+    while True:
+        ata = [[sum(r[i] * r[j] for r in rows) for j in active] for i in active]
+        atb = [sum(r[i] for r in rows) for i in active]
+        solution = solve(ata, atb)
+        worst = min(range(len(active)), key=lambda i: solution[i])
+        if solution[worst] >= 0 or len(active) == 1:
+            break
+        del active[worst]
+    coefficients = [0.0] * len(COEFFICIENTS)
+    for i, value in zip(active, solution):
+        coefficients[i] = max(value, 0.0)
+    return coefficients
+
+
+def fit_factor(predicted: list, times: list) -> float:
+    """least squares on the relative error of a factor scaling the predictions, 1 without runs"""
+    ratios = [p / t for p, t in zip(predicted, times)]
+    squares = sum(r * r for r in ratios)
+    return sum(ratios) / squares if squares > 0 else 1.0
+
+
+def main():
+    parser = ArgumentParser(description=__doc__.strip().split('\n')[0])
+    parser.add_argument(
+        'results', help='The json output of valhalla_bench with the MatrixCostModel runs'
+    )
+    args = parser.parse_args()
+
+    with open(args.results) as f:
+        results = json.load(f)
+
+    # the runs without and with a time per travel mode and algorithm
+    runs = defaultdict(lambda: (([], []), ([], [])))
+    for run in results['benchmarks']:
+        if not run['name'].startswith('MatrixCostModel/') or run.get('run_type') == 'aggregate':
+            continue
+        mode, algorithm = run['label'].split('/')
+        rows, times = runs[(mode, algorithm)][int(run.get('time_dependent', 0) > 0)]
+        rows.append(features(algorithm, run['sources'], run['targets'], run['spread']))
+        times.append(run['real_time'] * TO_MS[run['time_unit']])
+
+    model = defaultdict(dict)
+    for (mode, algorithm), ((rows, times), (td_rows, td_times)) in sorted(runs.items()):
+        coefficients = fit(rows, times)
+        predicted = [sum(c * x for c, x in zip(coefficients, row)) for row in rows]
+        error = sum(abs(p - t) / t for p, t in zip(predicted, times)) / len(times)
+        td_predicted = [sum(c * x for c, x in zip(coefficients, row)) for row in td_rows]
+        factor = fit_factor(td_predicted, td_times)
+        td_error = sum(abs(factor * p - t) / t for p, t in zip(td_predicted, td_times))
+        td_error = td_error / len(td_times) if td_times else 0.0
+        print(
+            f'{mode}/{algorithm}: {len(times)} runs, mean relative error {error:.1%}, '
+            f'{len(td_times)} time dependent runs, factor {factor:.2f}, '
+            f'mean relative error {td_error:.1%}',
+            file=sys.stderr,
+        )
+        model[mode][algorithm] = {name: round(c, 9) for name, c in zip(COEFFICIENTS, coefficients)}
+        model[mode][algorithm]['time_dependent_factor'] = round(factor, 6)
+
+    print(json.dumps({'thor': {'matrix_cost_model': model}}, sort_keys=True, indent=2))
+
+
+if __name__ == '__main__':
+    main()
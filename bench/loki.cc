@@ -0,0 +1,82 @@
+#include "bench.h"
+#include "loki/search.h"
+#include "midgard/encoded.h"
+#include "worker.h"
+
+#include <string>
+#include <vector>
+
+using namespace valhalla;
+
+namespace {
+
+// a trace_route request with a long shape passed as plain points, as points with a member the
+// streaming reader doesn't handle so they go through the dom, or as an encoded polyline
+enum class shape_t { points, dom_points, encoded_polyline };
+
+std::string trace_request(const shape_t shape, const size_t count) {
+  std::vector<midgard::PointLL> points;
+  for (size_t i = 0; i < count; ++i) {
+    points.emplace_back(5.11 + i * 1e-5, 52.09 + i * 1e-5);
+  }
+  if (shape == shape_t::encoded_polyline) {
+    return R"({"costing":"auto","encoded_polyline":")" + midgard::encode(points) + R"("})";
+  }
+  std::string request = R"({"costing":"auto","shape_match":"map_snap","shape":[)";
+  for (size_t i = 0; i < count; ++i) {
+    request += R"({"lat":)" + std::to_string(points[i].lat()) + R"(,"lon":)" +
+               std::to_string(points[i].lng()) + R"(,"time":)" + std::to_string(i) +
+               (shape == shape_t::dom_points ? R"(,"name":"x"})" : "}");
+    request += i + 1 < count ? "," : "";
+  }
+  return request + R"(],"trace_options":{"search_radius":25}})";
+}
+
+// parses a trace request into the options, which is all loki does before correlating it
+void ParseTrace(benchmark::State& state, const shape_t shape) {
+  const auto request = trace_request(shape, state.range(0));
+  for (auto _ : state) {
+    Api api;
+    ParseApi(request, Options::trace_route, api);
+    benchmark::DoNotOptimize(api);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * request.size());
+}
+
+// correlates every point of the trace in one search, which is what loki does for a long route
+void Search(benchmark::State& state, bench::dataset_getter_t get) {
+  const auto& dataset = get();
+  Api api;
+  ParseApi(dataset.trace, Options::trace_attributes, api);
+  sif::TravelMode mode;
+  auto mode_costing = bench::costing(api, mode);
+
+  std::vector<baldr::Location> locations;
+  for (const auto& point : api.options().shape()) {
+    locations.emplace_back(midgard::PointLL{point.ll().lng(), point.ll().lat()});
+  }
+
+  for (auto _ : state) {
+    auto results = loki::Search(locations, *dataset.reader, mode_costing[static_cast<size_t>(mode)]);
+    benchmark::DoNotOptimize(results);
+  }
+  state.SetItemsProcessed(state.iterations() * locations.size());
+}
+
+BENCHMARK_CAPTURE(Search, grid, bench::grid)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(Search, utrecht, bench::utrecht)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(ParseTrace, points, shape_t::points)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(ParseTrace, dom_points, shape_t::dom_points)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(ParseTrace, encoded_polyline, shape_t::encoded_polyline)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
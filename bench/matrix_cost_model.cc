@@ -0,0 +1,117 @@
+#include "bench.h"
+#include "midgard/distanceapproximator.h"
+#include "thor/costmatrix.h"
+#include "thor/matrix_cost_model.h"
+#include "thor/timedistancematrix.h"
+
+#include <cmath>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+using namespace valhalla;
+
+namespace {
+
+// a costing of each travel mode the cost model is calibrated for and the name of the travel mode in
+// its config, by the index the benchmarks are registered with
+const std::vector<std::pair<std::string, std::string>> kCostings = {{"auto", "drive"},
+                                                                    {"pedestrian", "pedestrian"},
+                                                                    {"bicycle", "bicycle"}};
+
+// the middle of the utrecht tiles, which reach about 4 km out from it in every direction
+const midgard::PointLL kCenter(5.09, 52.09);
+
+// a matrix request with locations spread evenly over a square with the given diagonal, departing
+// on a weekday morning if it is time dependent. the locations are the same for every run so runs
+// can be compared
+std::string request(const std::string& costing,
+                    const int64_t sources,
+                    const int64_t targets,
+                    const double spread,
+                    const bool time_dependent) {
+  std::mt19937 generator(static_cast<uint32_t>(sources * 1000 + targets + spread));
+  const double side = spread / std::sqrt(2.) / 2.;
+  const double lat_offset = side / midgard::kMetersPerDegreeLat;
+  const double lng_offset =
+      side / midgard::DistanceApproximator<midgard::PointLL>::MetersPerLngDegree(kCenter.lat());
+  auto locations = [&](int64_t count) {
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(6) << '[';
+    for (int64_t i = 0; i < count; ++i) {
+      // mt19937 is the same everywhere unlike the distributions
+      const double x = generator() / double(generator.max()) * 2. - 1.;
+      const double y = generator() / double(generator.max()) * 2. - 1.;
+      json << (i ? "," : "") << "{\"lat\":" << kCenter.lat() + y * lat_offset
+           << ",\"lon\":" << kCenter.lng() + x * lng_offset << '}';
+    }
+    json << ']';
+    return json.str();
+  };
+  return R"({"costing":")" + costing + R"(","sources":)" + locations(sources) +
+         R"(,"targets":)" + locations(targets) +
+         (time_dependent ? R"(,"date_time":{"type":1,"value":"2024-10-09T08:00"}})" : "}");
+}
+
+// runs one algorithm on one request, the label and counters are what
+// bench/fit_matrix_cost_model.py fits the coefficients of the cost model from
+void MatrixCostModel(benchmark::State& state) {
+  const auto algorithm = static_cast<Matrix::Algorithm>(state.range(0));
+  const auto& costing = kCostings[state.range(1)].first;
+  const auto& dataset = bench::utrecht();
+  auto prepared = bench::correlate(dataset,
+                                   request(costing, state.range(2), state.range(3), state.range(4),
+                                           state.range(5)),
+                                   Options::sources_to_targets);
+  sif::TravelMode mode;
+  auto mode_costing = bench::costing(prepared, mode);
+  // whether the request is time dependent is decided the same way thor does it
+  const bool has_time = thor::check_matrix_time(prepared, Matrix::TimeDistanceMatrix);
+
+  thor::CostMatrix costmatrix(dataset.config.get_child("thor"));
+  thor::TimeDistanceMatrix time_distance_matrix(dataset.config.get_child("thor"));
+  thor::MatrixAlgorithm& matrix = algorithm == Matrix::CostMatrix
+                                      ? static_cast<thor::MatrixAlgorithm&>(costmatrix)
+                                      : static_cast<thor::MatrixAlgorithm&>(time_distance_matrix);
+  matrix.set_has_time(has_time);
+  for (auto _ : state) {
+    state.PauseTiming();
+    Api api = prepared;
+    state.ResumeTiming();
+    matrix.SourceToTarget(api, *dataset.reader, mode_costing, mode, 400000.f);
+    matrix.Clear();
+  }
+
+  // the features are taken the same way thor takes them
+  const auto features = thor::MatrixCostModel::features(prepared.options(), has_time);
+  state.SetLabel(kCostings[state.range(1)].second + "/" + MatrixAlgoToString(algorithm));
+  state.counters["sources"] = features.sources;
+  state.counters["targets"] = features.targets;
+  state.counters["spread"] = features.spread;
+  state.counters["time_dependent"] = features.time_dependent;
+}
+
+// sweeps the shapes of matrices, from one to many, many to one and many to many, over a few spreads.
+// the shapes with no more sources than targets also run departing at a time, the others would
+// have to arrive at one which CostMatrix can't do so thor always leaves them to TimeDistanceMatrix
+void Sweep(benchmark::internal::Benchmark* benchmark) {
+  const std::vector<std::pair<int64_t, int64_t>> shapes = {{1, 1},   {1, 10}, {10, 1}, {1, 50},
+                                                           {5, 5},   {5, 25}, {10, 10},
+                                                           {25, 25}, {50, 50}};
+  for (int64_t algorithm : {Matrix::CostMatrix, Matrix::TimeDistanceMatrix}) {
+    for (int64_t costing = 0; costing < static_cast<int64_t>(kCostings.size()); ++costing) {
+      for (const auto& shape : shapes) {
+        for (int64_t spread : {1000, 3000, 6000}) {
+          benchmark->Args({algorithm, costing, shape.first, shape.second, spread, 0});
+          if (shape.first <= shape.second) {
+            benchmark->Args({algorithm, costing, shape.first, shape.second, spread, 1});
+          }
+        }
+      }
+    }
+  }
+}
+
+BENCHMARK(MatrixCostModel)->Apply(Sweep)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,39 @@
+#include "bench.h"
+#include "meili/map_matcher_factory.h"
+#include "worker.h"
+
+using namespace valhalla;
+
+namespace {
+
+void OfflineMatch(benchmark::State& state, bench::dataset_getter_t get) {
+  const auto& dataset = get();
+  Api api;
+  ParseApi(dataset.trace, Options::trace_attributes, api);
+
+  meili::MapMatcherFactory factory(dataset.config, dataset.reader);
+  std::unique_ptr<meili::MapMatcher> matcher(factory.Create(api.options()));
+  const auto& config = matcher->config();
+  std::vector<meili::Measurement> measurements;
+  for (const auto& point : api.options().shape()) {
+    measurements.emplace_back(midgard::PointLL{point.ll().lng(), point.ll().lat()},
+                              config.emission_cost.gps_accuracy_meters,
+                              config.candidate_search.search_radius_meters);
+  }
+
+  for (auto _ : state) {
+    auto results = matcher->OfflineMatch(measurements);
+    benchmark::DoNotOptimize(results);
+    // forget the candidates like the end of a request would so each match searches for them again
+    state.PauseTiming();
+    matcher.reset(factory.Create(api.options()));
+    factory.ClearFullCache();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * measurements.size());
+}
+
+BENCHMARK_CAPTURE(OfflineMatch, grid, bench::grid)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(OfflineMatch, utrecht, bench::utrecht)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,62 @@
+#include "bench.h"
+#include "midgard/distanceapproximator.h"
+#include "midgard/polyline2.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace valhalla;
+
+namespace {
+
+// an isochrone contour the size of a few hours of driving, a ring of about 300 km across whose
+// radius wanders on a few scales like a contour around the road network does. the same number of
+// points always makes the same contour so runs can be compared
+std::vector<midgard::PointLL> contour(const size_t points) {
+  const midgard::PointLL center(5.09, 52.09);
+  const double lng_scale =
+      midgard::kMetersPerDegreeLat /
+      midgard::DistanceApproximator<midgard::PointLL>::MetersPerLngDegree(center.lat());
+  std::mt19937 generator(static_cast<uint32_t>(points));
+  std::vector<midgard::PointLL> ring;
+  ring.reserve(points + 1);
+  for (size_t i = 0; i < points; ++i) {
+    const double angle = 2 * M_PI * i / points;
+    // mt19937 is the same everywhere unlike the distributions
+    const double jitter = generator() / double(generator.max()) - .5;
+    const double meters = 150000 + 30000 * std::sin(3 * angle) + 8000 * std::sin(17 * angle) +
+                          1500 * std::sin(131 * angle) + 200 * jitter;
+    const double degrees = meters / midgard::kMetersPerDegreeLat;
+    ring.emplace_back(center.lng() + degrees * lng_scale * std::cos(angle),
+                      center.lat() + degrees * std::sin(angle));
+  }
+  ring.push_back(ring.front());
+  return ring;
+}
+
+// generalizes a contour the way isochrones are, the tolerance is in meters
+void Generalize(benchmark::State& state, const bool avoid_self_intersections) {
+  const auto ring = contour(state.range(0));
+  size_t generalized_points = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto polyline = ring;
+    state.ResumeTiming();
+    midgard::Polyline2<midgard::PointLL>::Generalize(polyline, 50, {}, avoid_self_intersections);
+    generalized_points = polyline.size();
+  }
+  state.SetItemsProcessed(state.iterations() * ring.size());
+  state.counters["generalized_points"] = generalized_points;
+}
+
+BENCHMARK_CAPTURE(Generalize, douglas_peucker, false)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 19)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(Generalize, avoid_self_intersections, true)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 19)
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,30 @@
+#include "bench.h"
+#include "odin/directionsbuilder.h"
+#include "odin/markup_formatter.h"
+#include "thor/worker.h"
+
+using namespace valhalla;
+
+namespace {
+
+void DirectionsBuilder(benchmark::State& state, bench::dataset_getter_t get) {
+  const auto& dataset = get();
+  auto prepared = bench::correlate(dataset, dataset.route, Options::route);
+  thor::thor_worker_t thor_worker(dataset.config, dataset.reader);
+  thor_worker.route(prepared);
+
+  const odin::MarkupFormatter markup_formatter(dataset.config);
+  for (auto _ : state) {
+    // directions are added to the request so each iteration starts from a fresh copy
+    state.PauseTiming();
+    Api api = prepared;
+    state.ResumeTiming();
+    odin::DirectionsBuilder::Build(api, markup_formatter);
+    benchmark::DoNotOptimize(api);
+  }
+}
+
+BENCHMARK_CAPTURE(DirectionsBuilder, grid, bench::grid)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(DirectionsBuilder, utrecht, bench::utrecht)->Unit(benchmark::kMicrosecond);
+
+} // namespace
@@ -0,0 +1,108 @@
+#include "bench.h"
+#include "baldr/attributes_controller.h"
+#include "thor/bidirectional_astar.h"
+#include "thor/costmatrix.h"
+#include "thor/isochrone.h"
+#include "thor/timedistancematrix.h"
+#include "thor/triplegbuilder.h"
+
+using namespace valhalla;
+
+namespace {
+
+void BidirectionalAStar(benchmark::State& state, bench::dataset_getter_t get) {
+  const auto& dataset = get();
+  auto api = bench::correlate(dataset, dataset.route, Options::route);
+  sif::TravelMode mode;
+  auto mode_costing = bench::costing(api, mode);
+  auto& locations = *api.mutable_options()->mutable_locations();
+
+  thor::BidirectionalAStar astar(dataset.config.get_child("thor"));
+  for (auto _ : state) {
+    auto paths = astar.GetBestPath(locations[0], locations[1], *dataset.reader, mode_costing, mode,
+                                   api.options());
+    benchmark::DoNotOptimize(paths);
+    astar.Clear();
+  }
+}
+
+template <typename matrix_t>
+void SourceToTarget(benchmark::State& state, bench::dataset_getter_t get) {
+  const auto& dataset = get();
+  const auto prepared = bench::correlate(dataset, dataset.matrix, Options::sources_to_targets);
+  sif::TravelMode mode;
+  auto mode_costing = bench::costing(prepared, mode);
+
+  matrix_t matrix(dataset.config.get_child("thor"));
+  for (auto _ : state) {
+    // the matrix is written into the request so each iteration starts from a fresh copy
+    state.PauseTiming();
+    Api api = prepared;
+    state.ResumeTiming();
+    matrix.SourceToTarget(api, *dataset.reader, mode_costing, mode, 400000.f);
+    matrix.Clear();
+  }
+  state.SetItemsProcessed(state.iterations() * prepared.options().sources_size() *
+                          prepared.options().targets_size());
+}
+
+void CostMatrix(benchmark::State& state, bench::dataset_getter_t get) {
+  SourceToTarget<thor::CostMatrix>(state, get);
+}
+
+void TimeDistanceMatrix(benchmark::State& state, bench::dataset_getter_t get) {
+  SourceToTarget<thor::TimeDistanceMatrix>(state, get);
+}
+
+void Isochrone(benchmark::State& state, bench::dataset_getter_t get) {
+  const auto& dataset = get();
+  const auto prepared = bench::correlate(dataset, dataset.isochrone, Options::isochrone);
+  sif::TravelMode mode;
+  auto mode_costing = bench::costing(prepared, mode);
+
+  thor::Isochrone isochrone(dataset.config.get_child("thor"));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Api api = prepared;
+    state.ResumeTiming();
+    auto grid = isochrone.Expand(thor::ExpansionType::forward, api, *dataset.reader, mode_costing,
+                                 mode);
+    benchmark::DoNotOptimize(grid);
+  }
+}
+
+void TripLegBuilder(benchmark::State& state, bench::dataset_getter_t get) {
+  const auto& dataset = get();
+  auto api = bench::correlate(dataset, dataset.route, Options::route);
+  sif::TravelMode mode;
+  auto mode_costing = bench::costing(api, mode);
+  auto& locations = *api.mutable_options()->mutable_locations();
+
+  // the path is found once, only forming the leg from it is measured
+  thor::BidirectionalAStar astar(dataset.config.get_child("thor"));
+  const auto path = astar.GetBestPath(locations[0], locations[1], *dataset.reader, mode_costing,
+                                      mode, api.options())
+                        .front();
+  const baldr::AttributesController controller(api.options());
+  for (auto _ : state) {
+    TripLeg leg;
+    thor::TripLegBuilder::Build(api.options(), controller, *dataset.reader, mode_costing,
+                                path.begin(), path.end(), locations[0], locations[1], leg,
+                                {astar.name()});
+    benchmark::DoNotOptimize(leg);
+  }
+  state.SetItemsProcessed(state.iterations() * path.size());
+}
+
+BENCHMARK_CAPTURE(BidirectionalAStar, grid, bench::grid)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BidirectionalAStar, utrecht, bench::utrecht)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(CostMatrix, grid, bench::grid)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(CostMatrix, utrecht, bench::utrecht)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(TimeDistanceMatrix, grid, bench::grid)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(TimeDistanceMatrix, utrecht, bench::utrecht)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(Isochrone, grid, bench::grid)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(Isochrone, utrecht, bench::utrecht)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(TripLegBuilder, grid, bench::grid)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(TripLegBuilder, utrecht, bench::utrecht)->Unit(benchmark::kMicrosecond);
+
+} // namespace
@@ -0,0 +1,56 @@
+#include "bench.h"
+#include "odin/worker.h"
+#include "thor/worker.h"
+#include "tyr/serializers.h"
+
+using namespace valhalla;
+
+namespace {
+
+void SerializeDirections(benchmark::State& state,
+                         bench::dataset_getter_t get,
+                         const Options::Format format) {
+  const auto& dataset = get();
+  auto api = bench::correlate(dataset, dataset.route, Options::route);
+  api.mutable_options()->set_format(format);
+  thor::thor_worker_t thor_worker(dataset.config, dataset.reader);
+  thor_worker.route(api);
+  odin::odin_worker_t odin_worker(dataset.config);
+  odin_worker.narrate(api);
+
+  size_t bytes = 0;
+  for (auto _ : state) {
+    auto response = tyr::serializeDirections(api);
+    bytes += response.size();
+    benchmark::DoNotOptimize(response);
+  }
+  state.SetBytesProcessed(bytes);
+}
+
+void SerializeMatrix(benchmark::State& state, bench::dataset_getter_t get) {
+  const auto& dataset = get();
+  auto api = bench::correlate(dataset, dataset.matrix, Options::sources_to_targets);
+  thor::thor_worker_t thor_worker(dataset.config, dataset.reader);
+  thor_worker.matrix(api);
+
+  size_t bytes = 0;
+  for (auto _ : state) {
+    auto response = tyr::serializeMatrix(api);
+    bytes += response.size();
+    benchmark::DoNotOptimize(response);
+  }
+  state.SetBytesProcessed(bytes);
+}
+
+BENCHMARK_CAPTURE(SerializeDirections, grid_json, bench::grid, Options::json)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(SerializeDirections, utrecht_json, bench::utrecht, Options::json)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(SerializeDirections, utrecht_osrm, bench::utrecht, Options::osrm)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(SerializeDirections, utrecht_pbf, bench::utrecht, Options::pbf)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(SerializeMatrix, grid, bench::grid)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(SerializeMatrix, utrecht, bench::utrecht)->Unit(benchmark::kMicrosecond);
+
+} // namespace
@@ -42,6 +42,7 @@ env DEBIAN_FRONTEND=noninteractive sudo apt install --yes --quiet \
     pkgconf \
     protobuf-compiler \
     python3-all-dev \
+    python3-numpy \
     python3-shapely \
     python3-requests \
     python3-pip \
@@ -702,6 +702,11 @@ from_cache(const TP& tp,
   infos.emplace_back(tp.get_info());
   return infos.back();
 }
+
+// the offset tables cover 1970 through 2099, beyond that the timezone library is asked
+constexpr int64_t kOffsetTableEnd = 4102444800;
+// the tables are bucketed by about half a year so a lookup only steps over a transition or two
+constexpr int kOffsetBucketShift = 24;
 } // namespace
 
 using namespace valhalla::baldr;
@@ -709,6 +714,52 @@ namespace valhalla {
 namespace baldr {
 namespace DateTime {
 
+// the utc offset in effect from each of the times until the next one
+struct tz_offsets_t {
+  explicit tz_offsets_t(const date::time_zone* tz) {
+    // walk the timezone's history keeping only the changes of offset
+    date::sys_seconds time{};
+    const date::sys_seconds end{std::chrono::seconds(kOffsetTableEnd)};
+    while (time < end) {
+      const auto info = tz->get_info(time);
+      const auto offset = static_cast<int32_t>(info.offset.count());
+      if (offsets.empty() || offsets.back() != offset) {
+        begins.push_back(time.time_since_epoch().count());
+        offsets.push_back(offset);
+      }
+      if (info.end <= time) {
+        break;
+      }
+      time = info.end;
+    }
+
+    // remember which offset is in effect at the start of each bucket
+    const size_t bucket_count = (kOffsetTableEnd >> kOffsetBucketShift) + 1;
+    buckets.reserve(bucket_count);
+    uint32_t i = 0;
+    for (size_t bucket = 0; bucket < bucket_count; ++bucket) {
+      const auto bucket_begin = static_cast<int64_t>(bucket) << kOffsetBucketShift;
+      while (i + 1 < begins.size() && begins[i + 1] <= bucket_begin) {
+        ++i;
+      }
+      buckets.push_back(i);
+    }
+  }
+
+  // seconds must be before the end of the table
+  int32_t offset(const uint64_t seconds) const {
+    uint32_t i = buckets[seconds >> kOffsetBucketShift];
+    while (i + 1 < begins.size() && begins[i + 1] <= static_cast<int64_t>(seconds)) {
+      ++i;
+    }
+    return offsets[i];
+  }
+
+  std::vector<int64_t> begins;
+  std::vector<int32_t> offsets;
+  std::vector<uint32_t> buckets;
+};
+
 tz_db_t::tz_db_t() {
   const auto& db = date::get_tzdb();
 
@@ -723,6 +774,19 @@ tz_db_t::tz_db_t() {
     auto* tz = db.locate_zone(tz_pair.first);
     zones[tz_pair.second] = &*tz;
   }
+
+  // the offset tables are made as each timezone gets used
+  offset_tables_size = 0;
+  for (const auto& zone : zones) {
+    offset_tables_size = std::max(offset_tables_size, zone.first + 1);
+  }
+  offset_tables.reset(new std::atomic<const tz_offsets_t*>[offset_tables_size]());
+}
+
+tz_db_t::~tz_db_t() {
+  for (size_t i = 0; i < offset_tables_size; ++i) {
+    delete offset_tables[i].load();
+  }
 }
 
 size_t tz_db_t::to_index(const std::string& zone) const {
@@ -738,6 +802,36 @@ const date::time_zone* tz_db_t::from_index(size_t index) const {
   return it != zones.end() ? it->second : nullptr;
 }
 
+const tz_offsets_t& tz_db_t::offsets(size_t index) const {
+  auto& table = offset_tables[index];
+  const tz_offsets_t* offsets = table.load(std::memory_order_acquire);
+  if (offsets == nullptr) {
+    // if another thread beat us to it we use theirs instead
+    auto* made = new tz_offsets_t(from_index(index));
+    if (table.compare_exchange_strong(offsets, made, std::memory_order_acq_rel)) {
+      offsets = made;
+    } else {
+      delete made;
+    }
+  }
+  return *offsets;
+}
+
+int tz_db_t::timezone_diff(const uint64_t seconds,
+                           size_t origin_index,
+                           size_t dest_index,
+                           tz_sys_info_cache_t* cache) const {
+  const auto* origin_tz = from_index(origin_index);
+  const auto* dest_tz = from_index(dest_index);
+  if (!origin_tz || !dest_tz || origin_tz == dest_tz) {
+    return 0;
+  }
+  if (seconds >= static_cast<uint64_t>(kOffsetTableEnd)) {
+    return DateTime::timezone_diff(seconds, origin_tz, dest_tz, cache);
+  }
+  return offsets(dest_index).offset(seconds) - offsets(origin_index).offset(seconds);
+}
+
 const tz_db_t& get_tz_db() {
   static const tz_db_t tz_db;
   return tz_db;
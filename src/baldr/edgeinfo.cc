@@ -428,15 +428,20 @@ uint16_t EdgeInfo::GetTypes() const {
 const std::vector<midgard::PointLL>& EdgeInfo::shape() const {
   // if we haven't yet decoded the shape, do so
   if (encoded_shape_ != nullptr && shape_.empty()) {
-    shape_ = midgard::decode7<std::vector<midgard::PointLL>>(encoded_shape_, ei_.encoded_shape_size_);
+    shape_.reserve(ei_.encoded_shape_size_ / 4);
+    for (auto decoder = lazy_shape(); !decoder.empty();) {
+      shape_.emplace_back(decoder.pop());
+    }
   }
   return shape_;
 }
 
 // Returns the encoded shape string
 std::string EdgeInfo::encoded_shape() const {
-  return encoded_shape_ == nullptr ? midgard::encode7(shape_)
-                                   : std::string(encoded_shape_, ei_.encoded_shape_size_);
+  if (encoded_shape_ == nullptr || ei_.packed_shape_) {
+    return midgard::encode7(shape());
+  }
+  return std::string(encoded_shape_, ei_.encoded_shape_size_);
 }
 
 // Returns the encoded elevation along the edge as well as the sampling interval.
@@ -9,6 +9,8 @@
 #include "incident_singleton.h"
 #include "midgard/encoded.h"
 #include "midgard/logging.h"
+#include "midgard/metrics.h"
+#include "midgard/tracing.h"
 #include "shortcut_recovery.h"
 
 using namespace valhalla::midgard;
@@ -19,6 +21,9 @@ constexpr size_t DEFAULT_MAX_CACHE_SIZE = 1073741824; // 1 gig
 constexpr size_t AVERAGE_TILE_SIZE = 2097152;         // 2 megs
 constexpr size_t AVERAGE_MM_TILE_SIZE = 1024;         // 1k
 
+// the sub phase tiles which aren't in the cache yet are timed as
+const std::string kTileLoad = "tile_load";
+
 struct tile_index_entry {
   uint64_t offset;  // byte offset from the beginning of the tar
   uint32_t tile_id; // just level and tileindex hence fitting in 32bits
@@ -559,6 +564,8 @@ graph_tile_ptr GraphReader::GetGraphTile(const GraphId& graphid) {
     // LOG_DEBUG("Memory cache hit " + GraphTile::FileSuffix(base));
     return cached;
   }
+  metrics::scoped_timer_t timer(metrics::kNoAction, kTileLoad);
+  VALHALLA_TRACE_SCOPE("baldr", "tile_load");
 
   // Try getting it from the memmapped tar extract
   if (!tile_extract_->tiles.empty()) {
@@ -10,6 +10,7 @@
 #include "midgard/pointll.h"
 #include "midgard/tiles.h"
 
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
 #include <chrono>
 #include <cmath>
@@ -272,7 +273,15 @@ void GraphTile::Initialize(const GraphId& graphid) {
                              " vs raw tile data size = " + std::to_string(tile_size) +
                              ". Tile file might me corrupted");
 
-  // TODO check version
+  // a newer format may store things this software would silently misread
+  if (header_->format_version() > kTileFormatVersion)
+    throw std::runtime_error("Tile format version " + std::to_string(header_->format_version()) +
+                             " is newer than the supported version " +
+                             std::to_string(kTileFormatVersion) + ". Tile needs newer software");
+  if (header_->has_packed_shapes() && header_->format_version() < kPackedShapesFormatVersion)
+    throw std::runtime_error("Tile has packed shapes but format version " +
+                             std::to_string(header_->format_version()) +
+                             ". Tile file might be corrupted");
 
   // Set a pointer to the node list
   nodes_ = reinterpret_cast<NodeInfo*>(ptr);
@@ -366,6 +375,14 @@ void GraphTile::Initialize(const GraphId& graphid) {
     lane_connectivity_size_ = header_->end_offset() - header_->lane_connectivity_offset();
   }
 
+  // Reach labels, these and the predicted speeds are appended in either order after the lane
+  // connectivity so whichever of them comes first ends it
+  if (header_->reach_labels_offset() > 0) {
+    reach_labels_ = reinterpret_cast<ReachLabel*>(tile_ptr + header_->reach_labels_offset());
+    std::size_t size = header_->reach_labels_offset() - header_->lane_connectivity_offset();
+    lane_connectivity_size_ = std::min(lane_connectivity_size_, size);
+  }
+
   // For reference - how to use the end offset to set size of an object (that
   // is not fixed size and count).
   // example_size_ = header_->end_offset() - header_->example_offset();
@@ -5,3 +5,6 @@ except ModuleNotFoundError:
 
 from .actor import Actor
 from .config import get_config
+from .matrix import decode_matrix
+from .pool import ActorPool
+from .trace import decode_trace_attributes
@@ -16,7 +16,9 @@ def dict_or_str(func):
             return func(*args)
 
         if isinstance(args[1], dict):
-            return json.loads(func(args[0], json.dumps(args[1])))
+            res = func(args[0], json.dumps(args[1]))
+            # binary formats like columnar matrices are handed back as is
+            return res if isinstance(res, bytes) else json.loads(res)
         elif not isinstance(args[1], str):
             raise ValueError("Request must be either of type str or dict")
         return func(*args)
@@ -0,0 +1,55 @@
+import struct
+from typing import Union
+
+# mirrors valhalla::tyr::columnar_matrix_header_t
+_HEADER = struct.Struct("<4sBBBBIIQ8x")
+_MAGIC = b"VMTX"
+_VERSION = 1
+
+_ENCODINGS = ("raw", "delta", "float16")
+_DTYPES = ("<f4", "<i4", "<f2")
+_ALGORITHMS = ("timedistancematrix", "costmatrix", "timedistancebssmatrix")
+_UNITS = ("kilometers", "miles")
+
+
+def decode_matrix(buf: Union[bytes, bytearray, memoryview]) -> dict:
+    """
+    Decodes a matrix response requested with "format": "columnar" into numpy arrays.
+
+    raw and float16 columns are views into the given buffer without copying it, delta columns
+    have to be summed up and are returned as float64. Unreachable cells are NaN.
+
+    :param buf: The bytes returned by Actor.matrix
+    :return: A dict with "durations" and "distances" arrays shaped (sources, targets) as well
+             as the "units", "algorithm" and "encoding" of the response
+    """
+    import numpy as np
+
+    magic, version, encoding, algorithm, units, sources, targets, column_bytes = _HEADER.unpack_from(buf)
+    if magic != _MAGIC:
+        raise ValueError("Not a columnar matrix response")
+    if version != _VERSION:
+        raise ValueError(f"Unsupported columnar matrix version {version}")
+
+    count = sources * targets
+    dtype = _DTYPES[encoding]
+    times = np.frombuffer(buf, dtype=dtype, count=count, offset=_HEADER.size).reshape(sources, targets)
+    distances = np.frombuffer(buf, dtype=dtype, count=count, offset=_HEADER.size + column_bytes).reshape(
+        sources, targets
+    )
+
+    # rows are delta coded from 0 with -1 marking the unreachable cells
+    if _ENCODINGS[encoding] == "delta":
+        times = np.cumsum(times, axis=1, dtype=np.int64)
+        distances = np.cumsum(distances, axis=1, dtype=np.int64)
+        unreachable = times == -1
+        times = np.where(unreachable, np.nan, times)
+        distances = np.where(unreachable, np.nan, distances / 1000.0)
+
+    return {
+        "durations": times,
+        "distances": distances,
+        "units": _UNITS[units],
+        "algorithm": _ALGORITHMS[algorithm],
+        "encoding": _ENCODINGS[encoding],
+    }
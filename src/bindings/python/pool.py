@@ -0,0 +1,69 @@
+import json
+from typing import Iterable, Iterator, List, Tuple, Union
+
+try:
+    from .python_valhalla import _ActorPool
+except ModuleNotFoundError:
+    from python_valhalla import _ActorPool
+
+from .matrix import decode_matrix
+from .trace import decode_trace_attributes
+
+_MATRIX_ACTIONS = ("matrix", "sources_to_targets")
+
+
+class ActorPool(_ActorPool):
+    """
+    Runs batches of requests on a pool of Actors, each on its own thread and without holding the
+    GIL. Failed requests don't raise, they come back as the error response the service would send.
+    """
+
+    def __init__(self, config: str, threads: int = 0):
+        """
+        :param config: The path to the valhalla config
+        :param threads: How many actors to run requests on, 0 uses one per core
+        """
+        super().__init__(config, threads)
+
+    def imap_unordered(
+        self, action: str, requests: Iterable[Union[str, dict]], arrays: bool = False
+    ) -> Iterator[Tuple[int, Union[str, bytes, dict]]]:
+        """
+        Works through the requests and yields (index, response) tuples as they finish.
+
+        :param action: The action to run, e.g. "route", "matrix" or "trace_attributes"
+        :param requests: The requests as json strings or dicts, dict requests get dict responses
+        :param arrays: Whether to return matrix and trace_attributes responses as numpy arrays,
+                       see decode_matrix and decode_trace_attributes
+        """
+        requests = list(requests)
+        as_dict = any(isinstance(r, dict) for r in requests)
+
+        # matrices come back as arrays via the columnar format
+        if arrays and action in _MATRIX_ACTIONS:
+            requests = [
+                {"format": "columnar", **(r if isinstance(r, dict) else json.loads(r))} for r in requests
+            ]
+
+        for index, res in self.submit(
+            action, [r if isinstance(r, str) else json.dumps(r) for r in requests]
+        ):
+            if isinstance(res, bytes):
+                yield index, decode_matrix(res) if arrays and action in _MATRIX_ACTIONS else res
+            elif arrays and action == "trace_attributes":
+                res = json.loads(res)
+                yield index, res if "error_code" in res else decode_trace_attributes(res)
+            else:
+                yield index, json.loads(res) if as_dict else res
+
+    def map(
+        self, action: str, requests: Iterable[Union[str, dict]], arrays: bool = False
+    ) -> List[Union[str, bytes, dict]]:
+        """
+        Works through the requests and returns their responses in the same order, see imap_unordered.
+        """
+        requests = list(requests)
+        responses = [None] * len(requests)
+        for index, res in self.imap_unordered(action, requests, arrays):
+            responses[index] = res
+        return responses
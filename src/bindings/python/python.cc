@@ -1,10 +1,19 @@
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 
 #include "baldr/rapidjson_utils.h"
 #include <boost/make_shared.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/property_tree/ptree.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "baldr/rapidjson_utils.h"
 #include "midgard/logging.h"
@@ -33,6 +42,142 @@ const boost::property_tree::ptree configure(const std::string& config) {
 
   return pt;
 }
+
+using action_t = std::function<std::string(vt::actor_t&, const std::string&, valhalla::Api&)>;
+
+template <std::string (vt::actor_t::*action)(const std::string&,
+                                             const std::function<void()>*,
+                                             valhalla::Api*)>
+std::string call(vt::actor_t& actor, const std::string& request, valhalla::Api& api) {
+  return (actor.*action)(request, nullptr, &api);
+}
+
+action_t get_action(const std::string& name) {
+  static const std::unordered_map<std::string, action_t> actions{
+      {"route", call<&vt::actor_t::route>},
+      {"locate", call<&vt::actor_t::locate>},
+      {"optimized_route", call<&vt::actor_t::optimized_route>},
+      {"matrix",
+       [](vt::actor_t& actor, const std::string& request, valhalla::Api& api) {
+         return actor.matrix(request, nullptr, &api);
+       }},
+      {"isochrone", call<&vt::actor_t::isochrone>},
+      {"trace_route", call<&vt::actor_t::trace_route>},
+      {"trace_attributes", call<&vt::actor_t::trace_attributes>},
+      {"height", call<&vt::actor_t::height>},
+      {"transit_available", call<&vt::actor_t::transit_available>},
+      {"expansion",
+       [](vt::actor_t& actor, const std::string& request, valhalla::Api& api) {
+         return actor.expansion(request, nullptr, &api);
+       }},
+      {"centroid", call<&vt::actor_t::centroid>},
+      {"status", call<&vt::actor_t::status>},
+  };
+  auto found = actions.find(name == "sources_to_targets" ? "matrix" : name);
+  if (found == actions.cend()) {
+    throw std::invalid_argument("Unknown action: " + name);
+  }
+  return found->second;
+}
+
+// the response to one request of a batch
+struct batch_result_t {
+  size_t index;
+  std::string response;
+  bool binary;
+};
+
+// a set of actors, each of which runs on its own thread while a batch is being worked through
+struct actor_pool_t {
+  actor_pool_t(const boost::property_tree::ptree& config, size_t threads) {
+    if (threads == 0) {
+      threads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    // the actors share one tile cache rather than each keeping a copy of it
+    auto pool_config = config;
+    pool_config.put("mjolnir.global_synchronized_cache", true);
+    for (size_t i = 0; i < threads; ++i) {
+      actors.emplace_back(new vt::actor_t(pool_config, true));
+    }
+  }
+  std::vector<std::unique_ptr<vt::actor_t>> actors;
+  std::atomic<bool> busy{false};
+};
+
+// runs one action for a list of requests on the pool and hands back the results as they finish.
+// errors dont stop the batch, they come back as the error response the service would send
+class batch_t {
+public:
+  batch_t(actor_pool_t& pool, action_t action, std::vector<std::string> requests)
+      : pool(pool), action(std::move(action)), requests(std::move(requests)) {
+    if (pool.busy.exchange(true)) {
+      throw std::runtime_error("The ActorPool is already working through another batch");
+    }
+    for (auto& actor : pool.actors) {
+      threads.emplace_back(&batch_t::work, this, std::ref(*actor));
+    }
+  }
+
+  ~batch_t() {
+    stop = true;
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    pool.busy = false;
+  }
+
+  // blocks until the next result is done, false once all of them have been handed out
+  bool next(batch_result_t& result) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (handed_out == requests.size()) {
+      return false;
+    }
+    done_cv.wait(lock, [this] { return !done.empty(); });
+    result = std::move(done.front());
+    done.pop_front();
+    ++handed_out;
+    return true;
+  }
+
+  size_t size() const {
+    return requests.size();
+  }
+
+protected:
+  void work(vt::actor_t& actor) {
+    for (size_t i = next_request++; i < requests.size() && !stop; i = next_request++) {
+      valhalla::Api api;
+      batch_result_t result{i, {}, false};
+      try {
+        result.response = action(actor, requests[i], api);
+      } catch (const valhalla::valhalla_exception_t& e) {
+        actor.cleanup();
+        result.response = valhalla::serialize_error(e, api);
+      } catch (const std::exception& e) {
+        actor.cleanup();
+        result.response = valhalla::serialize_error({599, std::string(e.what())}, api);
+      }
+      result.binary = api.options().format() == valhalla::Options::pbf ||
+                      api.options().format() == valhalla::Options::columnar;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        done.emplace_back(std::move(result));
+      }
+      done_cv.notify_one();
+    }
+  }
+
+  actor_pool_t& pool;
+  action_t action;
+  std::vector<std::string> requests;
+  std::vector<std::thread> threads;
+  std::atomic<size_t> next_request{0};
+  std::atomic<bool> stop{false};
+  std::mutex mutex;
+  std::condition_variable done_cv;
+  std::deque<batch_result_t> done;
+  size_t handed_out = 0;
+};
 } // namespace
 
 namespace py = pybind11;
@@ -51,7 +196,17 @@ PYBIND11_MODULE(python_valhalla, m) {
           [](vt::actor_t& self, std::string& req) { return self.optimized_route(req); },
           "Optimizes the order of a set of waypoints by time.")
       .def(
-          "matrix", [](vt::actor_t& self, std::string& req) { return self.matrix(req); },
+          "matrix",
+          [](vt::actor_t& self, std::string& req) -> py::object {
+            // binary formats can't go through a python str
+            valhalla::Api api;
+            auto bytes = self.matrix(req, nullptr, &api);
+            if (api.options().format() == valhalla::Options::columnar ||
+                api.options().format() == valhalla::Options::pbf) {
+              return py::bytes(bytes);
+            }
+            return py::str(bytes);
+          },
           "Computes the time and distance between a set of locations and returns them as a matrix table.")
       .def(
           "isochrone", [](vt::actor_t& self, std::string& req) { return self.isochrone(req); },
@@ -79,4 +234,39 @@ PYBIND11_MODULE(python_valhalla, m) {
       .def(
           "status", [](vt::actor_t& self, std::string& req) { return self.status(req); },
           "Returns nothing or optionally details about Valhalla's configuration.");
+
+  py::class_<batch_t>(m, "_Batch", "Results of an ActorPool batch in the order they finish")
+      .def("__iter__", [](py::object self) { return self; })
+      .def("__next__",
+           [](batch_t& self) -> py::tuple {
+             // let other python threads run while we wait on the pool
+             batch_result_t result;
+             bool more;
+             {
+               py::gil_scoped_release release;
+               more = self.next(result);
+             }
+             if (!more) {
+               throw py::stop_iteration();
+             }
+             if (result.binary) {
+               return py::make_tuple(result.index, py::bytes(result.response));
+             }
+             return py::make_tuple(result.index, py::str(result.response));
+           })
+      .def("__len__", &batch_t::size);
+
+  py::class_<actor_pool_t>(m, "_ActorPool", "A pool of Valhalla Actors running batches of requests")
+      .def(py::init<>([](std::string config, size_t threads) {
+             return std::make_unique<actor_pool_t>(configure(config), threads);
+           }),
+           py::arg("config"), py::arg("threads") = 0)
+      .def(
+          "submit",
+          [](actor_pool_t& self, const std::string& action, std::vector<std::string> requests) {
+            return std::make_unique<batch_t>(self, get_action(action), std::move(requests));
+          },
+          py::keep_alive<0, 1>(),
+          "Starts working through the requests for the given action, one per actor in the pool. "
+          "Iterating the returned batch yields (index, response) tuples as the requests finish.");
 }
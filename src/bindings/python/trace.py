@@ -0,0 +1,61 @@
+import json
+from typing import Union
+
+
+def _decode_polyline(encoded: str, precision: int):
+    import numpy as np
+
+    # zigzag varints in chunks of 5 bits, each pair is the lat, lon offset from the previous point
+    values = []
+    result = shift = 0
+    for char in encoded:
+        byte = ord(char) - 63
+        result |= (byte & 0x1F) << shift
+        shift += 5
+        if byte < 0x20:
+            values.append(~(result >> 1) if result & 1 else result >> 1)
+            result = shift = 0
+
+    offsets = np.array(values, dtype=np.int64).reshape(-1, 2)
+    return np.cumsum(offsets, axis=0) / 10.0**precision
+
+
+def _columns(records: list) -> dict:
+    import numpy as np
+
+    # nested attributes like names or sign elements don't make for a column
+    keys = dict.fromkeys(k for r in records for k, v in r.items() if not isinstance(v, (list, dict)))
+
+    columns = {}
+    for key in keys:
+        values = [r.get(key) for r in records]
+        if any(isinstance(v, str) for v in values):
+            columns[key] = np.array(["" if v is None else v for v in values])
+        elif any(v is None for v in values):
+            columns[key] = np.array([np.nan if v is None else v for v in values], dtype=np.float64)
+        else:
+            columns[key] = np.array(values)
+    return columns
+
+
+def decode_trace_attributes(res: Union[str, dict], precision: int = 6) -> dict:
+    """
+    Turns a trace_attributes response into numpy arrays.
+
+    Every attribute which isn't nested becomes one array over the edges or matched points, attributes
+    missing on some of them are NaN for numbers and empty for strings.
+
+    :param res: The response returned by Actor.trace_attributes
+    :param precision: The precision of the encoded shape, 6 unless "shape_format" said otherwise
+    :return: A dict with the "shape" as an array of (lat, lon) rows, the "edges" and "matched_points"
+             as dicts of attribute name to array and the "units" of the response
+    """
+    if not isinstance(res, dict):
+        res = json.loads(res)
+
+    return {
+        "shape": _decode_polyline(res.get("shape", ""), precision),
+        "edges": _columns(res.get("edges", [])),
+        "matched_points": _columns(res.get("matched_points", [])),
+        "units": res.get("units"),
+    }
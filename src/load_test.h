@@ -0,0 +1,194 @@
+#ifndef VALHALLA_LOAD_TEST_H_
+#define VALHALLA_LOAD_TEST_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/property_tree/ptree.hpp>
+
+#include <valhalla/midgard/histogram.h>
+#include <valhalla/midgard/logging.h>
+#include <valhalla/proto/api.pb.h>
+#include <valhalla/tyr/actor.h>
+
+/**
+ * Replays a file of requests concurrently through the whole service stack, the same actor the
+ * service runs per worker, to see what a machine can sustain without setting up the http server and
+ * a load generator in front of it. Each thread has its own actor and goes through the requests as
+ * fast as it can, the latencies of the requests and of each stage they went through are recorded
+ * in histograms which are merged and reported once all the requests are done.
+ */
+namespace load_test {
+
+// runs one request on an actor, the request object is filled in by it
+using action_t =
+    std::function<std::string(valhalla::tyr::actor_t&, const std::string&, valhalla::Api&)>;
+
+struct options_t {
+  // how many threads send requests
+  uint32_t threads;
+  // how many times the requests are replayed
+  uint32_t repeat;
+  // whether each thread has a tile cache of its own rather than all of them sharing one
+  bool isolate_caches;
+};
+
+/**
+ * Reads a file of json requests, one per line. Lines can also be in the format the test_requests
+ * files are in, for the run_route scripts, which is the json in single quotes after a -j
+ * @param path  the file
+ * @return the requests
+ */
+inline std::vector<std::string> read_requests(const std::string& path) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    throw std::runtime_error("Could not open " + path);
+  }
+  std::vector<std::string> requests;
+  std::string line;
+  while (std::getline(file, line)) {
+    auto begin = line.find('{');
+    auto end = line.rfind('}');
+    if (begin == std::string::npos || end == std::string::npos || end < begin) {
+      continue;
+    }
+    requests.emplace_back(line.substr(begin, end - begin + 1));
+  }
+  if (requests.empty()) {
+    throw std::runtime_error("No requests in " + path);
+  }
+  return requests;
+}
+
+namespace detail {
+
+// what a thread recorded, latencies are in microseconds
+struct recorder_t {
+  valhalla::midgard::Histogram latency;
+  std::map<std::string, valhalla::midgard::Histogram> stages;
+  uint64_t failures = 0;
+
+  void merge(const recorder_t& other) {
+    latency.merge(other.latency);
+    for (const auto& stage : other.stages) {
+      stages[stage.first].merge(stage.second);
+    }
+    failures += other.failures;
+  }
+
+  // the workers time themselves into the statistics of the request as
+  // <action>.info.<stage>.latency_ms
+  void record_stages(const valhalla::Api& api) {
+    static const std::string kInfo = ".info.", kLatency = ".latency_ms";
+    for (const auto& statistic : api.info().statistics()) {
+      const auto& key = statistic.key();
+      auto info = key.find(kInfo);
+      if (info == std::string::npos || key.size() < kLatency.size() ||
+          key.compare(key.size() - kLatency.size(), kLatency.size(), kLatency) != 0) {
+        continue;
+      }
+      auto begin = info + kInfo.size();
+      auto stage = key.substr(begin, key.size() - kLatency.size() - begin);
+      stages[stage].record(static_cast<uint64_t>(statistic.value() * 1000));
+    }
+  }
+};
+
+inline void report(const std::string& name, const valhalla::midgard::Histogram& histogram) {
+  auto ms = [](uint64_t us) { return us / 1000.; };
+  std::cout << std::left << std::setw(10) << name << std::right << std::fixed
+            << std::setprecision(2) << std::setw(10) << histogram.count() << std::setw(10)
+            << ms(histogram.min()) << std::setw(10) << histogram.mean() / 1000. << std::setw(10)
+            << ms(histogram.percentile(50)) << std::setw(10) << ms(histogram.percentile(90))
+            << std::setw(10) << ms(histogram.percentile(99)) << std::setw(10)
+            << ms(histogram.percentile(99.9)) << std::setw(10) << ms(histogram.max()) << '\n';
+}
+
+} // namespace detail
+
+/**
+ * Replays the requests and reports how it went on stdout
+ * @param config    the config to make the actors with
+ * @param requests  the json requests
+ * @param action    what to do with each request
+ * @param options   how to replay them
+ * @return the number of requests which failed
+ */
+inline uint64_t run(boost::property_tree::ptree config,
+                    const std::vector<std::string>& requests,
+                    const action_t& action,
+                    const options_t& options) {
+  // the threads either go through one tile cache or each have one of their own
+  config.put("mjolnir.global_synchronized_cache", !options.isolate_caches);
+  const size_t total = requests.size() * options.repeat;
+  std::atomic<size_t> next(0);
+  std::vector<detail::recorder_t> recorders(std::max(options.threads, 1u));
+
+  LOG_INFO("Replaying " + std::to_string(total) + " requests on " +
+           std::to_string(recorders.size()) + " thread(s) with " +
+           (options.isolate_caches ? "a tile cache each" : "a shared tile cache"));
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (auto& recorder : recorders) {
+    threads.emplace_back([&config, &requests, &action, &next, total, &recorder]() {
+      valhalla::tyr::actor_t actor(config);
+      valhalla::Api api;
+      for (size_t i = next++; i < total; i = next++) {
+        api.Clear();
+        auto begin = std::chrono::steady_clock::now();
+        try {
+          action(actor, requests[i % requests.size()], api);
+        } catch (const std::exception& e) {
+          ++recorder.failures;
+          LOG_DEBUG("Request " + std::to_string(i % requests.size()) + " failed: " + e.what());
+        }
+        auto end = std::chrono::steady_clock::now();
+        recorder.latency.record(
+            std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count());
+        recorder.record_stages(api);
+        // like the service, clean up after the response was sent
+        actor.cleanup();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  detail::recorder_t merged;
+  for (const auto& recorder : recorders) {
+    merged.merge(recorder);
+  }
+
+  std::cout << std::fixed << std::setprecision(2) << "requests:   " << total << " ("
+            << merged.failures << " failed)\n"
+            << "duration:   " << seconds << " s\n"
+            << "throughput: " << total / seconds << " requests/s\n\n"
+            << std::left << std::setw(10) << "ms" << std::right;
+  for (const char* column : {"count", "min", "mean", "p50", "p90", "p99", "p99.9", "max"}) {
+    std::cout << std::setw(10) << column;
+  }
+  std::cout << '\n';
+  detail::report("request", merged.latency);
+  for (const auto& stage : merged.stages) {
+    detail::report(stage.first, stage.second);
+  }
+  std::cout << std::flush;
+  return merged.failures;
+}
+
+} // namespace load_test
+
+#endif // VALHALLA_LOAD_TEST_H_
@@ -53,6 +53,17 @@ directed_reach Reach::operator()(const DirectedEdge* edge,
     return reach;
   max_reach_ = max_reach;
 
+  // the tiles may already tell us the edge is well connected in which case we dont need to look
+  auto known = labelled(edge, edge_id, reader, costing);
+  known.outbound = std::min(static_cast<uint32_t>(known.outbound), max_reach);
+  known.inbound = std::min(static_cast<uint32_t>(known.inbound), max_reach);
+  if (known.outbound == max_reach)
+    direction &= ~kOutbound;
+  if (known.inbound == max_reach)
+    direction &= ~kInbound;
+  if (!(direction & (kInbound | kOutbound)))
+    return known;
+
   // these are used below to get conservative estimates of forward and reverse reach
   constexpr uint16_t forward_disallow_mask = sif::kDisallowEndRestriction |
                                              sif::kDisallowSimpleRestriction | sif::kDisallowClosure |
@@ -152,6 +163,38 @@ directed_reach Reach::operator()(const DirectedEdge* edge,
     reach.inbound = std::max(reach.inbound, retry_reach.inbound);
   }
 
+  reach.outbound = std::max(reach.outbound, known.outbound);
+  reach.inbound = std::max(reach.inbound, known.inbound);
+  return reach;
+}
+
+directed_reach Reach::labelled(const DirectedEdge* edge,
+                               const baldr::GraphId edge_id,
+                               GraphReader& reader,
+                               const std::shared_ptr<sif::DynamicCost>& costing) {
+  // the labels dont know about closures or anything a stricter costing or the request excludes
+  directed_reach reach{};
+  if (!costing->ReachLabelsApply() || reader.HasLiveTraffic())
+    return reach;
+
+  // the edge itself has to be usable without any restrictions which could end the path on it
+  constexpr uint16_t disallow_mask = sif::kDisallowStartRestriction | sif::kDisallowEndRestriction |
+                                     sif::kDisallowSimpleRestriction | sif::kDisallowClosure |
+                                     sif::kDisallowShortcut;
+  graph_tile_ptr tile = reader.GetGraphTile(edge_id);
+  if (!tile || !costing->Allowed(edge, tile, disallow_mask))
+    return reach;
+
+  // outbound we can get to everything in the end nodes component, inbound everything in the begin
+  // nodes component can get to us
+  // auto also allows hov and trucks may be allowed on auto only edges, neither takes anything away
+  auto mode = costing->access_mode();
+  mode = mode & kTruckAccess ? kTruckAccess : mode & kAutoAccess ? kAutoAccess : mode;
+  auto begin_node = reader.GetBeginNodeId(edge, tile);
+  if (begin_node.Is_Valid() && reader.GetGraphTile(begin_node, tile))
+    reach.inbound = tile->reach_label(begin_node.id()).get(mode);
+  if (reader.GetGraphTile(edge->endnode(), tile))
+    reach.outbound = tile->reach_label(edge->endnode().id()).get(mode);
   return reach;
 }
 
@@ -45,6 +45,7 @@ std::string loki_worker_t::transit_available(Api& request) {
     }
   } catch (const std::exception&) { throw valhalla_exception_t{170}; }
 
+  auto serialization = measure_serialization(request);
   return tyr::serializeTransitAvailable(request, locations, found);
 }
 
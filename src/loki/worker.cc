@@ -26,6 +26,13 @@ using namespace valhalla::baldr;
 using namespace valhalla::sif;
 using namespace valhalla::loki;
 
+namespace {
+
+// the sub phase making the costing of a request is timed as
+const std::string kCosting = "costing";
+
+} // namespace
+
 namespace valhalla {
 namespace loki {
 void loki_worker_t::parse_locations(google::protobuf::RepeatedPtrField<valhalla::Location>* locations,
@@ -112,6 +119,7 @@ void loki_worker_t::parse_costing(Api& api, bool allow_none) {
 
   const auto& costing_str = Costing_Enum_Name(options.costing_type());
   try {
+    midgard::metrics::scoped_timer_t timer(Options_Action_Enum_Name(options.action()), kCosting);
     // For the begin and end of multimodal we expect you to be walking
     if (options.costing_type() == Costing::multimodal) {
       options.set_costing_type(Costing::pedestrian);
@@ -304,6 +312,12 @@ void loki_worker_t::cleanup() {
   }
 }
 
+void loki_worker_t::check_action(const Api& request) const {
+  if (actions.find(request.options().action()) == actions.cend()) {
+    throw valhalla_exception_t{106, action_str};
+  }
+}
+
 void loki_worker_t::set_interrupt(const std::function<void()>* interrupt_function) {
   interrupt = interrupt_function;
   reader->SetInterrupt(interrupt);
@@ -366,20 +380,23 @@ loki_worker_t::work(const std::list<zmq::message_t>& job,
   // grab the request info and make sure to record any metrics before we are done
   auto& info = *static_cast<prime_server::http_request_info_t*>(request_info);
   LOG_INFO("Got Loki Request " + std::to_string(info.id));
-  Api request;
+  // lives in the arena until cleanup
+  auto& request = arena.request();
   prime_server::worker_t::result_t result{true, {}, ""};
   try {
     // request parsing
     auto http_request =
         prime_server::http_request_t::from_string(static_cast<const char*>(job.front().data()),
                                                   job.front().size());
+    // scrapes of the latency histograms and dumps of the trace points never go down the pipeline
+    if (serve_metrics(http_request, info, result) || serve_trace(http_request, info, result)) {
+      return result;
+    }
     ParseApi(http_request, request);
     const auto& options = request.options();
 
     // check there is a valid action
-    if (actions.find(options.action()) == actions.cend()) {
-      throw valhalla_exception_t{106, action_str};
-    }
+    check_action(request);
 
     // Set the interrupt function
     service_worker_t::set_interrupt(&interrupt_function);
@@ -1,5 +1,6 @@
 #include "meili/geometry_helpers.h"
 
+#include <valhalla/baldr/edgeinfo.h>
 #include <valhalla/midgard/constants.h>
 #include <valhalla/midgard/distanceapproximator.h>
 #include <valhalla/midgard/encoded.h>
@@ -15,8 +16,9 @@ namespace meili {
 namespace helpers {
 
 // snapped point, squared distance, segment index, offset
+template <class shape_decoder_t>
 std::tuple<PointLL, double, typename std::vector<PointLL>::size_type, double>
-Project(const projector_t& p, Shape7Decoder<midgard::PointLL>& shape, double snap_distance) {
+Project(const projector_t& p, shape_decoder_t& shape, double snap_distance) {
   PointLL first_point(shape.pop());
   auto closest_point = first_point;
   auto closest_segment_point = first_point;
@@ -96,6 +98,12 @@ Project(const projector_t& p, Shape7Decoder<midgard::PointLL>& shape, double sna
   return std::make_tuple(std::move(closest_point), closest_distance, closest_segment, percent_along);
 }
 
+// explicit instantiations
+template std::tuple<PointLL, double, typename std::vector<PointLL>::size_type, double>
+Project(const projector_t&, Shape7Decoder<PointLL>&, double);
+template std::tuple<PointLL, double, typename std::vector<PointLL>::size_type, double>
+Project(const projector_t&, baldr::EdgeShapeDecoder&, double);
+
 } // namespace helpers
 } // namespace meili
 } // namespace valhalla
@@ -6,6 +6,7 @@
 #include "meili/routing.h"
 #include "meili/transition_cost_model.h"
 #include "midgard/distanceapproximator.h"
+#include "midgard/tracing.h"
 #include "worker.h"
 
 #include <array>
@@ -687,6 +688,7 @@ or
 
 std::vector<MatchResults> MapMatcher::OfflineMatch(const std::vector<Measurement>& measurements,
                                                    uint32_t k) {
+  VALHALLA_TRACE_SCOPE("meili", "offline_match");
   if (k <= 0) {
     throw std::invalid_argument("expect k to be positive but got " + std::to_string(k));
   }
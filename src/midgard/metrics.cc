@@ -0,0 +1,165 @@
+#include "midgard/metrics.h"
+#include "midgard/histogram.h"
+
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <utility>
+
+namespace {
+
+using namespace valhalla::midgard;
+
+// 5 bits keeps every reported latency within 1/16th of what was recorded with under a thousand
+// buckets per histogram, there are as many histograms per thread as action and stage pairs it saw
+constexpr uint32_t kPrecisionBits = 5;
+
+// how often a thread merges what it recorded into the process wide histograms
+constexpr auto kFlushInterval = std::chrono::seconds(1);
+
+// the quantiles that are rendered
+constexpr double kQuantiles[] = {.5, .9, .99, .999};
+
+using histogram_key_t = std::pair<std::string, std::string>;
+using histograms_t = std::map<histogram_key_t, Histogram>;
+
+// the process wide histograms
+struct global_t {
+  std::mutex mutex;
+  histograms_t histograms;
+};
+
+global_t& global() {
+  static global_t global;
+  return global;
+}
+
+// merges histograms into others of the same keys
+void merge(const histograms_t& from, histograms_t& into) {
+  for (const auto& histogram : from) {
+    auto found = into.find(histogram.first);
+    if (found == into.end()) {
+      found = into.emplace(histogram.first, Histogram(kPrecisionBits)).first;
+    }
+    found->second.merge(histogram.second);
+  }
+}
+
+// what one thread recorded since it last merged
+struct local_t {
+  histograms_t histograms;
+  std::chrono::steady_clock::time_point last_flush = std::chrono::steady_clock::now();
+
+  ~local_t() {
+    flush();
+  }
+
+  void flush() {
+    if (!histograms.empty()) {
+      auto& g = global();
+      std::lock_guard<std::mutex> lock(g.mutex);
+      merge(histograms, g.histograms);
+    }
+    // the histograms are kept so their buckets don't have to be allocated again
+    for (auto& histogram : histograms) {
+      histogram.second.reset();
+    }
+    last_flush = std::chrono::steady_clock::now();
+  }
+};
+
+local_t& local() {
+  thread_local local_t local;
+  return local;
+}
+
+// quotes a label value as prometheus wants it
+std::string label(const std::string& value) {
+  std::string quoted;
+  for (char c : value) {
+    if (c == '\\' || c == '"') {
+      quoted.push_back('\\');
+      quoted.push_back(c);
+    } else if (c == '\n') {
+      quoted += "\\n";
+    } else {
+      quoted.push_back(c);
+    }
+  }
+  return quoted;
+}
+
+} // namespace
+
+namespace valhalla {
+namespace midgard {
+namespace metrics {
+
+namespace detail {
+std::atomic<bool> enabled(false);
+} // namespace detail
+
+const std::string kNoAction = "none";
+
+void enable(bool enabled) {
+  detail::enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void record(const std::string& action, const std::string& stage, uint64_t microseconds) {
+  if (!enabled()) {
+    return;
+  }
+  auto& l = local();
+  auto found = l.histograms.find(histogram_key_t{action, stage});
+  if (found == l.histograms.end()) {
+    found = l.histograms.emplace(histogram_key_t{action, stage}, Histogram(kPrecisionBits)).first;
+  }
+  found->second.record(microseconds);
+
+  // every so often what was recorded is handed over
+  auto now = std::chrono::steady_clock::now();
+  if (now - l.last_flush >= kFlushInterval) {
+    l.flush();
+  }
+}
+
+void flush() {
+  local().flush();
+}
+
+void reset() {
+  auto& g = global();
+  std::lock_guard<std::mutex> lock(g.mutex);
+  g.histograms.clear();
+}
+
+std::string render() {
+  // copy them so the lock isn't held while rendering
+  histograms_t histograms;
+  {
+    auto& g = global();
+    std::lock_guard<std::mutex> lock(g.mutex);
+    histograms = g.histograms;
+  }
+
+  std::ostringstream text;
+  text << "# HELP valhalla_latency_seconds Latency of the stages of requests and their sub phases\n"
+          "# TYPE valhalla_latency_seconds summary\n";
+  for (const auto& histogram : histograms) {
+    const auto labels = "action=\"" + label(histogram.first.first) + "\",stage=\"" +
+                        label(histogram.first.second) + "\"";
+    for (double quantile : kQuantiles) {
+      text << "valhalla_latency_seconds{" << labels << ",quantile=\"" << quantile << "\"} "
+           << histogram.second.percentile(quantile * 100) / 1e6 << '\n';
+    }
+    text << "valhalla_latency_seconds_sum{" << labels << "} " << histogram.second.sum() / 1e6
+         << '\n'
+         << "valhalla_latency_seconds_count{" << labels << "} " << histogram.second.count()
+         << '\n';
+  }
+  return text.str();
+}
+
+} // namespace metrics
+} // namespace midgard
+} // namespace valhalla
@@ -1,5 +1,6 @@
 #include "midgard/point_tile_index.h"
 
+#include <algorithm>
 #include <list>
 
 namespace valhalla {
@@ -11,7 +12,11 @@ namespace midgard {
 const PointLL PointTileIndex::kDeletedPoint = {1000.0, 1000.0};
 
 template <class container_t>
-PointTileIndex::PointTileIndex(double tile_width_degrees, const container_t& polyline) {
+void PointTileIndex::reset(double tile_width_degrees, const container_t& polyline) {
+  tiles.reset();
+  tiled_points.clear();
+  removed.clear();
+  points.clear();
   if (polyline.size() == 0)
     return;
   if (tile_width_degrees <= 0.0)
@@ -64,14 +69,15 @@ PointTileIndex::PointTileIndex(double tile_width_degrees, const container_t& pol
   tiles = std::make_unique<Tiles<PointLL>>(min_pt, tile_width_degrees, num_divs, num_divs);
 
   this->points.reserve(polyline.size());
-  tiled_space.reserve(polyline.size());
+  tiled_points.reserve(polyline.size());
   size_t index = 0;
   for (auto iter = polyline.begin(); iter != polyline.end(); iter++, index++) {
     const PointLL& p = *iter;
     this->points.emplace_back(p);
-    int32_t tid = tiles->TileId(p);
-    tiled_space[tid].insert(index);
+    tiled_points.emplace_back(tiles->TileId(p), index);
   }
+  std::sort(tiled_points.begin(), tiled_points.end());
+  removed.resize(points.size(), false);
 }
 
 std::unordered_set<size_t> PointTileIndex::get_points_near(const PointLL& pt) {
@@ -79,6 +85,13 @@ std::unordered_set<size_t> PointTileIndex::get_points_near(const PointLL& pt) {
 }
 
 std::unordered_set<size_t> PointTileIndex::get_points_near_segment(const LineSegment2<PointLL>& seg) {
+  std::vector<size_t> near_pts;
+  get_points_near_segment(seg, near_pts);
+  return {near_pts.begin(), near_pts.end()};
+}
+
+void PointTileIndex::get_points_near_segment(const LineSegment2<PointLL>& seg,
+                                             std::vector<size_t>& near_pts) const {
   const PointLL& a = seg.a();
   const PointLL& b = seg.b();
 
@@ -97,44 +110,60 @@ std::unordered_set<size_t> PointTileIndex::get_points_near_segment(const LineSeg
   int32_t maxtid = tiles->RightNeighbor(tiles->TopNeighbor(tiles->TileId(maxpt)));
   AABB2<PointLL> maxtidbox = tiles->TileBounds(maxtid);
 
-  // Box from min-pt to max-pt. Determine the tiles covered by thebox.
+  // Box from min-pt to max-pt. Determine the tiles covered by thebox the same way
+  // Tiles::TileList does, but a row at a time rather than collecting them in a list
   AABB2<PointLL> thebox = mintidbox;
   thebox.Expand(maxtidbox);
-  std::vector<int32_t> tiles_covered = tiles->TileList(thebox);
-
-  // Gather up all points in the tiles_covered.
-  std::unordered_set<size_t> near_pts;
-  for (int32_t tid : tiles_covered) {
-    auto iter = tiled_space.find(tid);
-    if (iter != tiled_space.end()) {
-      near_pts.insert(iter->second.begin(), iter->second.end());
+  const auto bounds = tiles->TileBounds();
+  auto add_rows = [this, &near_pts](const AABB2<PointLL>& bb) {
+    int32_t minrow = std::max(tiles->Row(bb.miny()), 0);
+    int32_t maxrow = std::max(tiles->Row(bb.maxy()), 0);
+    int32_t mincol = std::max(tiles->Col(bb.minx()), 0);
+    int32_t maxcol = std::max(tiles->Col(bb.maxx()), 0);
+    for (int32_t row = minrow; row <= maxrow; ++row) {
+      get_points_in_tiles(tiles->TileId(mincol, row), tiles->TileId(maxcol, row), near_pts);
     }
+  };
+  if (thebox.minx() < bounds.minx() && thebox.maxx() > bounds.minx()) {
+    add_rows({bounds.minx(), thebox.miny(), thebox.maxx(), thebox.maxy()});
+    add_rows({thebox.minx() + bounds.Width(), thebox.miny(), bounds.maxx(), thebox.maxy()});
+  } else if (thebox.minx() < bounds.maxx() && thebox.maxx() > bounds.maxx()) {
+    add_rows({thebox.minx(), thebox.miny(), bounds.maxx(), thebox.maxy()});
+    add_rows({bounds.minx(), thebox.miny(), thebox.maxx() - bounds.Width(), thebox.maxy()});
+  } else {
+    add_rows(thebox.Intersection(bounds));
   }
+}
 
-  return near_pts;
+void PointTileIndex::get_points_in_tiles(int32_t first_tile,
+                                         int32_t last_tile,
+                                         std::vector<size_t>& near_pts) const {
+  auto iter = std::lower_bound(tiled_points.begin(), tiled_points.end(),
+                               std::make_pair(first_tile, size_t(0)));
+  for (; iter != tiled_points.end() && iter->first <= last_tile; ++iter) {
+    if (!removed[iter->second]) {
+      near_pts.push_back(iter->second);
+    }
+  }
 }
 
 void PointTileIndex::remove_point(size_t idx) {
-  // delete this entry from its tile
-  auto iter = tiled_space.find(tiles->TileId(points[idx]));
-  if (iter != tiled_space.end()) {
-    std::unordered_set<size_t>& tile_points = iter->second;
-    tile_points.erase(idx);
-  }
+  // take it out of the tiled space
+  removed[idx] = true;
 
   // don't actually delete from the vector, just mark as deleted
   points[idx] = PointTileIndex::kDeletedPoint;
 }
 
 // Explicit instantiation
-template PointTileIndex::PointTileIndex(double, const std::vector<PointXY<float>>&);
-template PointTileIndex::PointTileIndex(double, const std::vector<PointXY<double>>&);
-template PointTileIndex::PointTileIndex(double, const std::list<PointXY<float>>&);
-template PointTileIndex::PointTileIndex(double, const std::list<PointXY<double>>&);
-template PointTileIndex::PointTileIndex(double, const std::vector<GeoPoint<float>>&);
-template PointTileIndex::PointTileIndex(double, const std::vector<GeoPoint<double>>&);
-template PointTileIndex::PointTileIndex(double, const std::list<GeoPoint<float>>&);
-template PointTileIndex::PointTileIndex(double, const std::list<GeoPoint<double>>&);
+template void PointTileIndex::reset(double, const std::vector<PointXY<float>>&);
+template void PointTileIndex::reset(double, const std::vector<PointXY<double>>&);
+template void PointTileIndex::reset(double, const std::list<PointXY<float>>&);
+template void PointTileIndex::reset(double, const std::list<PointXY<double>>&);
+template void PointTileIndex::reset(double, const std::vector<GeoPoint<float>>&);
+template void PointTileIndex::reset(double, const std::vector<GeoPoint<double>>&);
+template void PointTileIndex::reset(double, const std::list<GeoPoint<float>>&);
+template void PointTileIndex::reset(double, const std::list<GeoPoint<double>>&);
 
 } // namespace midgard
 } // namespace valhalla
@@ -4,7 +4,10 @@
 #include "midgard/point_tile_index.h"
 #include "midgard/util.h"
 
+#include <algorithm>
 #include <list>
+#include <tuple>
+#include <type_traits>
 
 namespace valhalla {
 namespace midgard {
@@ -70,6 +73,93 @@ template <typename coord_t> std::vector<coord_t> Polyline2<coord_t>::GetSelfInte
   return intersections;
 }
 
+namespace {
+
+// Buffers are kept per thread so generalizing doesn't allocate once they have grown to fit. To not
+// pin the memory of the largest polyline ever seen for good they are released again when they are
+// more than kShrinkFactor times larger than the polyline at hand, unless they are small anyway
+constexpr size_t kShrinkFactor = 4;
+constexpr size_t kMinShrinkCapacity = 4096;
+
+template <class T> void shrink(std::vector<T>& buffer, size_t size) {
+  if (buffer.capacity() > kMinShrinkCapacity && buffer.capacity() > kShrinkFactor * size) {
+    buffer.clear();
+    buffer.shrink_to_fit();
+  }
+}
+
+// The buffers generalizing works in
+struct generalize_scratch_t {
+  // ranges of the polyline that are still to be simplified, the last one is next
+  std::vector<std::pair<size_t, size_t>> ranges;
+  // whether each point is kept or excluded from being generalized
+  std::vector<bool> keep;
+  std::vector<bool> excluded;
+  // points of other parts of the polyline near a simplified line
+  std::vector<size_t> near_points;
+  PointTileIndex point_tile_index;
+
+  // releases the buffers which are much larger than needed for a polyline of this size
+  void fit(size_t size) {
+    shrink(ranges, size);
+    shrink(keep, size);
+    shrink(excluded, size);
+    shrink(near_points, size);
+    if (point_tile_index.points.capacity() > kMinShrinkCapacity &&
+        point_tile_index.points.capacity() > kShrinkFactor * size) {
+      point_tile_index = PointTileIndex{};
+    }
+  }
+};
+
+generalize_scratch_t& scratch(size_t size) {
+  thread_local generalize_scratch_t scratch;
+  scratch.fit(size);
+  return scratch;
+}
+
+// Random access to the points, vectors are used as is and lists are copied into a buffer
+template <class coord_t, class container_t>
+const coord_t* random_access(const container_t& polyline) {
+  if constexpr (std::is_same<container_t, std::vector<coord_t>>::value) {
+    return polyline.data();
+  } else {
+    thread_local std::vector<coord_t> points;
+    shrink(points, polyline.size());
+    points.assign(polyline.begin(), polyline.end());
+    return points.data();
+  }
+}
+
+void mark_exclusions(std::vector<bool>& excluded,
+                     const std::unordered_set<size_t>& exclusions,
+                     size_t size) {
+  excluded.assign(size, false);
+  for (auto idx : exclusions) {
+    if (idx < size)
+      excluded[idx] = true;
+  }
+}
+
+// Removes the points which are not marked to keep, in place
+template <class container_t>
+void remove_unkept(container_t& polyline, const std::vector<bool>& keep) {
+  size_t idx = 0;
+  if constexpr (std::is_same<container_t, std::list<typename container_t::value_type>>::value) {
+    for (auto pt = polyline.begin(); pt != polyline.end(); ++idx)
+      pt = keep[idx] ? std::next(pt) : polyline.erase(pt);
+  } else {
+    auto kept = polyline.begin();
+    for (auto pt = polyline.begin(); pt != polyline.end(); ++pt, ++idx) {
+      if (keep[idx])
+        *kept++ = *pt;
+    }
+    polyline.erase(kept, polyline.end());
+  }
+}
+
+} // namespace
+
 /**
  * A Douglas-Peucker line simplification algorithm that will not generate
  * self-intersections.
@@ -81,132 +171,140 @@ template <typename coord_t> std::vector<coord_t> Polyline2<coord_t>::GetSelfInte
  */
 void peucker_avoid_self_intersections(PointTileIndex& point_tile_index,
                                       const double& epsilon_sq,
-                                      const std::unordered_set<size_t>& exclusions,
-                                      size_t sidx,
-                                      size_t eidx) {
-
-  while ((exclusions.find(sidx) != exclusions.end()) && (sidx < eidx)) {
-    sidx++;
-  }
-  while ((exclusions.find(eidx) != exclusions.end()) && (eidx > sidx)) {
-    eidx--;
-  }
-  if (sidx >= eidx)
-    return;
+                                      const std::vector<bool>& excluded,
+                                      std::vector<std::pair<size_t, size_t>>& ranges,
+                                      std::vector<size_t>& line_buffer_points) {
+  // work through the ranges depth first from right to left, the same order the removals from
+  // the point tile index would happen in when recursing
+  while (!ranges.empty()) {
+    size_t sidx, eidx;
+    std::tie(sidx, eidx) = ranges.back();
+    ranges.pop_back();
+
+    while (excluded[sidx] && (sidx < eidx)) {
+      sidx++;
+    }
+    while (excluded[eidx] && (eidx > sidx)) {
+      eidx--;
+    }
+    if (sidx >= eidx)
+      continue;
 
-  const PointLL& start = point_tile_index.points[sidx];
-  const PointLL& end = point_tile_index.points[eidx];
+    const PointLL& start = point_tile_index.points[sidx];
+    const PointLL& end = point_tile_index.points[eidx];
 
-  double dmax = std::numeric_limits<double>::lowest();
-  LineSegment2<PointLL> line_segment{start, end};
+    double dmax = std::numeric_limits<double>::lowest();
+    LineSegment2<PointLL> line_segment{start, end};
 
-  // hfidx is the index of the highest freq detail (the dividing point)
-  size_t hfidx = sidx;
+    // hfidx is the index of the highest freq detail (the dividing point)
+    size_t hfidx = sidx;
 
-  // find the point furthest from the line-segment formed by {start, end}
-  PointLL tmp;
-  for (size_t idx = sidx + 1; idx < eidx; idx++) {
-    // special points we dont want to generalize no matter what take precedence
-    if (exclusions.find(idx) != exclusions.end()) {
-      dmax = epsilon_sq;
-      hfidx = idx;
-      break;
-    }
+    // find the point furthest from the line-segment formed by {start, end}
+    PointLL tmp;
+    for (size_t idx = sidx + 1; idx < eidx; idx++) {
+      // special points we dont want to generalize no matter what take precedence
+      if (excluded[idx]) {
+        dmax = epsilon_sq;
+        hfidx = idx;
+        break;
+      }
 
-    const PointLL& c = point_tile_index.points[idx];
+      const PointLL& c = point_tile_index.points[idx];
 
-    // test if this is the highest frequency detail so far
-    auto d = line_segment.DistanceSquared(c, tmp);
-    if (d > dmax) {
-      dmax = d;
-      hfidx = idx;
+      // test if this is the highest frequency detail so far
+      auto d = line_segment.DistanceSquared(c, tmp);
+      if (d > dmax) {
+        dmax = d;
+        hfidx = idx;
+      }
     }
-  }
 
-  // If (dmax < epsilon_sq) then we have a relatively straight line between (start,end).
-  // A standard Douglas-Peucker algorithm would immediately decimate all the points
-  // between (start,end). In this modified version, we use our tiled-point-space to
-  // determine if decimating the line would result in a self-intersection.
-  //
-  // We use our tiled space to determine the points along the "epsilon buffer zone" of
-  // the line (start,end). Because our tiled-point-space is coarse, our
-  // "get_points_near_segment" query will contain points both of interest and not.
-  // Consider this amazing ascii art example:
-  //
-  //                i             k
-  //                 \           /
-  //                  \         /
-  //                   \       /
-  //                    \     /
-  //   s - - - - - - - - - - - - - - - - - - - - - - - - - - - - e
-  //     `  .             \ /                             `
-  //            `  .       j                 .
-  //                  `  c        `
-  //
-  // s=start, e=end. c is a point along the polyline between s & e. We are considering
-  // getting rid of c because it is within epsilon of (a,b).
-  //
-  // All the points shown in this hypothetical example are returned from the call to
-  // "get_points_near_segment".
-  //
-  // As you can see, a completely separate portion of our polygon (i, j, k) would
-  // self-intersect if we simplified. To detect this, we perform a triangle
-  // containment test of point j using the triangle (s, c, e), see that its contained,
-  // and decide not to simplify. While this example only has one point c between
-  // (a,b), there is typically more than one. The logic below will create a triangle
-  // using every point c between start and end and perform containment tests for all
-  // "nearby" points for every (start,c,end) triangle. We can stop as soon as we find
-  // an unexpected point inside our triangle.
-  if (dmax < epsilon_sq) {
-    // This returns the points in the "epsilon buffer zone" along the line (start, end).
-    std::unordered_set<size_t> line_buffer_points =
-        point_tile_index.get_points_near_segment(LineSegment2<PointLL>(start, end));
-
-    // We only care about checking for triangle containment for points that are not
-    // along the polyline [start,end] - so we can remove those straightaway.
-    for (size_t i = sidx; i <= eidx; i++) {
-      line_buffer_points.erase(i);
-    }
+    // If (dmax < epsilon_sq) then we have a relatively straight line between (start,end).
+    // A standard Douglas-Peucker algorithm would immediately decimate all the points
+    // between (start,end). In this modified version, we use our tiled-point-space to
+    // determine if decimating the line would result in a self-intersection.
+    //
+    // We use our tiled space to determine the points along the "epsilon buffer zone" of
+    // the line (start,end). Because our tiled-point-space is coarse, our
+    // "get_points_near_segment" query will contain points both of interest and not.
+    // Consider this amazing ascii art example:
+    //
+    //                i             k
+    //                 \           /
+    //                  \         /
+    //                   \       /
+    //                    \     /
+    //   s - - - - - - - - - - - - - - - - - - - - - - - - - - - - e
+    //     `  .             \ /                             `
+    //            `  .       j                 .
+    //                  `  c        `
+    //
+    // s=start, e=end. c is a point along the polyline between s & e. We are considering
+    // getting rid of c because it is within epsilon of (a,b).
+    //
+    // All the points shown in this hypothetical example are returned from the call to
+    // "get_points_near_segment".
+    //
+    // As you can see, a completely separate portion of our polygon (i, j, k) would
+    // self-intersect if we simplified. To detect this, we perform a triangle
+    // containment test of point j using the triangle (s, c, e), see that its contained,
+    // and decide not to simplify. While this example only has one point c between
+    // (a,b), there is typically more than one. The logic below will create a triangle
+    // using every point c between start and end and perform containment tests for all
+    // "nearby" points for every (start,c,end) triangle. We can stop as soon as we find
+    // an unexpected point inside our triangle.
+    if (dmax < epsilon_sq) {
+      // This returns the points in the "epsilon buffer zone" along the line (start, end).
+      line_buffer_points.clear();
+      point_tile_index.get_points_near_segment(LineSegment2<PointLL>(start, end), line_buffer_points);
+
+      // We only care about checking for triangle containment for points that are not
+      // along the polyline [start,end] - so we can remove those straightaway.
+      line_buffer_points.erase(std::remove_if(line_buffer_points.begin(), line_buffer_points.end(),
+                                              [sidx, eidx](size_t i) {
+                                                return sidx <= i && i <= eidx;
+                                              }),
+                               line_buffer_points.end());
+
+      bool can_simplify = true;
+      for (size_t cidx = sidx + 1; (cidx < eidx) && can_simplify; cidx++) {
+        const PointLL& c = point_tile_index.points[cidx];
+        for (size_t point_idx : line_buffer_points) {
+          const PointLL& p = point_tile_index.points[point_idx];
+          if (triangle_contains(start, c, end, p)) {
+            can_simplify = false;
+            break;
+          }
+        }
 
-    bool can_simplify = true;
-    for (size_t cidx = sidx + 1; (cidx < eidx) && can_simplify; cidx++) {
-      const PointLL& c = point_tile_index.points[cidx];
-      for (size_t point_idx : line_buffer_points) {
-        const PointLL& p = point_tile_index.points[point_idx];
-        if (triangle_contains(start, c, end, p)) {
-          can_simplify = false;
+        // the moment we realize we cannot simplify we can stop
+        if (!can_simplify) {
           break;
         }
       }
 
-      // the moment we realize we cannot simplify we can stop
-      if (!can_simplify) {
-        break;
+      if (can_simplify) {
+        // Simplify the polyline by removing all points between sidx and eidx
+        // from the point-tile-index (but don't remove sidx or eidx).
+        point_tile_index.remove_points(sidx + 1, eidx);
+      } else {
+        // Simplifying this polyline would result in a self-intersection, so
+        // we cannot. Force a split around hfidx.
+        dmax = epsilon_sq;
       }
     }
 
-    if (can_simplify) {
-      // Simplify the polyline by removing all points between sidx and eidx
-      // from the point-tile-index (but don't remove sidx or eidx).
-      point_tile_index.remove_points(sidx + 1, eidx);
-    } else {
-      // Simplifying this polyline would result in a self-intersection, so
-      // we cannot. Force recursion around hfidx.
-      dmax = epsilon_sq;
+    // if (dmax >= epsilon_sq) there are some high frequency details between start
+    // and end so we need to look for flatter sections between them. the right one
+    // goes on top so it is done first, that is the only way to preserve the indices
+    // in the keep set
+    if (dmax >= epsilon_sq) {
+      if (hfidx - sidx > 1)
+        ranges.emplace_back(sidx, hfidx);
+      if (eidx - hfidx > 1)
+        ranges.emplace_back(hfidx, eidx);
     }
   }
-
-  // if (dmax >= epsilon_sq) there are some high frequency details between start
-  // and end so we need to look for flatter sections between them.
-  if (dmax >= epsilon_sq) {
-    // we recurse from right to left for two reasons:
-    // 1. we want to preserve iterator validity in the vector version
-    // 2. its the only way to preserve the indices in the keep set
-    if (eidx - hfidx > 1)
-      peucker_avoid_self_intersections(point_tile_index, epsilon_sq, exclusions, hfidx, eidx);
-    if (hfidx - sidx > 1)
-      peucker_avoid_self_intersections(point_tile_index, epsilon_sq, exclusions, sidx, hfidx);
-  }
 }
 
 template <class coord_t, class container_t>
@@ -215,13 +313,18 @@ void DouglastPeuckerAvoidSelfIntersection(container_t& polyline,
                                           const std::unordered_set<size_t>& exclusions) {
   // Create a tile-space-index which allows us to perform a Douglas-Peucker style line
   // simplification that avoids creating self-intersections within the polyline/polygon.
+  auto& buffers = scratch(polyline.size());
   const PointLL& first_point = *polyline.begin();
   double meters_per_deg = DistanceApproximator<PointLL>::MetersPerLngDegree(first_point.lat());
   double epsilon_deg = epsilon_m / meters_per_deg;
-  PointTileIndex point_tile_index(epsilon_deg, polyline);
+  auto& point_tile_index = buffers.point_tile_index;
+  point_tile_index.reset(epsilon_deg, polyline);
 
-  peucker_avoid_self_intersections(point_tile_index, epsilon_m * epsilon_m, exclusions, 0,
-                                   polyline.size() - 1);
+  mark_exclusions(buffers.excluded, exclusions, polyline.size());
+  buffers.ranges.clear();
+  buffers.ranges.emplace_back(0, polyline.size() - 1);
+  peucker_avoid_self_intersections(point_tile_index, epsilon_m * epsilon_m, buffers.excluded,
+                                   buffers.ranges, buffers.near_points);
 
   // copy the simplified 'points' into 'polyline'
   polyline.clear();
@@ -240,32 +343,40 @@ void DouglasPeucker(container_t& polyline,
   if (epsilon <= 0 || polyline.size() < 3)
     return;
 
-  // the recursive bit
+  auto& buffers = scratch(polyline.size());
+  const coord_t* points = random_access<coord_t>(polyline);
+  const size_t size = polyline.size();
+  mark_exclusions(buffers.excluded, exclusions, size);
+  auto& keep = buffers.keep;
+  keep.assign(size, false);
+  keep.front() = keep.back() = true;
+
+  // instead of recursing we keep a stack of the ranges left to simplify
   epsilon *= epsilon;
-  std::function<void(typename container_t::iterator, size_t, typename container_t::iterator, size_t)>
-      peucker;
-  peucker = [&peucker, &polyline, epsilon, &exclusions](typename container_t::iterator start,
-                                                        size_t s, typename container_t::iterator end,
-                                                        size_t e) {
+  auto& ranges = buffers.ranges;
+  ranges.clear();
+  ranges.emplace_back(0, size - 1);
+  while (!ranges.empty()) {
+    size_t s, e;
+    std::tie(s, e) = ranges.back();
+    ranges.pop_back();
+
     // find the point furthest from the line
     typename coord_t::value_type dmax = std::numeric_limits<typename coord_t::value_type>::lowest();
-    typename container_t::iterator itr;
-    LineSegment2<coord_t> l{*start, *end};
-    size_t j = e - 1, k = 0;
+    LineSegment2<coord_t> l{points[s], points[e]};
+    size_t k = 0;
     coord_t tmp;
-    for (auto i = std::prev(end); i != start; --i, --j) {
+    for (size_t j = e - 1; j > s; --j) {
       // special points we dont want to generalize no matter what take precedence
-      if (exclusions.find(j) != exclusions.end()) {
-        itr = i;
+      if (buffers.excluded[j]) {
         dmax = epsilon;
         k = j;
         break;
       }
 
       // if this is the highest frequency detail so far
-      auto d = l.DistanceSquared(*i, tmp);
+      auto d = l.DistanceSquared(points[j], tmp);
       if (d > dmax) {
-        itr = i;
         dmax = d;
         k = j;
       }
@@ -274,20 +385,15 @@ void DouglasPeucker(container_t& polyline,
     // there are some high frequency details between start and end
     // so we need to look for flatter sections between them
     if (dmax >= epsilon) {
-      // we recurse from right to left for two reasons:
-      // 1. we want to preserve iterator validity in the vector version
-      // 2. its the only way to preserve the indices in the keep set
+      keep[k] = true;
       if (e - k > 1)
-        peucker(itr, k, end, e);
+        ranges.emplace_back(k, e);
       if (k - s > 1)
-        peucker(start, s, itr, k);
-    } // nothing sticks out between start and end so simplify everything between away
-    else
-      polyline.erase(std::next(start), end);
-  };
-
-  // recurse!
-  peucker(polyline.begin(), 0, std::prev(polyline.end()), polyline.size() - 1);
+        ranges.emplace_back(s, k);
+    } // nothing sticks out between start and end so everything between them is simplified away
+  }
+
+  remove_unkept(polyline, keep);
 }
 
 /**
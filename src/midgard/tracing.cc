@@ -0,0 +1,270 @@
+#include "midgard/tracing.h"
+#include "midgard/logging.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+#if defined(ENABLE_TRACING) && !defined(_WIN32)
+#include <csignal>
+#include <thread>
+#include <unistd.h>
+#endif
+
+namespace {
+
+using namespace valhalla::midgard;
+
+// the number of spans kept per thread, at 32 bytes each that's half a megabyte per thread which
+// keeps the last couple of seconds of a thread busy with small matrices
+constexpr uint64_t kRingCapacity = 1 << 14;
+
+// a span as it is kept in the ring, the fields are atomics so that rendering while the thread is
+// recording is well defined, they are only ever written by the thread that owns the ring
+struct span_t {
+  std::atomic<const char*> category;
+  std::atomic<const char*> name;
+  std::atomic<int64_t> begin;
+  std::atomic<int64_t> end;
+};
+
+// the spans of one thread, the thread writes a span into the slot after the last one and only then
+// publishes it by moving the head so a reader never sees a span that is still being written. When
+// the ring is full the oldest span is overwritten. Like a seqlock the thread first announces which
+// span it is about to write and fences, so that a reader who copied any part of a span being
+// overwritten is sure to see the announcement once it fences too and can drop what it copied.
+struct ring_t {
+  explicit ring_t(uint64_t id) : id(id), head(0), writing(0), spans(new span_t[kRingCapacity]) {
+  }
+
+  void push(const char* category, const char* name, int64_t begin, int64_t end) {
+    const auto h = head.load(std::memory_order_relaxed);
+    writing.store(h + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    auto& span = spans[h % kRingCapacity];
+    span.category.store(category, std::memory_order_relaxed);
+    span.name.store(name, std::memory_order_relaxed);
+    span.begin.store(begin, std::memory_order_relaxed);
+    span.end.store(end, std::memory_order_relaxed);
+    head.store(h + 1, std::memory_order_release);
+  }
+
+  uint64_t id;
+  // the number of spans which were published and which were at least started to be written
+  std::atomic<uint64_t> head;
+  std::atomic<uint64_t> writing;
+  std::unique_ptr<span_t[]> spans;
+};
+
+// the rings of all the threads which ever recorded, they are kept after their threads exit so
+// what those did can still be dumped. A thread which exits hands its ring to the next new thread
+// so that threads made per request don't grow the rings without bound, the new thread continues
+// the track of the old one
+struct registry_t {
+  std::mutex mutex;
+  std::vector<std::shared_ptr<ring_t>> rings;
+  std::vector<std::shared_ptr<ring_t>> unused;
+  std::unordered_set<std::string> interned;
+};
+
+registry_t& registry() {
+  static registry_t registry;
+  return registry;
+}
+
+// takes a ring for the thread and gives it back when the thread exits
+struct ring_owner_t {
+  ring_owner_t() {
+    auto& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    if (r.unused.empty()) {
+      r.rings.emplace_back(std::make_shared<ring_t>(r.rings.size() + 1));
+      ring = r.rings.back();
+    } else {
+      ring = std::move(r.unused.back());
+      r.unused.pop_back();
+    }
+  }
+
+  ~ring_owner_t() {
+    auto& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.unused.emplace_back(std::move(ring));
+  }
+
+  std::shared_ptr<ring_t> ring;
+};
+
+ring_t& local() {
+  thread_local ring_owner_t owner;
+  return *owner.ring;
+}
+
+int64_t nanoseconds(std::chrono::steady_clock::time_point time) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+// writes a json string, the categories and names are mostly identifiers but they can be anything
+void quote(std::ostringstream& out, const char* value) {
+  out << '"';
+  for (const char* c = value; *c; ++c) {
+    if (*c == '"' || *c == '\\') {
+      out << '\\' << *c;
+    } else if (static_cast<unsigned char>(*c) < 0x20) {
+      out << ' ';
+    } else {
+      out << *c;
+    }
+  }
+  out << '"';
+}
+
+// copies what is in a ring without stopping its thread, oldest first
+std::vector<std::tuple<const char*, const char*, int64_t, int64_t>> snapshot(const ring_t& ring) {
+  const auto head = ring.head.load(std::memory_order_acquire);
+  const auto first = head > kRingCapacity ? head - kRingCapacity : 0;
+  std::vector<std::tuple<const char*, const char*, int64_t, int64_t>> spans;
+  spans.reserve(head - first);
+  for (auto i = first; i < head; ++i) {
+    const auto& span = ring.spans[i % kRingCapacity];
+    spans.emplace_back(span.category.load(std::memory_order_relaxed),
+                       span.name.load(std::memory_order_relaxed),
+                       span.begin.load(std::memory_order_relaxed),
+                       span.end.load(std::memory_order_relaxed));
+  }
+  // the spans the thread went on to overwrite while we were copying are dropped, including the one
+  // it may still be in the middle of overwriting
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const auto now = ring.writing.load(std::memory_order_relaxed);
+  const auto overwritten = now > kRingCapacity ? now - kRingCapacity : 0;
+  if (overwritten > first) {
+    spans.erase(spans.begin(), spans.begin() + std::min(overwritten, head) - first);
+  }
+  return spans;
+}
+
+#if defined(ENABLE_TRACING) && !defined(_WIN32)
+// the handler only writes to a pipe, which is safe to do from a signal handler, and the thread
+// reading the other end does the dumping
+int signal_pipe[2] = {-1, -1};
+
+void on_signal(int) {
+  const char byte = 0;
+  [[maybe_unused]] auto written = write(signal_pipe[1], &byte, 1);
+}
+#endif
+
+} // namespace
+
+namespace valhalla {
+namespace midgard {
+namespace tracing {
+
+namespace detail {
+std::atomic<bool> enabled(true);
+} // namespace detail
+
+void enable(bool enabled) {
+  detail::enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void record(const char* category,
+            const char* name,
+            std::chrono::steady_clock::time_point begin,
+            std::chrono::steady_clock::time_point end) {
+  if (!enabled()) {
+    return;
+  }
+  local().push(category, name, nanoseconds(begin), nanoseconds(end));
+}
+
+const char* intern(const std::string& value) {
+  auto& r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  // the elements of an unordered_set don't move when it rehashes
+  return r.interned.insert(value).first->c_str();
+}
+
+std::string render(std::chrono::milliseconds window) {
+  const auto since = window == std::chrono::milliseconds::zero()
+                         ? std::numeric_limits<int64_t>::min()
+                         : nanoseconds(std::chrono::steady_clock::now() - window);
+  std::vector<std::shared_ptr<ring_t>> rings;
+  {
+    auto& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    rings = r.rings;
+  }
+
+  // spans are complete events in microseconds, there's one process and a track per thread
+  std::ostringstream json;
+  json << std::fixed;
+  json.precision(3);
+  json << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  for (const auto& ring : rings) {
+    for (const auto& span : snapshot(*ring)) {
+      if (std::get<3>(span) < since) {
+        continue;
+      }
+      json << (first ? "" : ",") << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << ring->id << ",\"cat\":";
+      quote(json, std::get<0>(span));
+      json << ",\"name\":";
+      quote(json, std::get<1>(span));
+      json << ",\"ts\":" << std::get<2>(span) / 1e3
+           << ",\"dur\":" << (std::get<3>(span) - std::get<2>(span)) / 1e3 << "}";
+      first = false;
+    }
+  }
+  json << "]}";
+  return json.str();
+}
+
+bool dump(const std::string& path) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file << render();
+  file.close();
+  return !file.fail();
+}
+
+void dump_on_signal(int signal, const std::string& path) {
+#if defined(ENABLE_TRACING) && !defined(_WIN32)
+  if (signal_pipe[0] != -1 || pipe(signal_pipe) != 0) {
+    LOG_WARN("Trace dumps on signal " + std::to_string(signal) + " could not be set up");
+    return;
+  }
+  std::thread([path]() {
+    char byte;
+    while (read(signal_pipe[0], &byte, 1) > 0) {
+      if (dump(path)) {
+        LOG_INFO("Dumped trace to " + path);
+      } else {
+        LOG_WARN("Could not dump trace to " + path);
+      }
+    }
+  }).detach();
+  std::signal(signal, on_signal);
+#else
+  (void)signal;
+  (void)path;
+#endif
+}
+
+void clear() {
+  auto& r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  for (auto& ring : r.rings) {
+    ring->head.store(0, std::memory_order_release);
+    ring->writing.store(0, std::memory_order_release);
+  }
+}
+
+} // namespace tracing
+} // namespace midgard
+} // namespace valhalla
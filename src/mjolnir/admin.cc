@@ -3,6 +3,7 @@
 #include "filesystem.h"
 #include "midgard/logging.h"
 #include "mjolnir/util.h"
+#include <algorithm>
 #include <sqlite3.h>
 #include <unordered_map>
 
@@ -62,6 +63,208 @@ uint32_t GetMultiPolyId(const std::multimap<uint32_t, multi_polygon_type>& polys
   return index;
 }
 
+namespace {
+
+// segments further than this left of the tile can never flip the crossings test of a point in it
+constexpr double kClipMargin = 1e-5;
+// slack, in cells, when finding the cells a polygon segment runs through
+constexpr double kCellMargin = 1e-6;
+
+} // namespace
+
+MultiPolyIndex::MultiPolyIndex(const std::multimap<uint32_t, multi_polygon_type>& polys,
+                               const AABB2<PointLL>& bounds,
+                               const final_predicate_t& is_final,
+                               uint32_t grid_size)
+    : polys_(polys), is_final_(is_final), bounds_(bounds), grid_size_(std::max(grid_size, 1u)),
+      cell_width_(bounds.Width() / grid_size_), cell_height_(bounds.Height() / grid_size_) {
+  // Clip the polys to the tile. The crossings test casts a ray to the right of the point and flips
+  // for every segment the ray crosses, so segments entirely above, below or left of the tile never
+  // contribute for points in it. We drop those and keep the rest as is which keeps the test exact.
+  auto clip_ring = [&](const polygon_type::ring_type& ring) {
+    segments_t segments;
+    // boost considers rings that are too small to be outside
+    if (ring.size() < bg::core_detail::closure::minimum_ring_size<bg::closed>::value) {
+      return segments;
+    }
+    for (size_t i = 1; i < ring.size(); ++i) {
+      const auto& a = ring[i - 1];
+      const auto& b = ring[i];
+      if ((a.y() < bounds_.miny() && b.y() < bounds_.miny()) ||
+          (a.y() > bounds_.maxy() && b.y() > bounds_.maxy()) ||
+          (a.x() < bounds_.minx() - kClipMargin && b.x() < bounds_.minx() - kClipMargin)) {
+        continue;
+      }
+      segments.emplace_back(a, b);
+    }
+    return segments;
+  };
+  clipped_.reserve(polys.size());
+  for (const auto& poly : polys) {
+    clipped_multi_polygon_t clipped{poly.first, {}};
+    for (const auto& polygon : poly.second) {
+      clipped_polygon_t clipped_polygon{clip_ring(polygon.outer()), {}};
+      // nothing of the outer ring left means the tile is outside of this polygon
+      if (clipped_polygon.outer.empty()) {
+        continue;
+      }
+      for (const auto& inner : polygon.inners()) {
+        auto segments = clip_ring(inner);
+        if (!segments.empty()) {
+          clipped_polygon.inners.emplace_back(std::move(segments));
+        }
+      }
+      clipped.polygons.emplace_back(std::move(clipped_polygon));
+    }
+    clipped_.emplace_back(std::move(clipped));
+  }
+
+  // Mark the cells crossed by the border of each poly. We go by the bounding box of each segment
+  // which may mark a few cells too many but never misses a cell with a border point in it.
+  std::vector<std::vector<bool>> border(clipped_.size(),
+                                        std::vector<bool>(grid_size_ * grid_size_, false));
+  auto mark_segments = [&](const segments_t& segments, std::vector<bool>& marks) {
+    for (const auto& segment : segments) {
+      const auto& a = segment.first;
+      const auto& b = segment.second;
+      double u0 = (std::min(a.x(), b.x()) - bounds_.minx()) / cell_width_ - kCellMargin;
+      double u1 = (std::max(a.x(), b.x()) - bounds_.minx()) / cell_width_ + kCellMargin;
+      double v0 = (std::min(a.y(), b.y()) - bounds_.miny()) / cell_height_ - kCellMargin;
+      double v1 = (std::max(a.y(), b.y()) - bounds_.miny()) / cell_height_ + kCellMargin;
+      if (u1 < 0 || v1 < 0 || u0 > grid_size_ || v0 > grid_size_) {
+        continue;
+      }
+      uint32_t col0 = u0 < 0 ? 0 : std::min(static_cast<uint32_t>(u0), grid_size_ - 1);
+      uint32_t col1 = std::min(static_cast<uint32_t>(u1), grid_size_ - 1);
+      uint32_t row0 = v0 < 0 ? 0 : std::min(static_cast<uint32_t>(v0), grid_size_ - 1);
+      uint32_t row1 = std::min(static_cast<uint32_t>(v1), grid_size_ - 1);
+      for (uint32_t row = row0; row <= row1; ++row) {
+        for (uint32_t col = col0; col <= col1; ++col) {
+          marks[row * grid_size_ + col] = true;
+        }
+      }
+    }
+  };
+  for (size_t i = 0; i < clipped_.size(); ++i) {
+    for (const auto& polygon : clipped_[i].polygons) {
+      mark_segments(polygon.outer, border[i]);
+      for (const auto& inner : polygon.inners) {
+        mark_segments(inner, border[i]);
+      }
+    }
+  }
+
+  // Cells without a border running through them are either entirely inside or outside of a poly so
+  // the center of the cell gives the answer for all of it
+  cells_.resize(grid_size_ * grid_size_);
+  for (uint32_t row = 0; row < grid_size_; ++row) {
+    for (uint32_t col = 0; col < grid_size_; ++col) {
+      point_type center(bounds_.minx() + (col + 0.5) * cell_width_,
+                        bounds_.miny() + (row + 0.5) * cell_height_);
+      auto& cell = cells_[row * grid_size_ + col];
+      cell.resolved = true;
+      cell.id = 0;
+      for (uint32_t i = 0; i < clipped_.size(); ++i) {
+        bool covers = !border[i][row * grid_size_ + col];
+        if (covers && !Covers(clipped_[i], center)) {
+          continue;
+        }
+
+        cell.candidates.push_back({i, covers});
+        cell.resolved = cell.resolved && covers;
+        // a covering final poly ends every search in this cell
+        if (covers && (!is_final_ || is_final_(clipped_[i].id))) {
+          break;
+        }
+      }
+
+      // if no exact test is needed anywhere in the cell we can answer it once and for all
+      if (cell.resolved) {
+        for (const auto& candidate : cell.candidates) {
+          cell.id = clipped_[candidate.poly].id;
+        }
+        cell.candidates.clear();
+        cell.candidates.shrink_to_fit();
+      }
+    }
+  }
+}
+
+// Get the polygon id covering the point, 0 if there is none
+uint32_t MultiPolyIndex::GetId(const PointLL& ll) const {
+  // the raster only covers the tile
+  if (ll.lng() < bounds_.minx() || ll.lat() < bounds_.miny() || ll.lng() > bounds_.maxx() ||
+      ll.lat() > bounds_.maxy()) {
+    return Fallback(ll);
+  }
+
+  uint32_t col = std::min(static_cast<uint32_t>((ll.lng() - bounds_.minx()) / cell_width_),
+                          grid_size_ - 1);
+  uint32_t row = std::min(static_cast<uint32_t>((ll.lat() - bounds_.miny()) / cell_height_),
+                          grid_size_ - 1);
+  const auto& cell = cells_[row * grid_size_ + col];
+  if (cell.resolved) {
+    return cell.id;
+  }
+
+  // boundary cell, same walk as GetMultiPolyId but only over the polys touching this cell
+  uint32_t index = 0;
+  point_type p(ll.lng(), ll.lat());
+  for (const auto& candidate : cell.candidates) {
+    const auto& poly = clipped_[candidate.poly];
+    if (candidate.covers || Covers(poly, p)) {
+      if (!is_final_ || is_final_(poly.id)) {
+        return poly.id;
+      }
+      index = poly.id;
+    }
+  }
+  return index;
+}
+
+// the number of raster cells that need an exact test
+size_t MultiPolyIndex::boundary_cell_count() const {
+  return std::count_if(cells_.begin(), cells_.end(),
+                       [](const cell_t& cell) { return !cell.resolved; });
+}
+
+// the same crossings test boost runs, over the clipped segments only
+bool MultiPolyIndex::Covers(const clipped_multi_polygon_t& poly, const point_type& p) {
+  using strategy_t = bg::strategy::within::crossings_multiply<point_type>;
+  auto in_ring = [&p](const segments_t& segments) {
+    bool inside = false;
+    for (const auto& segment : segments) {
+      // a fresh state per segment since the clipped segments are not connected anymore
+      strategy_t::state_type state;
+      strategy_t::apply(p, segment.first, segment.second, state);
+      inside = inside != (strategy_t::result(state) > 0);
+    }
+    return inside;
+  };
+  for (const auto& polygon : poly.polygons) {
+    if (in_ring(polygon.outer) &&
+        std::none_of(polygon.inners.begin(), polygon.inners.end(), in_ring)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// resolves a point using the original polygons
+uint32_t MultiPolyIndex::Fallback(const PointLL& ll) const {
+  uint32_t index = 0;
+  point_type p(ll.lng(), ll.lat());
+  for (const auto& poly : polys_) {
+    if (bg::covered_by(p, poly.second, bg::strategy::within::crossings_multiply<point_type>())) {
+      if (!is_final_ || is_final_(poly.first)) {
+        return poly.first;
+      }
+      index = poly.first;
+    }
+  }
+  return index;
+}
+
 // This function returns a vector pairs.  The pair is a string and boolean {language,
 // is_default_language}. The function takes a LL and checks if it is covered by a linguistic,
 // state/providence, and country polygon. If the LL is covered by the polygon, then the language is
@@ -75,6 +75,7 @@ void EdgeInfoBuilder::AddNameInfo(const baldr::NameInfo& info) {
 // Set the shape of the edge. Encode the vector of lat,lng to a string.
 template <class shape_container_t> void EdgeInfoBuilder::set_shape(const shape_container_t& shape) {
   encoded_shape_ = midgard::encode7<shape_container_t>(shape);
+  ei_.packed_shape_ = false;
 }
 template void EdgeInfoBuilder::set_shape<std::vector<PointLL>>(const std::vector<PointLL>&);
 template void EdgeInfoBuilder::set_shape<std::list<PointLL>>(const std::list<PointLL>&);
@@ -82,6 +83,19 @@ template void EdgeInfoBuilder::set_shape<std::list<PointLL>>(const std::list<Poi
 // Set the encoded shape string.
 void EdgeInfoBuilder::set_encoded_shape(const std::string& encoded_shape) {
   std::copy(encoded_shape.begin(), encoded_shape.end(), back_inserter(encoded_shape_));
+  ei_.packed_shape_ = false;
+}
+
+// Bit pack the shape if that makes it smaller.
+void EdgeInfoBuilder::pack_shape() {
+  if (ei_.packed_shape_ || encoded_shape_.empty()) {
+    return;
+  }
+  auto packed = midgard::encode_packed(midgard::decode7<std::vector<PointLL>>(encoded_shape_));
+  if (!packed.empty() && packed.size() < encoded_shape_.size()) {
+    encoded_shape_ = std::move(packed);
+    ei_.packed_shape_ = true;
+  }
 }
 
 // Set the encoded elevation vector.
@@ -1,5 +1,6 @@
 #include <future>
 #include <memory>
+#include <optional>
 #include <thread>
 #include <utility>
 
@@ -425,6 +426,7 @@ void BuildTileSet(const std::string& ways_file,
       pt.get<bool>("data_processing.infer_internal_intersections", true);
   bool use_urban_tag = pt.get<bool>("data_processing.use_urban_tag", false);
   bool use_admin_db = pt.get<bool>("data_processing.use_admin_db", true);
+  bool packed_shapes = pt.get<bool>("packed_shapes", false);
 
   // Initialize the admin DB (if it exists)
   sqlite3* admin_db_handle = (database && use_admin_db) ? GetDBHandle(*database) : nullptr;
@@ -490,6 +492,7 @@ void BuildTileSet(const std::string& ways_file,
       // Information about tile creation
       graphtile.AddTileCreationDate(tile_creation_date);
       graphtile.header_builder().set_dataset_id(osmdata.max_changeset_id_);
+      graphtile.header_builder().set_has_packed_shapes(packed_shapes);
 
       // Set the base lat,lon of the tile
       uint32_t id = tile_id.tileid();
@@ -519,6 +522,19 @@ void BuildTileSet(const std::string& ways_file,
         tile_within_one_tz = true;
       }
 
+      // Index the polygons for the point lookups of the nodes in this tile, a state poly wins over
+      // the country poly it lives in
+      std::optional<MultiPolyIndex> admin_poly_index;
+      if (use_admin_db && !tile_within_one_admin) {
+        admin_poly_index.emplace(admin_polys, tiling.TileBounds(id), [&graphtile](uint32_t index) {
+          return graphtile.admins_builder(index).state_offset() != 0;
+        });
+      }
+      std::optional<MultiPolyIndex> tz_poly_index;
+      if (!tile_within_one_tz) {
+        tz_poly_index.emplace(tz_polys, tiling.TileBounds(id));
+      }
+
       // Iterate through the nodes
       uint32_t idx = 0; // Current directed edge index
 
@@ -552,7 +568,7 @@ void BuildTileSet(const std::string& ways_file,
 
         if (use_admin_db) {
           admin_index = (tile_within_one_admin) ? admin_polys.begin()->first
-                                                : GetMultiPolyId(admin_polys, node_ll, graphtile);
+                                                : admin_poly_index->GetId(node_ll);
           dor = drive_on_right[admin_index];
           default_languages = GetMultiPolyIndexes(language_polys, node_ll);
 
@@ -1274,7 +1290,7 @@ void BuildTileSet(const std::string& ways_file,
 
         // Set the time zone index
         uint32_t tz_index =
-            (tile_within_one_tz) ? tz_polys.begin()->first : GetMultiPolyId(tz_polys, node_ll);
+            (tile_within_one_tz) ? tz_polys.begin()->first : tz_poly_index->GetId(node_ll);
 
         graphtile.nodes().back().set_timezone(tz_index);
 
@@ -199,6 +199,10 @@ GraphTileBuilder::GraphTileBuilder(const std::string& tile_dir,
       eib.AddNameInfo(info);
     }
     eib.set_encoded_shape(ei.encoded_shape());
+    // keep the shape encoded the way it was so that the offsets stay the same
+    if (ei.packed_shape()) {
+      eib.pack_shape();
+    }
 
     // Add encoded elevation (if present)
     if (ei.has_elevation()) {
@@ -389,6 +393,9 @@ void GraphTileBuilder::StoreTileData() {
     in_mem.write(reinterpret_cast<const char*>(lane_connectivity_builder_.data()),
                  lane_connectivity_builder_.size() * sizeof(LaneConnectivity));
 
+    // Reach labels are only added once the graph is final, a rebuilt tile needs them recomputed
+    header_builder_.set_reach_labels_offset(0);
+
     // Set the end offset
     header_builder_.set_end_offset(header_builder_.lane_connectivity_offset() +
                                    (lane_connectivity_builder_.size() * sizeof(LaneConnectivity)));
@@ -425,7 +432,8 @@ void GraphTileBuilder::StoreTileData() {
 // Update a graph tile with new nodes and directed edges. The rest of the
 // tile contents remains the same.
 void GraphTileBuilder::Update(const std::vector<NodeInfo>& nodes,
-                              const std::vector<DirectedEdge>& directededges) {
+                              const std::vector<DirectedEdge>& directededges,
+                              const std::vector<ReachLabel>& reach_labels) {
   // Get the name of the file
   filesystem::path filename =
       tile_dir_ + filesystem::path::preferred_separator + GraphTile::FileSuffix(header_->graphid());
@@ -438,8 +446,21 @@ void GraphTileBuilder::Update(const std::vector<NodeInfo>& nodes,
   // Open file. Truncate so we replace the contents.
   std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
   if (file.is_open()) {
-    // Write the header
-    file.write(reinterpret_cast<const char*>(header_), sizeof(GraphTileHeader));
+    // Write the header. Reach labels replace the ones already in the tile, they are the same size,
+    // or else go at the end of it
+    GraphTileHeader header = *header_;
+    uint32_t labels_offset = header_->reach_labels_offset();
+    if (!reach_labels.empty()) {
+      if (reach_labels.size() != header_->nodecount()) {
+        throw std::runtime_error("GraphTileBuilder::Update - reach label count doesnt match nodes");
+      }
+      if (labels_offset == 0) {
+        labels_offset = header_->end_offset();
+        header.set_reach_labels_offset(labels_offset);
+        header.set_end_offset(labels_offset + reach_labels.size() * sizeof(ReachLabel));
+      }
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(GraphTileHeader));
 
     // Write the updated nodes. Make sure node count matches.
     if (nodes.size() != header_->nodecount()) {
@@ -463,8 +484,18 @@ void GraphTileBuilder::Update(const std::vector<NodeInfo>& nodes,
 
     // Write the rest of the tiles
     auto begin = reinterpret_cast<const char*>(&access_restrictions_[0]);
-    auto end = reinterpret_cast<const char*>(header()) + header()->end_offset();
-    file.write(begin, end - begin);
+    auto end = reinterpret_cast<const char*>(header_) + header_->end_offset();
+    if (reach_labels.empty()) {
+      file.write(begin, end - begin);
+    } else {
+      // splice in the reach labels and keep whatever follows them
+      auto labels = reinterpret_cast<const char*>(header_) + labels_offset;
+      auto after = std::min(labels + reach_labels.size() * sizeof(ReachLabel), end);
+      file.write(begin, labels - begin);
+      file.write(reinterpret_cast<const char*>(reach_labels.data()),
+                 reach_labels.size() * sizeof(ReachLabel));
+      file.write(after, end - after);
+    }
     file.close();
   } else {
     throw std::runtime_error("GraphTileBuilder::Update - Failed to open file " + filename.string());
@@ -665,6 +696,9 @@ uint32_t GraphTileBuilder::AddEdgeInfo(const uint32_t edgeindex,
     edgeinfo.set_bike_network(bn);
     edgeinfo.set_speed_limit(spd);
     edgeinfo.set_shape(lls);
+    if (header_builder_.has_packed_shapes()) {
+      edgeinfo.pack_shape();
+    }
 
     // Add names to the common text/name list. Skip blank names.
     std::vector<NameInfo> name_info_list;
@@ -789,6 +823,9 @@ uint32_t GraphTileBuilder::AddEdgeInfo(const uint32_t edgeindex,
     edgeinfo.set_bike_network(bn);
     edgeinfo.set_speed_limit(spd);
     edgeinfo.set_encoded_shape(llstr);
+    if (header_builder_.has_packed_shapes()) {
+      edgeinfo.pack_shape();
+    }
 
     // Add names to the common text/name list. Skip blank names.
     std::vector<NameInfo> name_info_list;
@@ -1164,6 +1201,9 @@ void GraphTileBuilder::AddBins(const std::string& tile_dir,
   header.set_edgeinfo_offset(header.edgeinfo_offset() + shift);
   header.set_textlist_offset(header.textlist_offset() + shift);
   header.set_lane_connectivity_offset(header.lane_connectivity_offset() + shift);
+  if (header.reach_labels_offset() > 0) {
+    header.set_reach_labels_offset(header.reach_labels_offset() + shift);
+  }
   header.set_end_offset(header.end_offset() + shift);
   // rewrite the tile
   filesystem::path filename =
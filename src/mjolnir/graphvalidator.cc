@@ -2,8 +2,11 @@
 #include "mjolnir/graphtilebuilder.h"
 #include "mjolnir/util.h"
 
+#include <algorithm>
 #include <boost/format.hpp>
+#include <chrono>
 #include <future>
+#include <limits>
 #include <list>
 #include <mutex>
 #include <numeric>
@@ -23,6 +26,7 @@
 #include "midgard/distanceapproximator.h"
 #include "midgard/logging.h"
 #include "midgard/pointll.h"
+#include "midgard/util.h"
 
 using namespace valhalla::midgard;
 using namespace valhalla::baldr;
@@ -240,13 +244,103 @@ uint32_t GetOpposingEdgeIndex(const GraphId& startnode,
   return opp_index;
 }
 
+// Access modes which get reach labels, see baldr::ReachLabel
+constexpr uint32_t kReachLabelModes[] = {kAutoAccess, kTruckAccess, kBicycleAccess,
+                                         kPedestrianAccess};
+
+// Whether every costing of the access mode allows the edge with its default options, this mirrors
+// the conservative DynamicCost::Allowed used by loki's reach with all of its disallow flags set.
+// Costings which are stricter than this have to say so with DynamicCost::ReachLabelsApply
+bool reach_traversable(const DirectedEdge& edge, uint32_t mode) {
+  bool destonly = mode == kTruckAccess ? edge.destonly() || edge.destonly_hgv() : edge.destonly();
+  return (edge.forwardaccess() & mode) && !(edge.access_restriction() & mode) &&
+         !edge.start_restriction() && !edge.end_restriction() && !edge.restrictions() &&
+         !edge.is_shortcut() && !edge.is_hov_only() && !destonly && !edge.bss_connection() &&
+         edge.surface() != Surface::kImpassable && edge.use() != Use::kConstruction &&
+         edge.use() < Use::kRailFerry && (mode != kBicycleAccess || edge.use() != Use::kSteps) &&
+         (mode != kPedestrianAccess || edge.sac_scale() <= SacScale::kHiking);
+}
+
+// Labels each node with the size of the strongly connected components it belongs to within the
+// tile, one per access mode. This is Tarjan's algorithm with an explicit call stack
+std::vector<ReachLabel> reach_labels(const GraphId& tile_id,
+                                     const std::vector<NodeInfo>& nodes,
+                                     const std::vector<DirectedEdge>& directededges) {
+  constexpr uint32_t kUnvisited = std::numeric_limits<uint32_t>::max();
+  std::vector<ReachLabel> labels(nodes.size());
+  std::vector<uint32_t> index(nodes.size()), lowlink(nodes.size()), component;
+  std::vector<bool> on_component(nodes.size());
+  // the nodes being visited and the next of their edges to look at
+  std::vector<std::pair<uint32_t, uint32_t>> calls;
+
+  for (auto mode : kReachLabelModes) {
+    std::fill(index.begin(), index.end(), kUnvisited);
+    uint32_t counter = 0;
+    auto visit = [&](uint32_t node) {
+      index[node] = lowlink[node] = counter++;
+      component.push_back(node);
+      on_component[node] = true;
+      calls.emplace_back(node, 0);
+    };
+
+    for (uint32_t root = 0; root < nodes.size(); ++root) {
+      if (index[root] != kUnvisited || !(nodes[root].access() & mode)) {
+        continue;
+      }
+      visit(root);
+      while (!calls.empty()) {
+        auto node = calls.back().first;
+        auto& next = calls.back().second;
+
+        // look at the next edge leaving the node, we only care about those within the tile
+        if (next < nodes[node].edge_count()) {
+          const auto& edge = directededges[nodes[node].edge_index() + next++];
+          if (!reach_traversable(edge, mode) || edge.endnode().Tile_Base() != tile_id.Tile_Base() ||
+              !(nodes[edge.endnode().id()].access() & mode)) {
+            continue;
+          }
+          auto end = edge.endnode().id();
+          if (index[end] == kUnvisited) {
+            visit(end);
+          } else if (on_component[end]) {
+            lowlink[node] = std::min(lowlink[node], index[end]);
+          }
+          continue;
+        }
+
+        // all edges are done, if nothing below the node reached above it, it roots a component
+        calls.pop_back();
+        if (!calls.empty()) {
+          auto parent = calls.back().first;
+          lowlink[parent] = std::min(lowlink[parent], lowlink[node]);
+        }
+        if (lowlink[node] == index[node]) {
+          auto begin = std::find(component.begin(), component.end(), node);
+          uint32_t size = component.end() - begin;
+          for (auto member = begin; member != component.end(); ++member) {
+            labels[*member].set(mode, size);
+            on_component[*member] = false;
+          }
+          component.erase(begin, component.end());
+        }
+      }
+    }
+  }
+
+  return labels;
+}
+
 using tweeners_t = GraphTileBuilder::tweeners_t;
-void validate(
-    const boost::property_tree::ptree& pt,
-    std::deque<GraphId>& tilequeue,
-    std::mutex& lock,
-    std::promise<std::tuple<std::vector<uint32_t>, std::vector<std::vector<float>>, tweeners_t>>&
-        result) {
+// tweeners split up by the tile they have to be written to, one partition per binning thread
+using tweener_partitions_t = std::vector<tweeners_t>;
+using validate_result_t =
+    std::tuple<std::vector<uint32_t>, std::vector<std::vector<float>>, tweener_partitions_t>;
+
+void validate(const boost::property_tree::ptree& pt,
+              std::deque<GraphId>& tilequeue,
+              std::mutex& lock,
+              size_t partition_count,
+              std::promise<validate_result_t>& result) {
   // Our local copy of edges binned to tiles that they pass through (dont start or end in)
   tweeners_t tweeners;
   // Local Graphreader
@@ -450,9 +544,13 @@ void validate(
     // Bin the edges
     auto bins = GraphTileBuilder::BinEdges(tile, tweeners);
 
+    // Label the nodes with the size of their components so loki can skip most reach searches
+    auto labels = level != transit_level ? reach_labels(tile_id, nodes, directededges)
+                                         : std::vector<ReachLabel>{};
+
     // Write the new tile
     lock.lock();
-    tilebuilder.Update(nodes, directededges);
+    tilebuilder.Update(nodes, directededges, labels);
 
     // Write the bins to it
     if (tile->header()->graphid().level() == TileHierarchy::levels().back().level) {
@@ -475,45 +573,44 @@ void validate(
         LOG_INFO("Problem Way: " + std::to_string(w));
       }*/
 
+  // Partition the tweeners by the tile they go to so binning them needs no global merge
+  tweener_partitions_t partitions(partition_count);
+  for (auto& tweener : tweeners) {
+    auto partition = std::hash<GraphId>{}(tweener.first) % partition_count;
+    partitions[partition].emplace(tweener.first, std::move(tweener.second));
+  }
+  tweeners.clear();
+
   // Fill promise with return data
-  result.set_value(std::make_tuple(std::move(duplicates), std::move(densities), std::move(tweeners)));
+  result.set_value(
+      std::make_tuple(std::move(duplicates), std::move(densities), std::move(partitions)));
 }
 
-// take tweeners from different tiles' perspectives and merge into a single tweener
-// per tile that needs to update its bins
-void merge(const tweeners_t& in, tweeners_t& out) {
-  for (const auto& t : in) {
-    // shove it in
-    auto inserted = out.insert(t);
-    // had this tile already
-    if (!inserted.second) {
-      // so have to merge
-      for (size_t c = 0; c < kBinCount; ++c) {
-        auto& bin = inserted.first->second[c];
-        bin.insert(bin.end(), t.second[c].cbegin(), t.second[c].cend());
+// take one partition of tweeners from every validation thread, merge them into a single tweener per
+// tile and crack open those tiles to bin the edges that pass through them but dont end or begin in
+// them. no other thread touches the tiles in this partition so none of this needs locking
+void bin_tweeners(const std::string& tile_dir,
+                  std::vector<tweener_partitions_t>& results,
+                  size_t partition,
+                  uint64_t dataset_id) {
+  tweeners_t tweeners;
+  for (auto& result : results) {
+    for (auto& t : result[partition]) {
+      // shove it in
+      auto inserted = tweeners.try_emplace(t.first, std::move(t.second));
+      // had this tile already so have to merge
+      if (!inserted.second) {
+        for (size_t c = 0; c < kBinCount; ++c) {
+          auto& bin = inserted.first->second[c];
+          bin.insert(bin.end(), t.second[c].cbegin(), t.second[c].cend());
+        }
       }
     }
+    // we own this now, free it as we go
+    tweeners_t().swap(result[partition]);
   }
-}
-
-// crack open tiles and bin edges that pass through them but dont end or begin in them
-void bin_tweeners(const std::string& tile_dir,
-                  tweeners_t::iterator& start,
-                  const tweeners_t::iterator& end,
-                  uint64_t dataset_id,
-                  std::mutex& lock) {
-  // go while we have tiles to update
-  while (true) {
-    lock.lock();
-    if (start == end) {
-      lock.unlock();
-      break;
-    }
-    // grab this tile and its extra bin edges
-    const auto& tile_bin = *start;
-    ++start;
-    lock.unlock();
 
+  for (const auto& tile_bin : tweeners) {
     // some tiles are just there because edges' shapes passes through them (no edges/nodes, just bins)
     // if that's the case we need to make a tile to store the spatial index (binned edges) there
     auto tile = GraphTile::Create(tile_dir, tile_bin.first);
@@ -535,6 +632,22 @@ namespace mjolnir {
 
 void GraphValidator::Validate(const boost::property_tree::ptree& pt) {
   LOG_INFO("Validating, finishing and binning tiles...");
+  auto start_time = std::chrono::steady_clock::now();
+  // say how long a phase took and the peak memory of the process so far
+  auto report = [&start_time](const std::string& phase) {
+    auto now = std::chrono::steady_clock::now();
+    std::string message =
+        phase + " took " +
+        std::to_string(std::chrono::duration_cast<std::chrono::seconds>(now - start_time).count()) +
+        "s";
+    if (memory_status::supported()) {
+      for (const auto& metric : memory_status({"VmHWM"}).metrics) {
+        message += ", peak memory " + std::to_string(metric.second.first) + metric.second.second;
+      }
+    }
+    LOG_INFO(message);
+    start_time = now;
+  };
   auto hierarchy_properties = pt.get_child("mjolnir");
   std::string tile_dir = hierarchy_properties.get<std::string>("tile_dir");
 
@@ -562,15 +675,13 @@ void GraphValidator::Validate(const boost::property_tree::ptree& pt) {
                pt.get<unsigned int>("mjolnir.concurrency", std::thread::hardware_concurrency())));
 
   // Setup promises
-  std::list<
-      std::promise<std::tuple<std::vector<uint32_t>, std::vector<std::vector<float>>, tweeners_t>>>
-      results;
+  std::list<std::promise<validate_result_t>> results;
 
   // Spawn the threads
   for (auto& thread : threads) {
     results.emplace_back();
     thread.reset(new std::thread(validate, std::cref(pt), std::ref(tilequeue), std::ref(lock),
-                                 std::ref(results.back())));
+                                 threads.size(), std::ref(results.back())));
   }
 
   // Wait for threads to finish
@@ -580,7 +691,8 @@ void GraphValidator::Validate(const boost::property_tree::ptree& pt) {
   // Get the promise from the future
   std::vector<uint32_t> duplicates(TileHierarchy::levels().size(), 0);
   std::vector<std::vector<float>> densities(3);
-  tweeners_t tweeners;
+  std::vector<tweener_partitions_t> tweeners;
+  tweeners.reserve(results.size());
   for (auto& result : results) {
     auto data = result.get_future().get();
     // Total up duplicates for each level
@@ -591,22 +703,22 @@ void GraphValidator::Validate(const boost::property_tree::ptree& pt) {
       }
     }
     // keep track of tweeners
-    merge(std::get<2>(data), tweeners);
+    tweeners.emplace_back(std::move(std::get<2>(data)));
   }
   LOG_INFO("Finished");
+  report("Validation");
 
-  // run a pass to add the edges that binned to tweener tiles
+  // run a pass to add the edges that binned to tweener tiles, each thread gets its own partition
   LOG_INFO("Binning inter-tile edges...");
-  auto start = tweeners.begin();
-  auto end = tweeners.end();
-  for (auto& thread : threads) {
-    thread.reset(new std::thread(bin_tweeners, std::cref(tile_dir), std::ref(start), std::cref(end),
-                                 dataset_id, std::ref(lock)));
+  for (size_t i = 0; i < threads.size(); ++i) {
+    threads[i].reset(
+        new std::thread(bin_tweeners, std::cref(tile_dir), std::ref(tweeners), i, dataset_id));
   }
   for (auto& thread : threads) {
     thread->join();
   }
   LOG_INFO("Finished");
+  report("Binning");
 
   // print dupcount and find densities
   for (uint8_t level = 0; level < TileHierarchy::levels().size(); level++) {
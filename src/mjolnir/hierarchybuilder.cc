@@ -175,8 +175,9 @@ void FormTilesInNewLevel(GraphReader& reader,
       continue;
     }
 
-    // Copy the data version
+    // Copy the data version and how shapes are stored
     tilebuilder->header_builder().set_dataset_id(tile->header()->dataset_id());
+    tilebuilder->header_builder().set_has_packed_shapes(tile->header()->has_packed_shapes());
 
     // Copy node information and set the node lat,lon offsets within the new tile
     NodeInfo baseni = *(tile->node(base_node.id()));
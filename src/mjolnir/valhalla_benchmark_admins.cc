@@ -1,5 +1,7 @@
+#include <chrono>
 #include <cinttypes>
 #include <cstdint>
+#include <map>
 #include <unordered_map>
 #include <vector>
 
@@ -25,6 +27,7 @@
 #include "midgard/logging.h"
 #include "midgard/pointll.h"
 #include "midgard/util.h"
+#include "mjolnir/admin.h"
 #include "mjolnir/util.h"
 
 #include "argparse_utils.h"
@@ -32,19 +35,17 @@
 using namespace valhalla::midgard;
 using namespace valhalla::baldr;
 
-// Geometry types for admin queries
-typedef boost::geometry::model::d2::point_xy<double> point_type;
-typedef boost::geometry::model::polygon<point_type> polygon_type;
-typedef boost::geometry::model::multi_polygon<polygon_type> multi_polygon_type;
+using valhalla::mjolnir::multi_polygon_type;
+using valhalla::mjolnir::MultiPolyIndex;
 
 filesystem::path config_file_path;
 
-std::unordered_map<uint32_t, multi_polygon_type>
+std::multimap<uint32_t, multi_polygon_type>
 GetAdminInfo(sqlite3* db_handle,
              std::unordered_map<uint32_t, bool>& drive_on_right,
              const AABB2<PointLL>& aabb) {
   // Polys (return)
-  std::unordered_map<uint32_t, multi_polygon_type> polys;
+  std::multimap<uint32_t, multi_polygon_type> polys;
 
   // Form query
   std::string sql = "SELECT state.rowid, country.name, state.name, country.iso_code, ";
@@ -167,8 +168,10 @@ void Benchmark(const boost::property_tree::ptree& pt) {
   auto tiles = TileHierarchy::levels().back().tiles;
 
   // Iterate through the tiles and perform enhancements
-  std::unordered_map<uint32_t, multi_polygon_type> polys;
+  std::multimap<uint32_t, multi_polygon_type> polys;
   std::unordered_map<uint32_t, bool> drive_on_right;
+  std::chrono::nanoseconds linear_time(0), index_build_time(0), index_lookup_time(0);
+  size_t lookups = 0, mismatches = 0, boundary_cells = 0, cells = 0;
   for (uint32_t id = 0; id < tiles.TileCount(); id++) {
     // Get the admin polys if there is data for tiles that exist
     GraphId tile_id(id, local_level, 0);
@@ -178,6 +181,39 @@ void Benchmark(const boost::property_tree::ptree& pt) {
       if (polys.size() < 128) {
         counts[polys.size()]++;
       }
+
+      // Time the node lookups done while building the tile, once with a linear scan over the polys
+      // and once through the per tile index (including the time to build it)
+      auto tile = reader.GetGraphTile(tile_id);
+      if (!tile || polys.empty()) {
+        continue;
+      }
+      std::vector<PointLL> node_lls;
+      node_lls.reserve(tile->header()->nodecount());
+      for (uint32_t n = 0; n < tile->header()->nodecount(); ++n) {
+        node_lls.push_back(tile->get_node_ll(GraphId(tile_id.tileid(), local_level, n)));
+      }
+
+      std::vector<uint32_t> linear_ids;
+      linear_ids.reserve(node_lls.size());
+      auto t0 = std::chrono::high_resolution_clock::now();
+      for (const auto& ll : node_lls) {
+        linear_ids.push_back(valhalla::mjolnir::GetMultiPolyId(polys, ll));
+      }
+      auto t1 = std::chrono::high_resolution_clock::now();
+      MultiPolyIndex index(polys, tiles.TileBounds(id));
+      auto t2 = std::chrono::high_resolution_clock::now();
+      for (size_t n = 0; n < node_lls.size(); ++n) {
+        mismatches += index.GetId(node_lls[n]) != linear_ids[n];
+      }
+      auto t3 = std::chrono::high_resolution_clock::now();
+
+      linear_time += t1 - t0;
+      index_build_time += t2 - t1;
+      index_lookup_time += t3 - t2;
+      lookups += node_lls.size();
+      boundary_cells += index.boundary_cell_count();
+      cells += MultiPolyIndex::kDefaultGridSize * MultiPolyIndex::kDefaultGridSize;
     }
   }
   for (uint32_t i = 0; i < 128; i++) {
@@ -185,6 +221,19 @@ void Benchmark(const boost::property_tree::ptree& pt) {
       LOG_INFO("Tiles with " + std::to_string(i) + " admin polys: " + std::to_string(counts[i]));
     }
   }
+
+  auto ms = [](const std::chrono::nanoseconds& t) {
+    return std::to_string(std::chrono::duration<double, std::milli>(t).count()) + " ms";
+  };
+  LOG_INFO("Node lookups: " + std::to_string(lookups));
+  LOG_INFO("Linear scan: " + ms(linear_time));
+  LOG_INFO("Polygon index: " + ms(index_build_time + index_lookup_time) + " (build " +
+           ms(index_build_time) + ", lookup " + ms(index_lookup_time) + ")");
+  LOG_INFO("Boundary cells: " + std::to_string(boundary_cells) + " of " + std::to_string(cells));
+  if (mismatches) {
+    LOG_ERROR("Polygon index disagrees with the linear scan for " + std::to_string(mismatches) +
+              " nodes");
+  }
   sqlite3_close(db_handle);
 }
 
@@ -1,5 +1,6 @@
 #include "odin/directionsbuilder.h"
 #include "midgard/logging.h"
+#include "midgard/tracing.h"
 #include "odin/enhancedtrippath.h"
 #include "odin/maneuversbuilder.h"
 #include "odin/markup_formatter.h"
@@ -24,6 +25,7 @@ namespace odin {
 // calls PopulateDirectionsLeg to transform the maneuver list into the
 // trip directions.
 void DirectionsBuilder::Build(Api& api, const MarkupFormatter& markup_formatter) {
+  VALHALLA_TRACE_SCOPE("odin", "directions_builder");
   const auto& options = api.options();
   for (auto& trip_route : *api.mutable_trip()->mutable_routes()) {
     auto& directions_route = *api.mutable_directions()->mutable_routes()->Add();
@@ -38,9 +40,9 @@ void DirectionsBuilder::Build(Api& api, const MarkupFormatter& markup_formatter)
       // Create an enhanced trip path from the specified trip_path
       EnhancedTripLeg etp(trip_path);
 
-      // Produce maneuvers if desired
+      // Produce maneuvers if desired, the gpx serializer only uses the trip so skip them there
       std::list<Maneuver> maneuvers;
-      if (options.directions_type() != DirectionsType::none) {
+      if (options.directions_type() != DirectionsType::none && options.format() != Options::gpx) {
         // Update the heading of ~0 length edges
         UpdateHeading(&etp);
 
@@ -144,7 +144,10 @@ std::list<Maneuver> ManeuversBuilder::Build() {
   // Each maneuver should get the landmarks associated with edges in the previous maneuver
   AddLandmarksFromTripLegToManeuvers(maneuvers);
 
-  ProcessVerbalSuccinctTransitionInstruction(maneuvers);
+  // Only needed when the verbal instructions are going to be formed
+  if (!options_.has_verbal_instructions_case() || options_.verbal_instructions()) {
+    ProcessVerbalSuccinctTransitionInstruction(maneuvers);
+  }
 
 #ifdef LOGGING_LEVEL_TRACE
   int final_man_id = 1;
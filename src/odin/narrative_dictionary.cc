@@ -1,3 +1,8 @@
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <stdexcept>
+
 #include <boost/property_tree/ptree.hpp>
 
 #include "midgard/logging.h"
@@ -28,11 +33,114 @@ std::unordered_map<K, V> as_unordered_map(boost::property_tree::ptree const& pt,
   return items;
 }
 
+// Phrase tag strings and the tags they compile to
+const std::unordered_map<std::string_view, valhalla::odin::PhraseTag> kPhraseTags = {
+    {kCardinalDirectionTag, valhalla::odin::PhraseTag::kCardinalDirection},
+    {kRelativeDirectionTag, valhalla::odin::PhraseTag::kRelativeDirection},
+    {kOrdinalValueTag, valhalla::odin::PhraseTag::kOrdinalValue},
+    {kStreetNamesTag, valhalla::odin::PhraseTag::kStreetNames},
+    {kPreviousStreetNamesTag, valhalla::odin::PhraseTag::kPreviousStreetNames},
+    {kBeginStreetNamesTag, valhalla::odin::PhraseTag::kBeginStreetNames},
+    {kCrossStreetNamesTag, valhalla::odin::PhraseTag::kCrossStreetNames},
+    {kRoundaboutExitStreetNamesTag, valhalla::odin::PhraseTag::kRoundaboutExitStreetNames},
+    {kRoundaboutExitBeginStreetNamesTag, valhalla::odin::PhraseTag::kRoundaboutExitBeginStreetNames},
+    {kRampExitNumbersVisualTag, valhalla::odin::PhraseTag::kRampExitNumbersVisual},
+    {kObjectLabelTag, valhalla::odin::PhraseTag::kObjectLabel},
+    {kLengthTag, valhalla::odin::PhraseTag::kLength},
+    {kDestinationTag, valhalla::odin::PhraseTag::kDestination},
+    {kCurrentVerbalCueTag, valhalla::odin::PhraseTag::kCurrentVerbalCue},
+    {kNextVerbalCueTag, valhalla::odin::PhraseTag::kNextVerbalCue},
+    {kNumberSignTag, valhalla::odin::PhraseTag::kNumberSign},
+    {kBranchSignTag, valhalla::odin::PhraseTag::kBranchSign},
+    {kTowardSignTag, valhalla::odin::PhraseTag::kTowardSign},
+    {kNameSignTag, valhalla::odin::PhraseTag::kNameSign},
+    {kJunctionNameTag, valhalla::odin::PhraseTag::kJunctionName},
+    {kFerryLabelTag, valhalla::odin::PhraseTag::kFerryLabel},
+    {kTransitPlatformTag, valhalla::odin::PhraseTag::kTransitPlatform},
+    {kStationLabelTag, valhalla::odin::PhraseTag::kStationLabel},
+    {kTimeTag, valhalla::odin::PhraseTag::kTime},
+    {kTransitNameTag, valhalla::odin::PhraseTag::kTransitName},
+    {kTransitHeadSignTag, valhalla::odin::PhraseTag::kTransitHeadSign},
+    {kTransitPlatformCountTag, valhalla::odin::PhraseTag::kTransitPlatformCount},
+    {kTransitPlatformCountLabelTag, valhalla::odin::PhraseTag::kTransitPlatformCountLabel},
+    {kLevelTag, valhalla::odin::PhraseTag::kLevel},
+};
+
+constexpr size_t kPhraseTagCount = static_cast<size_t>(valhalla::odin::PhraseTag::kLiteral);
+
 } // namespace
 
 namespace valhalla {
 namespace odin {
 
+PhraseTemplate::PhraseTemplate(const std::string& phrase) : phrase_(phrase) {
+  // Split the phrase into literal runs and tag slots
+  size_t literal_start = 0;
+  size_t tag_start = phrase_.find('<');
+  while (tag_start != std::string::npos) {
+    size_t tag_end = phrase_.find('>', tag_start);
+    if (tag_end == std::string::npos) {
+      break;
+    }
+    ++tag_end;
+
+    // Unknown tags are left in the literal text
+    auto tag = kPhraseTags.find(std::string_view(phrase_).substr(tag_start, tag_end - tag_start));
+    if (tag == kPhraseTags.end()) {
+      tag_start = phrase_.find('<', tag_start + 1);
+      continue;
+    }
+
+    if (tag_start > literal_start) {
+      slots_.push_back({static_cast<uint32_t>(literal_start),
+                        static_cast<uint32_t>(tag_start - literal_start), PhraseTag::kLiteral});
+    }
+    slots_.push_back({static_cast<uint32_t>(tag_start), static_cast<uint32_t>(tag_end - tag_start),
+                      tag->second});
+    literal_start = tag_end;
+    tag_start = phrase_.find('<', tag_end);
+  }
+
+  if (literal_start < phrase_.size()) {
+    slots_.push_back({static_cast<uint32_t>(literal_start),
+                      static_cast<uint32_t>(phrase_.size() - literal_start), PhraseTag::kLiteral});
+  }
+}
+
+void PhraseTemplate::Format(std::string& buffer, std::initializer_list<tag_value_t> values) const {
+  // Index the values by tag so each slot is a direct lookup
+  std::array<const std::string_view*, kPhraseTagCount> tag_values{};
+  size_t size = phrase_.size();
+  for (const auto& value : values) {
+    tag_values[static_cast<size_t>(value.first)] = &value.second;
+    size += value.second.size();
+  }
+
+  buffer.clear();
+  buffer.reserve(size);
+  for (const auto& slot : slots_) {
+    const std::string_view* value =
+        slot.tag == PhraseTag::kLiteral ? nullptr : tag_values[static_cast<size_t>(slot.tag)];
+    if (value) {
+      buffer.append(value->data(), value->size());
+    } else {
+      buffer.append(phrase_, slot.offset, slot.length);
+    }
+  }
+}
+
+const std::string& PhraseTemplate::phrase() const {
+  return phrase_;
+}
+
+const PhraseTemplate& PhraseSet::GetTemplate(size_t phrase_id) const {
+  const auto& phrase_template = templates.at(phrase_id);
+  if (!phrase_template) {
+    throw std::out_of_range("No phrase with id " + std::to_string(phrase_id));
+  }
+  return *phrase_template;
+}
+
 NarrativeDictionary::NarrativeDictionary(const std::string& language_tag,
                                          const boost::property_tree::ptree& narrative_pt) {
   this->language_tag = language_tag;
@@ -343,6 +451,21 @@ void NarrativeDictionary::Load(PhraseSet& phrase_handle,
                                const boost::property_tree::ptree& phrase_pt) {
 
   phrase_handle.phrases = as_unordered_map<std::string, std::string>(phrase_pt, kPhrasesKey);
+
+  // Compile the phrases so the narrative builder doesn't have to parse them per maneuver
+  phrase_handle.templates.clear();
+  for (const auto& phrase : phrase_handle.phrases) {
+    const auto is_digit = [](char c) { return std::isdigit(static_cast<unsigned char>(c)); };
+    if (phrase.first.empty() || !std::all_of(phrase.first.begin(), phrase.first.end(), is_digit)) {
+      LOG_WARN("Skipping phrase with non numeric id: " + phrase.first);
+      continue;
+    }
+    size_t phrase_id = std::stoul(phrase.first);
+    if (phrase_id >= phrase_handle.templates.size()) {
+      phrase_handle.templates.resize(phrase_id + 1);
+    }
+    phrase_handle.templates[phrase_id].emplace(phrase.second);
+  }
 }
 
 void NarrativeDictionary::Load(StartSubset& start_handle,
@@ -49,8 +49,18 @@ NarrativeBuilder::NarrativeBuilder(const Options& options,
 }
 
 void NarrativeBuilder::Build(std::list<Maneuver>& maneuvers) {
+  // Only form what the request asked for, the rest of the maneuvers keep empty instructions
+  const bool verbal_instructions =
+      !options_.has_verbal_instructions_case() || options_.verbal_instructions();
+  const uint32_t maneuver_limit = options_.narrative_maneuver_limit();
+
   Maneuver* prev_maneuver = nullptr;
+  uint32_t maneuver_count = 0;
   for (auto& maneuver : maneuvers) {
+    if (maneuver_limit > 0 && maneuver_count++ == maneuver_limit) {
+      break;
+    }
+
     switch (maneuver.type()) {
       case DirectionsLeg_Maneuver_Type_kStartRight:
       case DirectionsLeg_Maneuver_Type_kStart:
@@ -59,17 +69,6 @@ void NarrativeBuilder::Build(std::list<Maneuver>& maneuvers) {
       case DirectionsLeg_Maneuver_Type_kPostTransitConnectionDestination: {
         // Set instruction
         maneuver.set_instruction(FormStartInstruction(maneuver));
-
-        // Set verbal succinct transition instruction
-        maneuver.set_verbal_succinct_transition_instruction(
-            FormVerbalSuccinctStartTransitionInstruction(maneuver));
-
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(FormVerbalStartInstruction(maneuver));
-
-        // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            FormVerbalPostTransitionInstruction(maneuver, maneuver.HasBeginStreetNames()));
         break;
       }
       case DirectionsLeg_Maneuver_Type_kDestinationRight:
@@ -77,32 +76,13 @@ void NarrativeBuilder::Build(std::list<Maneuver>& maneuvers) {
       case DirectionsLeg_Maneuver_Type_kDestinationLeft: {
         // Set instruction
         maneuver.set_instruction(FormDestinationInstruction(maneuver));
-
-        // Set verbal transition alert instruction
-        maneuver.set_verbal_transition_alert_instruction(
-            FormVerbalAlertDestinationInstruction(maneuver));
-
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(FormVerbalDestinationInstruction(maneuver));
         break;
       }
       case DirectionsLeg_Maneuver_Type_kBecomes: {
         if (prev_maneuver) {
           // Set instruction
           maneuver.set_instruction(FormBecomesInstruction(maneuver, prev_maneuver));
-
-          // Set verbal pre transition instruction
-          maneuver.set_verbal_pre_transition_instruction(
-              FormVerbalBecomesInstruction(maneuver, prev_maneuver));
         }
-
-        // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            FormVerbalPostTransitionInstruction(maneuver,
-                                                maneuver
-                                                    .HasBeginStreetNames())); // Set verbal succinct
-                                                                              // transition
-                                                                              // instruction
         break;
       }
       case DirectionsLeg_Maneuver_Type_kSlightRight:
@@ -113,106 +93,29 @@ void NarrativeBuilder::Build(std::list<Maneuver>& maneuvers) {
       case DirectionsLeg_Maneuver_Type_kLeft: {
         // Set instruction
         maneuver.set_instruction(FormTurnInstruction(maneuver));
-
-        // Set verbal succinct transition instruction
-        maneuver.set_verbal_succinct_transition_instruction(
-            FormVerbalSuccinctTurnTransitionInstruction(maneuver));
-
-        // Set verbal transition alert instruction
-        maneuver.set_verbal_transition_alert_instruction(FormVerbalAlertTurnInstruction(maneuver));
-
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(FormVerbalTurnInstruction(maneuver));
-
-        // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            FormVerbalPostTransitionInstruction(maneuver, maneuver.HasBeginStreetNames()));
         break;
       }
       case DirectionsLeg_Maneuver_Type_kUturnRight:
       case DirectionsLeg_Maneuver_Type_kUturnLeft: {
         // Set instruction
         maneuver.set_instruction(FormUturnInstruction(maneuver));
-
-        // Set verbal succinct transition instruction
-        maneuver.set_verbal_succinct_transition_instruction(
-            FormVerbalSuccinctUturnTransitionInstruction(maneuver));
-
-        // Set verbal transition alert instruction
-        maneuver.set_verbal_transition_alert_instruction(FormVerbalAlertUturnInstruction(maneuver));
-
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(FormVerbalUturnInstruction(maneuver));
-
-        // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            FormVerbalPostTransitionInstruction(maneuver));
         break;
       }
       case DirectionsLeg_Maneuver_Type_kRampStraight: {
         // Set instruction
         maneuver.set_instruction(FormRampStraightInstruction(maneuver));
-
-        // Set verbal transition alert instruction
-        maneuver.set_verbal_transition_alert_instruction(
-            FormVerbalAlertRampStraightInstruction(maneuver));
-
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(FormVerbalRampStraightInstruction(maneuver));
-
-        // Only set verbal post if > min ramp length
-        // or contains obvious maneuver
-        // or has collapsed merge maneuver
-        if ((maneuver.length() > kVerbalPostMinimumRampLength) ||
-            maneuver.contains_obvious_maneuver() || maneuver.has_collapsed_merge_maneuver()) {
-          // Set verbal post transition instruction
-          maneuver.set_verbal_post_transition_instruction(
-              FormVerbalPostTransitionInstruction(maneuver));
-        }
         break;
       }
       case DirectionsLeg_Maneuver_Type_kRampRight:
       case DirectionsLeg_Maneuver_Type_kRampLeft: {
         // Set instruction
         maneuver.set_instruction(FormRampInstruction(maneuver));
-
-        // Set verbal transition alert instruction
-        maneuver.set_verbal_transition_alert_instruction(FormVerbalAlertRampInstruction(maneuver));
-
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(FormVerbalRampInstruction(maneuver));
-
-        // Only set verbal post if > min ramp length
-        // or contains obvious maneuver
-        // or has collapsed merge maneuver
-        if ((maneuver.length() > kVerbalPostMinimumRampLength) ||
-            maneuver.contains_obvious_maneuver() || maneuver.has_collapsed_merge_maneuver()) {
-          // Set verbal post transition instruction
-          maneuver.set_verbal_post_transition_instruction(
-              FormVerbalPostTransitionInstruction(maneuver));
-        }
         break;
       }
       case DirectionsLeg_Maneuver_Type_kExitRight:
       case DirectionsLeg_Maneuver_Type_kExitLeft: {
         // Set instruction
         maneuver.set_instruction(FormExitInstruction(maneuver));
-
-        // Set verbal transition alert instruction
-        maneuver.set_verbal_transition_alert_instruction(FormVerbalAlertExitInstruction(maneuver));
-
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(FormVerbalExitInstruction(maneuver));
-
-        // Only set verbal post if > min ramp length
-        // or contains obvious maneuver
-        // or has collapsed merge maneuver
-        if ((maneuver.length() > kVerbalPostMinimumRampLength) ||
-            maneuver.contains_obvious_maneuver() || maneuver.has_collapsed_merge_maneuver()) {
-          // Set verbal post transition instruction
-          maneuver.set_verbal_post_transition_instruction(
-              FormVerbalPostTransitionInstruction(maneuver));
-        }
         break;
       }
       case DirectionsLeg_Maneuver_Type_kStayStraight:
@@ -221,48 +124,9 @@ void NarrativeBuilder::Build(std::list<Maneuver>& maneuvers) {
         if (maneuver.to_stay_on()) {
           // Set stay on instruction
           maneuver.set_instruction(FormKeepToStayOnInstruction(maneuver));
-
-          // Set verbal transition alert instruction
-          maneuver.set_verbal_transition_alert_instruction(
-              FormVerbalAlertKeepToStayOnInstruction(maneuver));
-
-          // Set verbal pre transition instruction
-          maneuver.set_verbal_pre_transition_instruction(FormVerbalKeepToStayOnInstruction(maneuver));
-
-          // For a ramp - only set verbal post if > min ramp length
-          if (maneuver.ramp() && !maneuver.has_collapsed_merge_maneuver()) {
-            if (maneuver.length() > kVerbalPostMinimumRampLength) {
-              // Set verbal post transition instruction
-              maneuver.set_verbal_post_transition_instruction(
-                  FormVerbalPostTransitionInstruction(maneuver));
-            }
-          } else {
-            // Set verbal post transition instruction
-            maneuver.set_verbal_post_transition_instruction(
-                FormVerbalPostTransitionInstruction(maneuver));
-          }
         } else {
           // Set instruction
           maneuver.set_instruction(FormKeepInstruction(maneuver));
-
-          // Set verbal transition alert instruction
-          maneuver.set_verbal_transition_alert_instruction(FormVerbalAlertKeepInstruction(maneuver));
-
-          // Set verbal pre transition instruction
-          maneuver.set_verbal_pre_transition_instruction(FormVerbalKeepInstruction(maneuver));
-
-          // For a ramp - only set verbal post if > min ramp length
-          if (maneuver.ramp() && !maneuver.has_collapsed_merge_maneuver()) {
-            if (maneuver.length() > kVerbalPostMinimumRampLength) {
-              // Set verbal post transition instruction
-              maneuver.set_verbal_post_transition_instruction(
-                  FormVerbalPostTransitionInstruction(maneuver));
-            }
-          } else {
-            // Set verbal post transition instruction
-            maneuver.set_verbal_post_transition_instruction(
-                FormVerbalPostTransitionInstruction(maneuver));
-          }
         }
         break;
       }
@@ -271,213 +135,74 @@ void NarrativeBuilder::Build(std::list<Maneuver>& maneuvers) {
       case DirectionsLeg_Maneuver_Type_kMergeLeft: {
         // Set instruction
         maneuver.set_instruction(FormMergeInstruction(maneuver));
-
-        // Set verbal succinct transition instruction
-        maneuver.set_verbal_succinct_transition_instruction(
-            FormVerbalSuccinctMergeTransitionInstruction(maneuver));
-
-        // Set verbal transition alert instruction if previous maneuver
-        // is greater than 2 km
-        if (prev_maneuver && (prev_maneuver->length(Options::kilometers) >
-                              kVerbalAlertMergePriorManeuverMinimumLength)) {
-          maneuver.set_verbal_transition_alert_instruction(FormVerbalAlertMergeInstruction(maneuver));
-        }
-
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(FormVerbalMergeInstruction(maneuver));
-
-        // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            FormVerbalPostTransitionInstruction(maneuver));
         break;
       }
       case DirectionsLeg_Maneuver_Type_kRoundaboutEnter: {
         // Set instruction
         maneuver.set_instruction(FormEnterRoundaboutInstruction(maneuver));
-
-        // Set verbal succinct transition instruction
-        maneuver.set_verbal_succinct_transition_instruction(
-            FormVerbalSuccinctEnterRoundaboutTransitionInstruction(maneuver));
-
-        // Set verbal transition alert instruction
-        maneuver.set_verbal_transition_alert_instruction(
-            FormVerbalAlertEnterRoundaboutInstruction(maneuver));
-
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            FormVerbalEnterRoundaboutInstruction(maneuver));
-
-        // If the maneuver has a combined enter exit roundabout instruction
-        // then set verbal post transition instruction
-        if (maneuver.has_combined_enter_exit_roundabout()) {
-          maneuver.set_verbal_post_transition_instruction(
-              FormVerbalPostTransitionInstruction(maneuver,
-                                                  maneuver.HasRoundaboutExitBeginStreetNames()));
-        }
         break;
       }
       case DirectionsLeg_Maneuver_Type_kRoundaboutExit: {
         // Set instruction
         maneuver.set_instruction(FormExitRoundaboutInstruction(maneuver));
-
-        // Set verbal succinct transition instruction
-        maneuver.set_verbal_succinct_transition_instruction(
-            FormVerbalSuccinctExitRoundaboutTransitionInstruction(maneuver));
-
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(FormVerbalExitRoundaboutInstruction(maneuver));
-
-        // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            FormVerbalPostTransitionInstruction(maneuver, maneuver.HasBeginStreetNames()));
         break;
       }
       case DirectionsLeg_Maneuver_Type_kFerryEnter: {
         // Set instruction
         maneuver.set_instruction(FormEnterFerryInstruction(maneuver));
-
-        // Set verbal transition alert instruction
-        maneuver.set_verbal_transition_alert_instruction(
-            FormVerbalAlertEnterFerryInstruction(maneuver));
-
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(FormVerbalEnterFerryInstruction(maneuver));
-
-        // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            FormVerbalPostTransitionInstruction(maneuver));
         break;
       }
       case DirectionsLeg_Maneuver_Type_kTransitConnectionStart: {
         // Set instruction
         maneuver.set_instruction(FormTransitConnectionStartInstruction(maneuver));
-
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            FormVerbalTransitConnectionStartInstruction(maneuver));
-
-        // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            FormVerbalPostTransitionInstruction(maneuver));
         break;
       }
       case DirectionsLeg_Maneuver_Type_kTransitConnectionTransfer: {
         // Set instruction
         maneuver.set_instruction(FormTransitConnectionTransferInstruction(maneuver));
-
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            FormVerbalTransitConnectionTransferInstruction(maneuver));
-
-        // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            FormVerbalPostTransitionInstruction(maneuver));
         break;
       }
       case DirectionsLeg_Maneuver_Type_kTransitConnectionDestination: {
         // Set instruction
         maneuver.set_instruction(FormTransitConnectionDestinationInstruction(maneuver));
-
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            FormVerbalTransitConnectionDestinationInstruction(maneuver));
-
-        // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            FormVerbalPostTransitionInstruction(maneuver));
         break;
       }
       case DirectionsLeg_Maneuver_Type_kTransit: {
         // Set depart instruction
         maneuver.set_depart_instruction(FormDepartInstruction(maneuver));
 
-        // Set verbal depart instruction
-        maneuver.set_verbal_depart_instruction(FormVerbalDepartInstruction(maneuver));
-
         // Set instruction
         maneuver.set_instruction(FormTransitInstruction(maneuver));
 
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(FormVerbalTransitInstruction(maneuver));
-
-        // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            FormVerbalPostTransitionTransitInstruction(maneuver));
-
         // Set arrive instruction
         maneuver.set_arrive_instruction(FormArriveInstruction(maneuver));
-
-        // Set verbal arrive instruction
-        maneuver.set_verbal_arrive_instruction(FormVerbalArriveInstruction(maneuver));
-
         break;
       }
       case DirectionsLeg_Maneuver_Type_kTransitRemainOn: {
         // Set depart instruction
         maneuver.set_depart_instruction(FormDepartInstruction(maneuver));
 
-        // Set verbal depart instruction
-        maneuver.set_verbal_depart_instruction(FormVerbalDepartInstruction(maneuver));
-
         // Set instruction
         maneuver.set_instruction(FormTransitRemainOnInstruction(maneuver));
 
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            FormVerbalTransitRemainOnInstruction(maneuver));
-
-        // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            FormVerbalPostTransitionTransitInstruction(maneuver));
-
         // Set arrive instruction
         maneuver.set_arrive_instruction(FormArriveInstruction(maneuver));
-
-        // Set verbal arrive instruction
-        maneuver.set_verbal_arrive_instruction(FormVerbalArriveInstruction(maneuver));
-
         break;
       }
       case DirectionsLeg_Maneuver_Type_kTransitTransfer: {
         // Set depart instruction
         maneuver.set_depart_instruction(FormDepartInstruction(maneuver));
 
-        // Set verbal depart instruction
-        maneuver.set_verbal_depart_instruction(FormVerbalDepartInstruction(maneuver));
-
         // Set instruction
         maneuver.set_instruction(FormTransitTransferInstruction(maneuver));
 
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            FormVerbalTransitTransferInstruction(maneuver));
-
-        // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            FormVerbalPostTransitionTransitInstruction(maneuver));
-
         // Set arrive instruction
         maneuver.set_arrive_instruction(FormArriveInstruction(maneuver));
-
-        // Set verbal arrive instruction
-        maneuver.set_verbal_arrive_instruction(FormVerbalArriveInstruction(maneuver));
         break;
       }
       case DirectionsLeg_Maneuver_Type_kElevatorEnter: {
         // Set instruction
-        auto instr = FormElevatorInstruction(maneuver);
-        maneuver.set_instruction(instr);
-
-        if (maneuver.has_node_type() && maneuver.node_type() == TripLeg_Node_Type_kElevator) {
-          maneuver.set_verbal_transition_alert_instruction(instr);
-
-          // Set verbal pre transition instruction
-          maneuver.set_verbal_pre_transition_instruction(instr);
-
-          // Set verbal post transition instruction
-          maneuver.set_verbal_post_transition_instruction(
-              FormVerbalPostTransitionInstruction(maneuver));
-        }
+        maneuver.set_instruction(FormElevatorInstruction(maneuver));
         break;
       }
       case DirectionsLeg_Maneuver_Type_kStepsEnter: {
@@ -503,29 +228,21 @@ void NarrativeBuilder::Build(std::list<Maneuver>& maneuvers) {
       case DirectionsLeg_Maneuver_Type_kContinue:
       default: {
         if (maneuver.has_node_type()) {
-          std::string instr = FormPassInstruction(maneuver);
           // Set instruction
-          maneuver.set_instruction(instr);
-          // Set verbal pre transition instruction
-          maneuver.set_verbal_pre_transition_instruction(instr);
+          maneuver.set_instruction(FormPassInstruction(maneuver));
         } else {
           // Set instruction
           maneuver.set_instruction(FormContinueInstruction(maneuver));
-
-          // Set verbal transition alert instruction
-          maneuver.set_verbal_transition_alert_instruction(
-              FormVerbalAlertContinueInstruction(maneuver));
-
-          // Set verbal pre transition instruction
-          maneuver.set_verbal_pre_transition_instruction(FormVerbalContinueInstruction(maneuver));
-
-          // Set verbal post transition instruction
-          maneuver.set_verbal_post_transition_instruction(
-              FormVerbalPostTransitionInstruction(maneuver));
         }
         break;
       }
     }
+
+    // Set the verbal instructions if they were requested
+    if (verbal_instructions) {
+      FormVerbalInstructions(maneuver, prev_maneuver);
+    }
+
     maneuver.set_instruction(FormBssManeuverType(maneuver.bss_maneuver_type()) +
                              maneuver.instruction());
 
@@ -534,7 +251,368 @@ void NarrativeBuilder::Build(std::list<Maneuver>& maneuvers) {
   }
 
   // Iterate over maneuvers to form verbal multi-cue instructions
-  FormVerbalMultiCue(maneuvers);
+  if (verbal_instructions) {
+    FormVerbalMultiCue(maneuvers);
+  }
+}
+
+void NarrativeBuilder::FormVerbalInstructions(Maneuver& maneuver, Maneuver* prev_maneuver) {
+  switch (maneuver.type()) {
+    case DirectionsLeg_Maneuver_Type_kStartRight:
+    case DirectionsLeg_Maneuver_Type_kStart:
+    case DirectionsLeg_Maneuver_Type_kStartLeft:
+    case DirectionsLeg_Maneuver_Type_kFerryExit:
+    case DirectionsLeg_Maneuver_Type_kPostTransitConnectionDestination: {
+      // Set verbal succinct transition instruction
+      maneuver.set_verbal_succinct_transition_instruction(
+          FormVerbalSuccinctStartTransitionInstruction(maneuver));
+
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(FormVerbalStartInstruction(maneuver));
+
+      // Set verbal post transition instruction
+      maneuver.set_verbal_post_transition_instruction(
+          FormVerbalPostTransitionInstruction(maneuver, maneuver.HasBeginStreetNames()));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kDestinationRight:
+    case DirectionsLeg_Maneuver_Type_kDestination:
+    case DirectionsLeg_Maneuver_Type_kDestinationLeft: {
+      // Set verbal transition alert instruction
+      maneuver.set_verbal_transition_alert_instruction(
+          FormVerbalAlertDestinationInstruction(maneuver));
+
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(FormVerbalDestinationInstruction(maneuver));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kBecomes: {
+      if (prev_maneuver) {
+        // Set verbal pre transition instruction
+        maneuver.set_verbal_pre_transition_instruction(
+            FormVerbalBecomesInstruction(maneuver, prev_maneuver));
+      }
+
+      // Set verbal post transition instruction
+      maneuver.set_verbal_post_transition_instruction(
+          FormVerbalPostTransitionInstruction(maneuver, maneuver.HasBeginStreetNames()));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kSlightRight:
+    case DirectionsLeg_Maneuver_Type_kSlightLeft:
+    case DirectionsLeg_Maneuver_Type_kRight:
+    case DirectionsLeg_Maneuver_Type_kSharpRight:
+    case DirectionsLeg_Maneuver_Type_kSharpLeft:
+    case DirectionsLeg_Maneuver_Type_kLeft: {
+      // Set verbal succinct transition instruction
+      maneuver.set_verbal_succinct_transition_instruction(
+          FormVerbalSuccinctTurnTransitionInstruction(maneuver));
+
+      // Set verbal transition alert instruction
+      maneuver.set_verbal_transition_alert_instruction(FormVerbalAlertTurnInstruction(maneuver));
+
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(FormVerbalTurnInstruction(maneuver));
+
+      // Set verbal post transition instruction
+      maneuver.set_verbal_post_transition_instruction(
+          FormVerbalPostTransitionInstruction(maneuver, maneuver.HasBeginStreetNames()));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kUturnRight:
+    case DirectionsLeg_Maneuver_Type_kUturnLeft: {
+      // Set verbal succinct transition instruction
+      maneuver.set_verbal_succinct_transition_instruction(
+          FormVerbalSuccinctUturnTransitionInstruction(maneuver));
+
+      // Set verbal transition alert instruction
+      maneuver.set_verbal_transition_alert_instruction(FormVerbalAlertUturnInstruction(maneuver));
+
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(FormVerbalUturnInstruction(maneuver));
+
+      // Set verbal post transition instruction
+      maneuver.set_verbal_post_transition_instruction(
+          FormVerbalPostTransitionInstruction(maneuver));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kRampStraight: {
+      // Set verbal transition alert instruction
+      maneuver.set_verbal_transition_alert_instruction(
+          FormVerbalAlertRampStraightInstruction(maneuver));
+
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(FormVerbalRampStraightInstruction(maneuver));
+
+      // Only set verbal post if > min ramp length
+      // or contains obvious maneuver
+      // or has collapsed merge maneuver
+      if ((maneuver.length() > kVerbalPostMinimumRampLength) ||
+          maneuver.contains_obvious_maneuver() || maneuver.has_collapsed_merge_maneuver()) {
+        // Set verbal post transition instruction
+        maneuver.set_verbal_post_transition_instruction(
+            FormVerbalPostTransitionInstruction(maneuver));
+      }
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kRampRight:
+    case DirectionsLeg_Maneuver_Type_kRampLeft: {
+      // Set verbal transition alert instruction
+      maneuver.set_verbal_transition_alert_instruction(FormVerbalAlertRampInstruction(maneuver));
+
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(FormVerbalRampInstruction(maneuver));
+
+      // Only set verbal post if > min ramp length
+      // or contains obvious maneuver
+      // or has collapsed merge maneuver
+      if ((maneuver.length() > kVerbalPostMinimumRampLength) ||
+          maneuver.contains_obvious_maneuver() || maneuver.has_collapsed_merge_maneuver()) {
+        // Set verbal post transition instruction
+        maneuver.set_verbal_post_transition_instruction(
+            FormVerbalPostTransitionInstruction(maneuver));
+      }
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kExitRight:
+    case DirectionsLeg_Maneuver_Type_kExitLeft: {
+      // Set verbal transition alert instruction
+      maneuver.set_verbal_transition_alert_instruction(FormVerbalAlertExitInstruction(maneuver));
+
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(FormVerbalExitInstruction(maneuver));
+
+      // Only set verbal post if > min ramp length
+      // or contains obvious maneuver
+      // or has collapsed merge maneuver
+      if ((maneuver.length() > kVerbalPostMinimumRampLength) ||
+          maneuver.contains_obvious_maneuver() || maneuver.has_collapsed_merge_maneuver()) {
+        // Set verbal post transition instruction
+        maneuver.set_verbal_post_transition_instruction(
+            FormVerbalPostTransitionInstruction(maneuver));
+      }
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kStayStraight:
+    case DirectionsLeg_Maneuver_Type_kStayRight:
+    case DirectionsLeg_Maneuver_Type_kStayLeft: {
+      if (maneuver.to_stay_on()) {
+        // Set verbal transition alert instruction
+        maneuver.set_verbal_transition_alert_instruction(
+            FormVerbalAlertKeepToStayOnInstruction(maneuver));
+
+        // Set verbal pre transition instruction
+        maneuver.set_verbal_pre_transition_instruction(FormVerbalKeepToStayOnInstruction(maneuver));
+      } else {
+        // Set verbal transition alert instruction
+        maneuver.set_verbal_transition_alert_instruction(FormVerbalAlertKeepInstruction(maneuver));
+
+        // Set verbal pre transition instruction
+        maneuver.set_verbal_pre_transition_instruction(FormVerbalKeepInstruction(maneuver));
+      }
+
+      // For a ramp - only set verbal post if > min ramp length
+      if (maneuver.ramp() && !maneuver.has_collapsed_merge_maneuver()) {
+        if (maneuver.length() > kVerbalPostMinimumRampLength) {
+          // Set verbal post transition instruction
+          maneuver.set_verbal_post_transition_instruction(
+              FormVerbalPostTransitionInstruction(maneuver));
+        }
+      } else {
+        // Set verbal post transition instruction
+        maneuver.set_verbal_post_transition_instruction(
+            FormVerbalPostTransitionInstruction(maneuver));
+      }
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kMerge:
+    case DirectionsLeg_Maneuver_Type_kMergeRight:
+    case DirectionsLeg_Maneuver_Type_kMergeLeft: {
+      // Set verbal succinct transition instruction
+      maneuver.set_verbal_succinct_transition_instruction(
+          FormVerbalSuccinctMergeTransitionInstruction(maneuver));
+
+      // Set verbal transition alert instruction if previous maneuver
+      // is greater than 2 km
+      if (prev_maneuver && (prev_maneuver->length(Options::kilometers) >
+                            kVerbalAlertMergePriorManeuverMinimumLength)) {
+        maneuver.set_verbal_transition_alert_instruction(FormVerbalAlertMergeInstruction(maneuver));
+      }
+
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(FormVerbalMergeInstruction(maneuver));
+
+      // Set verbal post transition instruction
+      maneuver.set_verbal_post_transition_instruction(
+          FormVerbalPostTransitionInstruction(maneuver));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kRoundaboutEnter: {
+      // Set verbal succinct transition instruction
+      maneuver.set_verbal_succinct_transition_instruction(
+          FormVerbalSuccinctEnterRoundaboutTransitionInstruction(maneuver));
+
+      // Set verbal transition alert instruction
+      maneuver.set_verbal_transition_alert_instruction(
+          FormVerbalAlertEnterRoundaboutInstruction(maneuver));
+
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(
+          FormVerbalEnterRoundaboutInstruction(maneuver));
+
+      // If the maneuver has a combined enter exit roundabout instruction
+      // then set verbal post transition instruction
+      if (maneuver.has_combined_enter_exit_roundabout()) {
+        maneuver.set_verbal_post_transition_instruction(
+            FormVerbalPostTransitionInstruction(maneuver,
+                                                maneuver.HasRoundaboutExitBeginStreetNames()));
+      }
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kRoundaboutExit: {
+      // Set verbal succinct transition instruction
+      maneuver.set_verbal_succinct_transition_instruction(
+          FormVerbalSuccinctExitRoundaboutTransitionInstruction(maneuver));
+
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(FormVerbalExitRoundaboutInstruction(maneuver));
+
+      // Set verbal post transition instruction
+      maneuver.set_verbal_post_transition_instruction(
+          FormVerbalPostTransitionInstruction(maneuver, maneuver.HasBeginStreetNames()));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kFerryEnter: {
+      // Set verbal transition alert instruction
+      maneuver.set_verbal_transition_alert_instruction(
+          FormVerbalAlertEnterFerryInstruction(maneuver));
+
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(FormVerbalEnterFerryInstruction(maneuver));
+
+      // Set verbal post transition instruction
+      maneuver.set_verbal_post_transition_instruction(
+          FormVerbalPostTransitionInstruction(maneuver));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kTransitConnectionStart: {
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(
+          FormVerbalTransitConnectionStartInstruction(maneuver));
+
+      // Set verbal post transition instruction
+      maneuver.set_verbal_post_transition_instruction(
+          FormVerbalPostTransitionInstruction(maneuver));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kTransitConnectionTransfer: {
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(
+          FormVerbalTransitConnectionTransferInstruction(maneuver));
+
+      // Set verbal post transition instruction
+      maneuver.set_verbal_post_transition_instruction(
+          FormVerbalPostTransitionInstruction(maneuver));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kTransitConnectionDestination: {
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(
+          FormVerbalTransitConnectionDestinationInstruction(maneuver));
+
+      // Set verbal post transition instruction
+      maneuver.set_verbal_post_transition_instruction(
+          FormVerbalPostTransitionInstruction(maneuver));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kTransit: {
+      // Set verbal depart instruction
+      maneuver.set_verbal_depart_instruction(FormVerbalDepartInstruction(maneuver));
+
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(FormVerbalTransitInstruction(maneuver));
+
+      // Set verbal post transition instruction
+      maneuver.set_verbal_post_transition_instruction(
+          FormVerbalPostTransitionTransitInstruction(maneuver));
+
+      // Set verbal arrive instruction
+      maneuver.set_verbal_arrive_instruction(FormVerbalArriveInstruction(maneuver));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kTransitRemainOn: {
+      // Set verbal depart instruction
+      maneuver.set_verbal_depart_instruction(FormVerbalDepartInstruction(maneuver));
+
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(
+          FormVerbalTransitRemainOnInstruction(maneuver));
+
+      // Set verbal post transition instruction
+      maneuver.set_verbal_post_transition_instruction(
+          FormVerbalPostTransitionTransitInstruction(maneuver));
+
+      // Set verbal arrive instruction
+      maneuver.set_verbal_arrive_instruction(FormVerbalArriveInstruction(maneuver));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kTransitTransfer: {
+      // Set verbal depart instruction
+      maneuver.set_verbal_depart_instruction(FormVerbalDepartInstruction(maneuver));
+
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(
+          FormVerbalTransitTransferInstruction(maneuver));
+
+      // Set verbal post transition instruction
+      maneuver.set_verbal_post_transition_instruction(
+          FormVerbalPostTransitionTransitInstruction(maneuver));
+
+      // Set verbal arrive instruction
+      maneuver.set_verbal_arrive_instruction(FormVerbalArriveInstruction(maneuver));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kElevatorEnter: {
+      if (maneuver.has_node_type() && maneuver.node_type() == TripLeg_Node_Type_kElevator) {
+        // The elevator instruction is spoken as is
+        maneuver.set_verbal_transition_alert_instruction(maneuver.instruction());
+
+        // Set verbal pre transition instruction
+        maneuver.set_verbal_pre_transition_instruction(maneuver.instruction());
+
+        // Set verbal post transition instruction
+        maneuver.set_verbal_post_transition_instruction(
+            FormVerbalPostTransitionInstruction(maneuver));
+      }
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kStepsEnter:
+    case DirectionsLeg_Maneuver_Type_kEscalatorEnter:
+    case DirectionsLeg_Maneuver_Type_kBuildingEnter:
+    case DirectionsLeg_Maneuver_Type_kBuildingExit: {
+      // No verbal instructions for these
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kContinue:
+    default: {
+      if (maneuver.has_node_type()) {
+        // The pass instruction is spoken as is
+        maneuver.set_verbal_pre_transition_instruction(maneuver.instruction());
+      } else {
+        // Set verbal transition alert instruction
+        maneuver.set_verbal_transition_alert_instruction(
+            FormVerbalAlertContinueInstruction(maneuver));
+
+        // Set verbal pre transition instruction
+        maneuver.set_verbal_pre_transition_instruction(FormVerbalContinueInstruction(maneuver));
+
+        // Set verbal post transition instruction
+        maneuver.set_verbal_post_transition_instruction(
+            FormVerbalPostTransitionInstruction(maneuver));
+      }
+      break;
+    }
+  }
 }
 
 std::string NarrativeBuilder::FormVerbalAlertApproachInstruction(float distance,
@@ -543,14 +621,13 @@ std::string NarrativeBuilder::FormVerbalAlertApproachInstruction(float distance,
   instruction.reserve(kInstructionInitialCapacity);
   uint8_t phrase_id = 0;
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.approach_verbal_alert_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kLengthTag,
-                     FormLength(distance, dictionary_.approach_verbal_alert_subset.metric_lengths,
-                                dictionary_.approach_verbal_alert_subset.us_customary_lengths));
-  boost::replace_all(instruction, kCurrentVerbalCueTag, verbal_cue);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  std::string length =
+      FormLength(distance, dictionary_.approach_verbal_alert_subset.metric_lengths,
+                 dictionary_.approach_verbal_alert_subset.us_customary_lengths);
+  const auto& phrase = dictionary_.approach_verbal_alert_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kLength, length},
+                              {PhraseTag::kCurrentVerbalCue, verbal_cue}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -608,13 +685,11 @@ std::string NarrativeBuilder::FormStartInstruction(Maneuver& maneuver) {
     phrase_id += 16;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.start_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kCardinalDirectionTag, cardinal_direction);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.start_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kCardinalDirection, cardinal_direction},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kBeginStreetNames, begin_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -695,16 +770,15 @@ std::string NarrativeBuilder::FormVerbalStartInstruction(Maneuver& maneuver,
     phrase_id += 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.start_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kCardinalDirectionTag, cardinal_direction);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
-  boost::replace_all(instruction, kLengthTag,
-                     FormLength(maneuver, dictionary_.start_verbal_subset.metric_lengths,
-                                dictionary_.start_verbal_subset.us_customary_lengths));
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  std::string length =
+      FormLength(maneuver, dictionary_.start_verbal_subset.metric_lengths,
+                 dictionary_.start_verbal_subset.us_customary_lengths);
+  const auto& phrase = dictionary_.start_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kCardinalDirection, cardinal_direction},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kBeginStreetNames, begin_street_names},
+                              {PhraseTag::kLength, length}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -748,14 +822,10 @@ std::string NarrativeBuilder::FormDestinationInstruction(Maneuver& maneuver) {
     relative_direction = dictionary_.destination_subset.relative_directions.at(1);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.destination_subset.phrases.at(std::to_string(phrase_id));
-
-  if (phrase_id > 0) {
-    // Replace phrase tags with values
-    boost::replace_all(instruction, kRelativeDirectionTag, relative_direction);
-    boost::replace_all(instruction, kDestinationTag, destination);
-  }
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.destination_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kDestination, destination}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -804,14 +874,10 @@ std::string NarrativeBuilder::FormVerbalAlertDestinationInstruction(Maneuver& ma
     relative_direction = dictionary_.destination_subset.relative_directions.at(1);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.destination_verbal_alert_subset.phrases.at(std::to_string(phrase_id));
-
-  if (phrase_id > 0) {
-    // Replace phrase tags with values
-    boost::replace_all(instruction, kRelativeDirectionTag, relative_direction);
-    boost::replace_all(instruction, kDestinationTag, destination);
-  }
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.destination_verbal_alert_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kDestination, destination}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -860,14 +926,10 @@ std::string NarrativeBuilder::FormVerbalDestinationInstruction(Maneuver& maneuve
     relative_direction = dictionary_.destination_subset.relative_directions.at(1);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.destination_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  if (phrase_id > 0) {
-    // Replace phrase tags with values
-    boost::replace_all(instruction, kRelativeDirectionTag, relative_direction);
-    boost::replace_all(instruction, kDestinationTag, destination);
-  }
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.destination_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kDestination, destination}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -890,12 +952,10 @@ std::string NarrativeBuilder::FormBecomesInstruction(Maneuver& maneuver, Maneuve
   // Determine which phrase to use
   uint8_t phrase_id = 0;
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.becomes_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kPreviousStreetNamesTag, prev_street_names);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.becomes_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kPreviousStreetNames, prev_street_names},
+                              {PhraseTag::kStreetNames, street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -925,12 +985,10 @@ std::string NarrativeBuilder::FormVerbalBecomesInstruction(Maneuver& maneuver,
   // Determine which phrase to use
   uint8_t phrase_id = 0;
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.becomes_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kPreviousStreetNamesTag, prev_street_names);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.becomes_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kPreviousStreetNames, prev_street_names},
+                              {PhraseTag::kStreetNames, street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -976,13 +1034,11 @@ std::string NarrativeBuilder::FormContinueInstruction(Maneuver& maneuver,
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.continue_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kJunctionNameTag, junction_name);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.continue_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kJunctionName, junction_name},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1032,13 +1088,11 @@ std::string NarrativeBuilder::FormVerbalAlertContinueInstruction(Maneuver& maneu
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.continue_verbal_alert_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kJunctionNameTag, junction_name);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.continue_verbal_alert_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kJunctionName, junction_name},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1097,16 +1151,15 @@ std::string NarrativeBuilder::FormVerbalContinueInstruction(Maneuver& maneuver,
     phrase_id += 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.continue_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kLengthTag,
-                     FormLength(maneuver, dictionary_.continue_verbal_subset.metric_lengths,
-                                dictionary_.continue_verbal_subset.us_customary_lengths));
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kJunctionNameTag, junction_name);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  std::string length =
+      FormLength(maneuver, dictionary_.continue_verbal_subset.metric_lengths,
+                 dictionary_.continue_verbal_subset.us_customary_lengths);
+  const auto& phrase = dictionary_.continue_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kLength, length},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kJunctionName, junction_name},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1182,16 +1235,15 @@ std::string NarrativeBuilder::FormTurnInstruction(Maneuver& maneuver,
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = subset->phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-                     FormRelativeTwoDirection(maneuver.type(), subset->relative_directions));
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
-  boost::replace_all(instruction, kJunctionNameTag, junction_name);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  std::string relative_direction =
+      FormRelativeTwoDirection(maneuver.type(), subset->relative_directions);
+  const auto& phrase = subset->GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kBeginStreetNames, begin_street_names},
+                              {PhraseTag::kJunctionName, junction_name},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1290,16 +1342,15 @@ std::string NarrativeBuilder::FormVerbalTurnInstruction(Maneuver& maneuver,
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = subset->phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-                     FormRelativeTwoDirection(maneuver.type(), subset->relative_directions));
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
-  boost::replace_all(instruction, kJunctionNameTag, junction_name);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  std::string relative_direction =
+      FormRelativeTwoDirection(maneuver.type(), subset->relative_directions);
+  const auto& phrase = subset->GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kBeginStreetNames, begin_street_names},
+                              {PhraseTag::kJunctionName, junction_name},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1360,17 +1411,15 @@ std::string NarrativeBuilder::FormUturnInstruction(Maneuver& maneuver,
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.uturn_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-                     FormRelativeTwoDirection(maneuver.type(),
-                                              dictionary_.uturn_subset.relative_directions));
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kCrossStreetNamesTag, cross_street_names);
-  boost::replace_all(instruction, kJunctionNameTag, junction_name);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  std::string relative_direction =
+      FormRelativeTwoDirection(maneuver.type(), dictionary_.uturn_subset.relative_directions);
+  const auto& phrase = dictionary_.uturn_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kCrossStreetNames, cross_street_names},
+                              {PhraseTag::kJunctionName, junction_name},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1515,15 +1564,13 @@ std::string NarrativeBuilder::FormVerbalUturnInstruction(uint8_t phrase_id,
   std::string instruction;
   instruction.reserve(kInstructionInitialCapacity);
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.uturn_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_dir);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kCrossStreetNamesTag, cross_street_names);
-  boost::replace_all(instruction, kJunctionNameTag, junction_name);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.uturn_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kRelativeDirection, relative_dir},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kCrossStreetNames, cross_street_names},
+                              {PhraseTag::kJunctionName, junction_name},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1569,13 +1616,11 @@ std::string NarrativeBuilder::FormRampStraightInstruction(Maneuver& maneuver,
         maneuver.signs().GetExitNameString(element_max_count, limit_by_consecutive_count);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.ramp_straight_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kBranchSignTag, exit_branch_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
-  boost::replace_all(instruction, kNameSignTag, exit_name_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.ramp_straight_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kBranchSign, exit_branch_sign},
+                              {PhraseTag::kTowardSign, exit_toward_sign},
+                              {PhraseTag::kNameSign, exit_name_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1674,13 +1719,11 @@ std::string NarrativeBuilder::FormVerbalRampStraightInstruction(uint8_t phrase_i
   std::string instruction;
   instruction.reserve(kInstructionInitialCapacity);
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.ramp_straight_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kBranchSignTag, exit_branch_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
-  boost::replace_all(instruction, kNameSignTag, exit_name_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.ramp_straight_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kBranchSign, exit_branch_sign},
+                              {PhraseTag::kTowardSign, exit_toward_sign},
+                              {PhraseTag::kNameSign, exit_name_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1748,16 +1791,14 @@ std::string NarrativeBuilder::FormRampInstruction(Maneuver& maneuver,
         maneuver.signs().GetExitNameString(element_max_count, limit_by_consecutive_count);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.ramp_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-                     FormRelativeTwoDirection(maneuver.type(),
-                                              dictionary_.ramp_subset.relative_directions));
-  boost::replace_all(instruction, kBranchSignTag, exit_branch_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
-  boost::replace_all(instruction, kNameSignTag, exit_name_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  std::string relative_direction =
+      FormRelativeTwoDirection(maneuver.type(), dictionary_.ramp_subset.relative_directions);
+  const auto& phrase = dictionary_.ramp_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kBranchSign, exit_branch_sign},
+                              {PhraseTag::kTowardSign, exit_toward_sign},
+                              {PhraseTag::kNameSign, exit_name_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1908,14 +1949,12 @@ std::string NarrativeBuilder::FormVerbalRampInstruction(uint8_t phrase_id,
   std::string instruction;
   instruction.reserve(kInstructionInitialCapacity);
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.ramp_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_dir);
-  boost::replace_all(instruction, kBranchSignTag, exit_branch_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
-  boost::replace_all(instruction, kNameSignTag, exit_name_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.ramp_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kRelativeDirection, relative_dir},
+                              {PhraseTag::kBranchSign, exit_branch_sign},
+                              {PhraseTag::kTowardSign, exit_toward_sign},
+                              {PhraseTag::kNameSign, exit_name_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1993,17 +2032,15 @@ std::string NarrativeBuilder::FormExitInstruction(Maneuver& maneuver,
         maneuver.signs().GetExitNameString(element_max_count, limit_by_consecutive_count);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.exit_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-                     FormRelativeTwoDirection(maneuver.type(),
-                                              dictionary_.exit_subset.relative_directions));
-  boost::replace_all(instruction, kNumberSignTag, exit_number_sign);
-  boost::replace_all(instruction, kBranchSignTag, exit_branch_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
-  boost::replace_all(instruction, kNameSignTag, exit_name_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  std::string relative_direction =
+      FormRelativeTwoDirection(maneuver.type(), dictionary_.exit_subset.relative_directions);
+  const auto& phrase = dictionary_.exit_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kNumberSign, exit_number_sign},
+                              {PhraseTag::kBranchSign, exit_branch_sign},
+                              {PhraseTag::kTowardSign, exit_toward_sign},
+                              {PhraseTag::kNameSign, exit_name_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2164,15 +2201,13 @@ std::string NarrativeBuilder::FormVerbalExitInstruction(uint8_t phrase_id,
   std::string instruction;
   instruction.reserve(kInstructionInitialCapacity);
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.exit_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_dir);
-  boost::replace_all(instruction, kNumberSignTag, exit_number_sign);
-  boost::replace_all(instruction, kBranchSignTag, exit_branch_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
-  boost::replace_all(instruction, kNameSignTag, exit_name_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.exit_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kRelativeDirection, relative_dir},
+                              {PhraseTag::kNumberSign, exit_number_sign},
+                              {PhraseTag::kBranchSign, exit_branch_sign},
+                              {PhraseTag::kTowardSign, exit_toward_sign},
+                              {PhraseTag::kNameSign, exit_name_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2253,16 +2288,14 @@ std::string NarrativeBuilder::FormKeepInstruction(Maneuver& maneuver,
     phrase_id += 4;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.keep_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-                     FormRelativeThreeDirection(maneuver.type(),
-                                                dictionary_.keep_subset.relative_directions));
-  boost::replace_all(instruction, kNumberSignTag, exit_number_sign);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kTowardSignTag, toward_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  std::string relative_direction =
+      FormRelativeThreeDirection(maneuver.type(), dictionary_.keep_subset.relative_directions);
+  const auto& phrase = dictionary_.keep_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kNumberSign, exit_number_sign},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kTowardSign, toward_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2444,14 +2477,12 @@ std::string NarrativeBuilder::FormVerbalKeepInstruction(uint8_t phrase_id,
   std::string instruction;
   instruction.reserve(kInstructionInitialCapacity);
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.keep_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_dir);
-  boost::replace_all(instruction, kNumberSignTag, exit_number_sign);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kTowardSignTag, toward_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.keep_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kRelativeDirection, relative_dir},
+                              {PhraseTag::kNumberSign, exit_number_sign},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kTowardSign, toward_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2503,16 +2534,15 @@ std::string NarrativeBuilder::FormKeepToStayOnInstruction(Maneuver& maneuver,
     phrase_id += 2;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.keep_to_stay_on_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-                     FormRelativeThreeDirection(maneuver.type(), dictionary_.keep_to_stay_on_subset
-                                                                     .relative_directions));
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kNumberSignTag, exit_number_sign);
-  boost::replace_all(instruction, kTowardSignTag, toward_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  std::string relative_direction =
+      FormRelativeThreeDirection(maneuver.type(),
+                                 dictionary_.keep_to_stay_on_subset.relative_directions);
+  const auto& phrase = dictionary_.keep_to_stay_on_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kNumberSign, exit_number_sign},
+                              {PhraseTag::kTowardSign, toward_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2602,14 +2632,12 @@ std::string NarrativeBuilder::FormVerbalKeepToStayOnInstruction(uint8_t phrase_i
   std::string instruction;
   instruction.reserve(kInstructionInitialCapacity);
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.keep_to_stay_on_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_dir);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kNumberSignTag, exit_number_sign);
-  boost::replace_all(instruction, kTowardSignTag, toward_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.keep_to_stay_on_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kRelativeDirection, relative_dir},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kNumberSign, exit_number_sign},
+                              {PhraseTag::kTowardSign, toward_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2660,13 +2688,11 @@ std::string NarrativeBuilder::FormMergeInstruction(Maneuver& maneuver,
         FormRelativeTwoDirection(maneuver.type(), dictionary_.merge_subset.relative_directions);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.merge_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_direction);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.merge_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2735,13 +2761,11 @@ std::string NarrativeBuilder::FormVerbalMergeInstruction(Maneuver& maneuver,
                                  dictionary_.merge_verbal_subset.relative_directions);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.merge_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_direction);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.merge_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2858,16 +2882,14 @@ std::string NarrativeBuilder::FormEnterRoundaboutInstruction(Maneuver& maneuver,
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.enter_roundabout_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kOrdinalValueTag, ordinal_value);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
-  boost::replace_all(instruction, kRoundaboutExitStreetNamesTag, roundabout_exit_street_names);
-  boost::replace_all(instruction, kRoundaboutExitBeginStreetNamesTag,
-                     roundabout_exit_begin_street_names);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.enter_roundabout_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kOrdinalValue, ordinal_value},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kTowardSign, guide_sign},
+                              {PhraseTag::kRoundaboutExitStreetNames, roundabout_exit_street_names},
+                              {PhraseTag::kRoundaboutExitBeginStreetNames,
+                               roundabout_exit_begin_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3010,16 +3032,14 @@ std::string NarrativeBuilder::FormVerbalEnterRoundaboutInstruction(Maneuver& man
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.enter_roundabout_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kOrdinalValueTag, ordinal_value);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
-  boost::replace_all(instruction, kRoundaboutExitStreetNamesTag, roundabout_exit_street_names);
-  boost::replace_all(instruction, kRoundaboutExitBeginStreetNamesTag,
-                     roundabout_exit_begin_street_names);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.enter_roundabout_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kOrdinalValue, ordinal_value},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kTowardSign, guide_sign},
+                              {PhraseTag::kRoundaboutExitStreetNames, roundabout_exit_street_names},
+                              {PhraseTag::kRoundaboutExitBeginStreetNames,
+                               roundabout_exit_begin_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3073,13 +3093,11 @@ std::string NarrativeBuilder::FormExitRoundaboutInstruction(Maneuver& maneuver,
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.exit_roundabout_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.exit_roundabout_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kBeginStreetNames, begin_street_names},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3137,13 +3155,11 @@ std::string NarrativeBuilder::FormVerbalExitRoundaboutInstruction(Maneuver& mane
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.exit_roundabout_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.exit_roundabout_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kBeginStreetNames, begin_street_names},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3187,13 +3203,11 @@ std::string NarrativeBuilder::FormEnterFerryInstruction(Maneuver& maneuver,
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.enter_ferry_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kFerryLabelTag, ferry_label);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.enter_ferry_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kFerryLabel, ferry_label},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3254,13 +3268,11 @@ std::string NarrativeBuilder::FormVerbalEnterFerryInstruction(Maneuver& maneuver
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.enter_ferry_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kFerryLabelTag, ferry_label);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.enter_ferry_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kFerryLabel, ferry_label},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3293,12 +3305,10 @@ std::string NarrativeBuilder::FormTransitConnectionStartInstruction(Maneuver& ma
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_connection_start_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop);
-  boost::replace_all(instruction, kStationLabelTag, station_label);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.transit_connection_start_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kTransitPlatform, transit_stop},
+                              {PhraseTag::kStationLabel, station_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3331,13 +3341,10 @@ std::string NarrativeBuilder::FormVerbalTransitConnectionStartInstruction(Maneuv
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction =
-      dictionary_.transit_connection_start_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop);
-  boost::replace_all(instruction, kStationLabelTag, station_label);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.transit_connection_start_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kTransitPlatform, transit_stop},
+                              {PhraseTag::kStationLabel, station_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3370,12 +3377,10 @@ std::string NarrativeBuilder::FormTransitConnectionTransferInstruction(Maneuver&
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_connection_transfer_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop);
-  boost::replace_all(instruction, kStationLabelTag, station_label);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.transit_connection_transfer_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kTransitPlatform, transit_stop},
+                              {PhraseTag::kStationLabel, station_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3408,13 +3413,10 @@ std::string NarrativeBuilder::FormVerbalTransitConnectionTransferInstruction(Man
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction =
-      dictionary_.transit_connection_transfer_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop);
-  boost::replace_all(instruction, kStationLabelTag, station_label);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.transit_connection_transfer_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kTransitPlatform, transit_stop},
+                              {PhraseTag::kStationLabel, station_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3447,13 +3449,10 @@ std::string NarrativeBuilder::FormTransitConnectionDestinationInstruction(Maneuv
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction =
-      dictionary_.transit_connection_destination_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop);
-  boost::replace_all(instruction, kStationLabelTag, station_label);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.transit_connection_destination_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kTransitPlatform, transit_stop},
+                              {PhraseTag::kStationLabel, station_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3486,13 +3485,11 @@ std::string NarrativeBuilder::FormVerbalTransitConnectionDestinationInstruction(
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction =
-      dictionary_.transit_connection_destination_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop);
-  boost::replace_all(instruction, kStationLabelTag, station_label);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase =
+      dictionary_.transit_connection_destination_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kTransitPlatform, transit_stop},
+                              {PhraseTag::kStationLabel, station_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3515,13 +3512,11 @@ std::string NarrativeBuilder::FormDepartInstruction(Maneuver& maneuver) {
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.depart_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop_name);
-  boost::replace_all(instruction, kTimeTag,
-                     get_localized_time(maneuver.GetTransitDepartureTime(), dictionary_.GetLocale()));
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  std::string time = get_localized_time(maneuver.GetTransitDepartureTime(), dictionary_.GetLocale());
+  const auto& phrase = dictionary_.depart_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kTransitPlatform, transit_stop_name},
+                              {PhraseTag::kTime, time}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3544,13 +3539,11 @@ std::string NarrativeBuilder::FormVerbalDepartInstruction(Maneuver& maneuver) {
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.depart_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop_name);
-  boost::replace_all(instruction, kTimeTag,
-                     get_localized_time(maneuver.GetTransitDepartureTime(), dictionary_.GetLocale()));
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  std::string time = get_localized_time(maneuver.GetTransitDepartureTime(), dictionary_.GetLocale());
+  const auto& phrase = dictionary_.depart_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kTransitPlatform, transit_stop_name},
+                              {PhraseTag::kTime, time}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3573,13 +3566,11 @@ std::string NarrativeBuilder::FormArriveInstruction(Maneuver& maneuver) {
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.arrive_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop_name);
-  boost::replace_all(instruction, kTimeTag,
-                     get_localized_time(maneuver.GetTransitArrivalTime(), dictionary_.GetLocale()));
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  std::string time = get_localized_time(maneuver.GetTransitArrivalTime(), dictionary_.GetLocale());
+  const auto& phrase = dictionary_.arrive_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kTransitPlatform, transit_stop_name},
+                              {PhraseTag::kTime, time}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3602,13 +3593,11 @@ std::string NarrativeBuilder::FormVerbalArriveInstruction(Maneuver& maneuver) {
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.arrive_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop_name);
-  boost::replace_all(instruction, kTimeTag,
-                     get_localized_time(maneuver.GetTransitArrivalTime(), dictionary_.GetLocale()));
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  std::string time = get_localized_time(maneuver.GetTransitArrivalTime(), dictionary_.GetLocale());
+  const auto& phrase = dictionary_.arrive_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kTransitPlatform, transit_stop_name},
+                              {PhraseTag::kTime, time}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3635,16 +3624,15 @@ std::string NarrativeBuilder::FormTransitInstruction(Maneuver& maneuver) {
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitNameTag,
-                     FormTransitName(maneuver, dictionary_.transit_subset.empty_transit_name_labels));
-  boost::replace_all(instruction, kTransitHeadSignTag, transit_headsign);
-  boost::replace_all(instruction, kTransitPlatformCountTag,
-                     std::to_string(stop_count)); // TODO: locale specific numerals
-  boost::replace_all(instruction, kTransitPlatformCountLabelTag, stop_count_label);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  std::string transit_name =
+      FormTransitName(maneuver, dictionary_.transit_subset.empty_transit_name_labels);
+  std::string transit_platform_count = std::to_string(stop_count); // TODO: locale specific numerals
+  const auto& phrase = dictionary_.transit_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kTransitName, transit_name},
+                              {PhraseTag::kTransitHeadSign, transit_headsign},
+                              {PhraseTag::kTransitPlatformCount, transit_platform_count},
+                              {PhraseTag::kTransitPlatformCountLabel, stop_count_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3667,14 +3655,12 @@ std::string NarrativeBuilder::FormVerbalTransitInstruction(Maneuver& maneuver) {
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitNameTag,
-                     FormTransitName(maneuver,
-                                     dictionary_.transit_verbal_subset.empty_transit_name_labels));
-  boost::replace_all(instruction, kTransitHeadSignTag, transit_headsign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  std::string transit_name =
+      FormTransitName(maneuver, dictionary_.transit_verbal_subset.empty_transit_name_labels);
+  const auto& phrase = dictionary_.transit_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kTransitName, transit_name},
+                              {PhraseTag::kTransitHeadSign, transit_headsign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3702,17 +3688,15 @@ std::string NarrativeBuilder::FormTransitRemainOnInstruction(Maneuver& maneuver)
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_remain_on_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitNameTag,
-                     FormTransitName(maneuver,
-                                     dictionary_.transit_remain_on_subset.empty_transit_name_labels));
-  boost::replace_all(instruction, kTransitHeadSignTag, transit_headsign);
-  boost::replace_all(instruction, kTransitPlatformCountTag,
-                     std::to_string(stop_count)); // TODO: locale specific numerals
-  boost::replace_all(instruction, kTransitPlatformCountLabelTag, stop_count_label);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  std::string transit_name =
+      FormTransitName(maneuver, dictionary_.transit_remain_on_subset.empty_transit_name_labels);
+  std::string transit_platform_count = std::to_string(stop_count); // TODO: locale specific numerals
+  const auto& phrase = dictionary_.transit_remain_on_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kTransitName, transit_name},
+                              {PhraseTag::kTransitHeadSign, transit_headsign},
+                              {PhraseTag::kTransitPlatformCount, transit_platform_count},
+                              {PhraseTag::kTransitPlatformCountLabel, stop_count_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3735,14 +3719,13 @@ std::string NarrativeBuilder::FormVerbalTransitRemainOnInstruction(Maneuver& man
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_remain_on_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitNameTag,
-                     FormTransitName(maneuver, dictionary_.transit_remain_on_verbal_subset
-                                                   .empty_transit_name_labels));
-  boost::replace_all(instruction, kTransitHeadSignTag, transit_headsign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  std::string transit_name =
+      FormTransitName(maneuver,
+                      dictionary_.transit_remain_on_verbal_subset.empty_transit_name_labels);
+  const auto& phrase = dictionary_.transit_remain_on_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kTransitName, transit_name},
+                              {PhraseTag::kTransitHeadSign, transit_headsign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3770,17 +3753,15 @@ std::string NarrativeBuilder::FormTransitTransferInstruction(Maneuver& maneuver)
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_transfer_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitNameTag,
-                     FormTransitName(maneuver,
-                                     dictionary_.transit_transfer_subset.empty_transit_name_labels));
-  boost::replace_all(instruction, kTransitHeadSignTag, transit_headsign);
-  boost::replace_all(instruction, kTransitPlatformCountTag,
-                     std::to_string(stop_count)); // TODO: locale specific numerals
-  boost::replace_all(instruction, kTransitPlatformCountLabelTag, stop_count_label);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  std::string transit_name =
+      FormTransitName(maneuver, dictionary_.transit_transfer_subset.empty_transit_name_labels);
+  std::string transit_platform_count = std::to_string(stop_count); // TODO: locale specific numerals
+  const auto& phrase = dictionary_.transit_transfer_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kTransitName, transit_name},
+                              {PhraseTag::kTransitHeadSign, transit_headsign},
+                              {PhraseTag::kTransitPlatformCount, transit_platform_count},
+                              {PhraseTag::kTransitPlatformCountLabel, stop_count_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3803,14 +3784,12 @@ std::string NarrativeBuilder::FormVerbalTransitTransferInstruction(Maneuver& man
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_transfer_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitNameTag,
-                     FormTransitName(maneuver, dictionary_.transit_transfer_verbal_subset
-                                                   .empty_transit_name_labels));
-  boost::replace_all(instruction, kTransitHeadSignTag, transit_headsign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  std::string transit_name =
+      FormTransitName(maneuver, dictionary_.transit_transfer_verbal_subset.empty_transit_name_labels);
+  const auto& phrase = dictionary_.transit_transfer_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kTransitName, transit_name},
+                              {PhraseTag::kTransitHeadSign, transit_headsign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3851,14 +3830,13 @@ std::string NarrativeBuilder::FormVerbalPostTransitionInstruction(Maneuver& mane
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.post_transition_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kLengthTag,
-                     FormLength(maneuver, dictionary_.post_transition_verbal_subset.metric_lengths,
-                                dictionary_.post_transition_verbal_subset.us_customary_lengths));
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  std::string length =
+      FormLength(maneuver, dictionary_.post_transition_verbal_subset.metric_lengths,
+                 dictionary_.post_transition_verbal_subset.us_customary_lengths);
+  const auto& phrase = dictionary_.post_transition_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kLength, length},
+                              {PhraseTag::kStreetNames, street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3879,14 +3857,11 @@ std::string NarrativeBuilder::FormVerbalPostTransitionTransitInstruction(Maneuve
       FormTransitPlatformCountLabel(stop_count, dictionary_.post_transition_transit_verbal_subset
                                                     .transit_stop_count_labels);
 
-  // Set instruction to the determined tagged phrase
-  instruction =
-      dictionary_.post_transition_transit_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformCountTag,
-                     std::to_string(stop_count)); // TODO: locale specific numerals
-  boost::replace_all(instruction, kTransitPlatformCountLabelTag, stop_count_label);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  std::string transit_platform_count = std::to_string(stop_count); // TODO: locale specific numerals
+  const auto& phrase = dictionary_.post_transition_transit_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kTransitPlatformCount, transit_platform_count},
+                              {PhraseTag::kTransitPlatformCountLabel, stop_count_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3930,14 +3905,13 @@ std::string NarrativeBuilder::FormVerbalSuccinctStartTransitionInstruction(Maneu
     phrase_id += 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.start_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kCardinalDirectionTag, cardinal_direction);
-  boost::replace_all(instruction, kLengthTag,
-                     FormLength(maneuver, dictionary_.start_verbal_subset.metric_lengths,
-                                dictionary_.start_verbal_subset.us_customary_lengths));
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  std::string length =
+      FormLength(maneuver, dictionary_.start_verbal_subset.metric_lengths,
+                 dictionary_.start_verbal_subset.us_customary_lengths);
+  const auto& phrase = dictionary_.start_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kCardinalDirection, cardinal_direction},
+                              {PhraseTag::kLength, length}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3996,14 +3970,13 @@ NarrativeBuilder::FormVerbalSuccinctTurnTransitionInstruction(Maneuver& maneuver
                                                maneuver.verbal_formatter(), &markup_formatter_);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = subset->phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-                     FormRelativeTwoDirection(maneuver.type(), subset->relative_directions));
-  boost::replace_all(instruction, kJunctionNameTag, junction_name);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  std::string relative_direction =
+      FormRelativeTwoDirection(maneuver.type(), subset->relative_directions);
+  const auto& phrase = subset->GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kJunctionName, junction_name},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -4042,15 +4015,13 @@ NarrativeBuilder::FormVerbalSuccinctUturnTransitionInstruction(Maneuver& maneuve
         maneuver.signs().GetJunctionNameString(element_max_count, limit_by_consecutive_count, delim,
                                                maneuver.verbal_formatter(), &markup_formatter_);
   }
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.uturn_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-                     FormRelativeTwoDirection(maneuver.type(),
-                                              dictionary_.uturn_verbal_subset.relative_directions));
-  boost::replace_all(instruction, kJunctionNameTag, junction_name);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  std::string relative_direction =
+      FormRelativeTwoDirection(maneuver.type(), dictionary_.uturn_verbal_subset.relative_directions);
+  const auto& phrase = dictionary_.uturn_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kJunctionName, junction_name},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -4094,12 +4065,10 @@ NarrativeBuilder::FormVerbalSuccinctMergeTransitionInstruction(Maneuver& maneuve
                                  dictionary_.merge_verbal_subset.relative_directions);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.merge_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_direction);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.merge_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -4142,12 +4111,10 @@ std::string NarrativeBuilder::FormVerbalSuccinctEnterRoundaboutTransitionInstruc
                                                         &markup_formatter_);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.enter_roundabout_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kOrdinalValueTag, ordinal_value);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.enter_roundabout_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kOrdinalValue, ordinal_value},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -4178,10 +4145,9 @@ std::string NarrativeBuilder::FormVerbalSuccinctExitRoundaboutTransitionInstruct
                                                  maneuver.verbal_formatter(), &markup_formatter_);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.exit_roundabout_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.exit_roundabout_verbal_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -4207,11 +4173,9 @@ std::string NarrativeBuilder::FormElevatorInstruction(Maneuver& maneuver) {
     end_level = maneuver.end_level_ref();
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.elevator_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kLevelTag, end_level);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.elevator_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kLevel, end_level}});
 
   return instruction;
 }
@@ -4232,11 +4196,9 @@ std::string NarrativeBuilder::FormStepsInstruction(Maneuver& maneuver) {
     end_level = maneuver.end_level_ref();
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.steps_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kLevelTag, end_level);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.steps_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kLevel, end_level}});
 
   return instruction;
 }
@@ -4257,11 +4219,9 @@ std::string NarrativeBuilder::FormEscalatorInstruction(Maneuver& maneuver) {
     end_level = maneuver.end_level_ref();
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.escalator_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kLevelTag, end_level);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.escalator_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kLevel, end_level}});
 
   return instruction;
 }
@@ -4284,11 +4244,9 @@ std::string NarrativeBuilder::FormEnterBuildingInstruction(Maneuver& maneuver) {
     phrase_id += 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.enter_building_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.enter_building_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kStreetNames, street_names}});
 
   return instruction;
 }
@@ -4311,11 +4269,9 @@ std::string NarrativeBuilder::FormExitBuildingInstruction(Maneuver& maneuver) {
     phrase_id += 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.exit_building_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.exit_building_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kStreetNames, street_names}});
 
   return instruction;
 }
@@ -4364,11 +4320,9 @@ std::string NarrativeBuilder::FormPassInstruction(Maneuver& maneuver) {
       object_label = dictionary_.pass_subset.object_labels.at(dictionary_object_index);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.pass_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kObjectLabelTag, object_label);
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  const auto& phrase = dictionary_.pass_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kObjectLabel, object_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -4796,14 +4750,14 @@ std::string NarrativeBuilder::FormVerbalMultiCue(Maneuver& maneuver,
   if (maneuver.distant_verbal_multi_cue()) {
     phrase_id = 1;
   }
-  instruction = dictionary_.verbal_multi_cue_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kCurrentVerbalCueTag, first_verbal_cue);
-  boost::replace_all(instruction, kNextVerbalCueTag, second_verbal_cue);
-  boost::replace_all(instruction, kLengthTag,
-                     FormLength(maneuver, dictionary_.post_transition_verbal_subset.metric_lengths,
-                                dictionary_.post_transition_verbal_subset.us_customary_lengths));
+  // Set instruction to the determined tagged phrase, replacing the phrase tags with values
+  std::string length =
+      FormLength(maneuver, dictionary_.post_transition_verbal_subset.metric_lengths,
+                 dictionary_.post_transition_verbal_subset.us_customary_lengths);
+  const auto& phrase = dictionary_.verbal_multi_cue_subset.GetTemplate(phrase_id);
+  phrase.Format(instruction, {{PhraseTag::kCurrentVerbalCue, first_verbal_cue},
+                              {PhraseTag::kNextVerbalCue, second_verbal_cue},
+                              {PhraseTag::kLength, length}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
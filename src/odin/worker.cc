@@ -41,6 +41,7 @@ std::string odin_worker_t::narrate(Api& request) const {
   } catch (...) { throw valhalla_exception_t{202}; }
 
   // serialize those to the proper format
+  auto serialization = measure_serialization(request);
   return tyr::serializeDirections(request);
 }
 
@@ -62,7 +63,8 @@ odin_worker_t::work(const std::list<zmq::message_t>& job,
                     const std::function<void()>& interrupt_function) {
   auto& info = *static_cast<prime_server::http_request_info_t*>(request_info);
   LOG_INFO("Got Odin Request " + std::to_string(info.id));
-  Api request;
+  // lives in the arena until cleanup
+  auto& request = arena.request();
   prime_server::worker_t::result_t result{false, {}, {}};
   try {
     // Set the interrupt function
@@ -269,7 +269,7 @@ const std::string& ShapeMatch_Enum_Name(const ShapeMatch match) {
 bool Options_Format_Enum_Parse(const std::string& format, Options::Format* f) {
   static const std::unordered_map<std::string, Options::Format> formats{
       {"json", Options::json}, {"gpx", Options::gpx},         {"osrm", Options::osrm},
-      {"pbf", Options::pbf},   {"geotiff", Options::geotiff},
+      {"pbf", Options::pbf},   {"geotiff", Options::geotiff}, {"columnar", Options::columnar},
   };
   auto i = formats.find(format);
   if (i == formats.cend())
@@ -281,7 +281,7 @@ bool Options_Format_Enum_Parse(const std::string& format, Options::Format* f) {
 const std::string& Options_Format_Enum_Name(const Options::Format match) {
   static const std::unordered_map<int, std::string> formats{
       {Options::json, "json"}, {Options::gpx, "gpx"},         {Options::osrm, "osrm"},
-      {Options::pbf, "pbf"},   {Options::geotiff, "geotiff"},
+      {Options::pbf, "pbf"},   {Options::geotiff, "geotiff"}, {Options::columnar, "columnar"},
   };
   auto i = formats.find(match);
   return i == formats.cend() ? empty_str : i->second;
@@ -296,6 +296,19 @@ const std::string& Options_Units_Enum_Name(const Options::Units unit) {
   return i == units.cend() ? empty_str : i->second;
 }
 
+bool Options_ColumnEncoding_Enum_Parse(const std::string& encoding, Options::ColumnEncoding* e) {
+  static const std::unordered_map<std::string, Options::ColumnEncoding> encodings{
+      {"raw", Options::raw},
+      {"delta", Options::delta},
+      {"float16", Options::float16},
+  };
+  auto i = encodings.find(encoding);
+  if (i == encodings.cend())
+    return false;
+  *e = i->second;
+  return true;
+}
+
 bool FilterAction_Enum_Parse(const std::string& action, FilterAction* a) {
   static const std::unordered_map<std::string, FilterAction> actions{
       {"exclude", FilterAction::exclude},
@@ -336,6 +336,14 @@ public:
            (allow_closures || !tile->IsClosed(edge)) && IsHOVAllowed(edge);
   }
 
+  /**
+   * Everything else auto rules out by default is left out of the reach labels, so they only stop
+   * being a lower bound when the request excludes more.
+   */
+  bool ReachLabelsApply() const override {
+    return !HasExclusions();
+  }
+
   // Hidden in source file so we don't need it to be protected
   // We expose it within the source file for testing purposes
 public:
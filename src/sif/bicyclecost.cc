@@ -423,6 +423,14 @@ public:
   // grade (relative value from 0-15)
   float grade_penalty[16];
 
+  /**
+   * The reach labels leave out impassable surfaces only, so they overestimate for bicycles which
+   * avoid bad surfaces altogether.
+   */
+  bool ReachLabelsApply() const override {
+    return !HasExclusions() && worst_allowed_surface_ >= Surface::kPath;
+  }
+
 protected:
   /**
    * Function to be used in location searching which will
@@ -477,6 +477,16 @@ public:
            (!edge->bss_connection() || project_on_bss_connection);
   }
 
+  /**
+   * The reach labels are computed for walking on anything up to hiking trails, so they overestimate
+   * for wheelchairs, easier trails, fewer surfaces or a shorter maximum distance.
+   */
+  bool ReachLabelsApply() const override {
+    return !HasExclusions() && type_ != PedestrianType::kWheelchair &&
+           minimal_allowed_surface_ >= Surface::kPath &&
+           max_hiking_difficulty_ >= SacScale::kHiking && max_distance_ >= kMaxDistanceFoot;
+  }
+
   virtual Cost BSSCost() const override {
     return {kDefaultBssCost, kDefaultBssPenalty};
   };
@@ -310,6 +310,14 @@ public:
            (allow_closures || !tile->IsClosed(edge));
   }
 
+  /**
+   * The dimensions, weights and hazmat of the truck only matter on edges with access restrictions,
+   * which the reach labels leave out, so only excludes make the labels overestimate.
+   */
+  bool ReachLabelsApply() const override {
+    return !HasExclusions();
+  }
+
 public:
   VehicleType type_; // Vehicle type: truck
   std::vector<float> speedfactor_;
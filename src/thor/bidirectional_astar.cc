@@ -4,6 +4,7 @@
 #include "baldr/graphid.h"
 #include "midgard/encoded.h"
 #include "midgard/logging.h"
+#include "midgard/tracing.h"
 #include "sif/edgelabel.h"
 #include "sif/recost.h"
 #include "thor/alternates.h"
@@ -143,8 +144,8 @@ void BidirectionalAStar::Init(const PointLL& origll, const PointLL& destll) {
                   [](const HierarchyLimits& limits) {
                     return limits.max_up_transitions() == kUnlimitedTransitions;
                   });
-  hierarchy_limits_forward_ = hierarchy_limits;
-  hierarchy_limits_reverse_ = hierarchy_limits;
+  hierarchy_limits_forward_ = ToHierarchyLimitStates(hierarchy_limits);
+  hierarchy_limits_reverse_ = hierarchy_limits_forward_;
 }
 
 // Runs in the inner loop of `Expand`, essentially evaluating if
@@ -319,7 +320,7 @@ inline bool BidirectionalAStar::ExpandInner(baldr::GraphReader& graphreader,
   uint32_t idx = 0;
   if (FORWARD) {
     idx = edgelabels_forward_.size();
-    if (hierarchy_limits_forward_[meta.edge_id.level()].max_up_transitions() !=
+    if (hierarchy_limits_forward_[meta.edge_id.level()].max_up_transitions !=
         kUnlimitedTransitions) {
       // Override distance to the destination with a distance from the origin.
       // It will be used by hierarchy limits
@@ -337,7 +338,7 @@ inline bool BidirectionalAStar::ExpandInner(baldr::GraphReader& graphreader,
     adjacencylist_forward_.add(idx);
   } else {
     idx = edgelabels_reverse_.size();
-    if (hierarchy_limits_reverse_[meta.edge_id.level()].max_up_transitions() !=
+    if (hierarchy_limits_reverse_[meta.edge_id.level()].max_up_transitions !=
         kUnlimitedTransitions) {
       // Override distance to the origin with a distance from the destination.
       // It will be used by hierarchy limits
@@ -456,8 +457,7 @@ void BidirectionalAStar::Expand(baldr::GraphReader& graphreader,
       }
 
       // setup for expansion at this level
-      hierarchy_limits[node.level()].set_up_transition_count(
-          hierarchy_limits[node.level()].up_transition_count() + trans->up());
+      hierarchy_limits[node.level()].up_transition_count += trans->up();
       const auto* trans_node = trans_tile->node(trans->endnode());
       EdgeMetadata trans_meta =
           EdgeMetadata::make(trans->endnode(), trans_node, trans_tile, edgestatus);
@@ -499,6 +499,7 @@ BidirectionalAStar::GetBestPath(valhalla::Location& origin,
                                 const sif::mode_costing_t& mode_costing,
                                 const sif::travel_mode_t mode,
                                 const Options& options) {
+  VALHALLA_TRACE_SCOPE("thor", "bidirectional_a*");
   // Set the mode and costing
   mode_ = mode;
   costing_ = mode_costing[static_cast<uint32_t>(mode_)];
@@ -1018,7 +1019,7 @@ void BidirectionalAStar::SetOrigin(GraphReader& graphreader,
     // to invalid to indicate the origin of the path.
     uint32_t idx = edgelabels_forward_.size();
     edgestatus_forward_.Set(edgeid, EdgeSet::kTemporary, idx, tile);
-    if (hierarchy_limits_forward_[edgeid.level()].max_up_transitions() != kUnlimitedTransitions) {
+    if (hierarchy_limits_forward_[edgeid.level()].max_up_transitions != kUnlimitedTransitions) {
       // Override distance to the destination with a distance from the origin.
       // It will be used by hierarchy limits
       dist = astarheuristic_reverse_.GetDistance(nodeinfo->latlng(endtile->header()->base_ll()));
@@ -1116,7 +1117,7 @@ void BidirectionalAStar::SetDestination(GraphReader& graphreader,
     // edge (edgeid) is set.
     uint32_t idx = edgelabels_reverse_.size();
     edgestatus_reverse_.Set(opp_edge_id, EdgeSet::kTemporary, idx, opp_tile);
-    if (hierarchy_limits_reverse_[opp_edge_id.level()].max_up_transitions() !=
+    if (hierarchy_limits_reverse_[opp_edge_id.level()].max_up_transitions !=
         kUnlimitedTransitions) {
       // Override distance to the origin with a distance from the destination.
       // It will be used by hierarchy limits
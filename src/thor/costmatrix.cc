@@ -5,6 +5,7 @@
 #include "baldr/datetime.h"
 #include "midgard/encoded.h"
 #include "midgard/logging.h"
+#include "midgard/tracing.h"
 #include "sif/recost.h"
 #include "thor/costmatrix.h"
 #include "worker.h"
@@ -116,6 +117,7 @@ bool CostMatrix::SourceToTarget(Api& request,
                                 const sif::mode_costing_t& mode_costing,
                                 const sif::travel_mode_t mode,
                                 const float max_matrix_distance) {
+  VALHALLA_TRACE_SCOPE("thor", "costmatrix");
   request.mutable_matrix()->set_algorithm(Matrix::CostMatrix);
   bool invariant = request.options().date_time_type() == Options::invariant;
 
@@ -147,6 +149,7 @@ bool CostMatrix::SourceToTarget(Api& request,
   uint32_t n = 0;
   uint32_t interrupt_n = 0;
   while (true) {
+    VALHALLA_TRACE_SCOPE("thor", "costmatrix_iteration");
     // First iterate over all targets, then over all sources: we only for sure
     // check the connection between both trees on the forward search, so reverse
     // has to come first
@@ -309,6 +312,7 @@ void CostMatrix::Initialize(
       std::all_of(hlimits.begin(), hlimits.end(), [](const HierarchyLimits& limits) {
         return limits.max_up_transitions() == kUnlimitedTransitions;
       });
+  const auto hlimit_states = ToHierarchyLimitStates(hlimits);
 
   const uint32_t bucketsize = costing_->UnitSize();
   const float range = kBucketCount * bucketsize;
@@ -331,7 +335,7 @@ void CostMatrix::Initialize(
       // Use the cost threshold to size the adjacency list.
       edgelabel_[is_fwd][i].reserve(max_reserved_labels_count_);
       locs_status_[is_fwd].emplace_back(kMaxThreshold);
-      hierarchy_limits_[is_fwd][i] = hlimits;
+      hierarchy_limits_[is_fwd][i] = hlimit_states;
       // for each source/target init the other direction's astar heuristic
       auto& ll = locations[i].ll();
       astar_heuristics_[!is_fwd][i].Init({ll.lng(), ll.lat()}, costing_->AStarCostFactor());
@@ -714,8 +718,7 @@ bool CostMatrix::Expand(const uint32_t index,
       }
 
       // setup for expansion at this level
-      hierarchy_limits[node.level()].set_up_transition_count(
-          hierarchy_limits[node.level()].up_transition_count() + trans->up());
+      hierarchy_limits[node.level()].up_transition_count += trans->up();
       const auto* trans_node = trans_tile->node(trans->endnode());
       EdgeMetadata trans_meta =
           EdgeMetadata::make(trans->endnode(), trans_node, trans_tile, edgestatus);
@@ -7,6 +7,8 @@
 #include "tyr/serializers.h"
 #include <robin_hood.h>
 
+#include <optional>
+
 using namespace rapidjson;
 using namespace valhalla::midgard;
 using namespace valhalla::tyr;
@@ -15,6 +17,9 @@ namespace {
 
 using namespace valhalla;
 
+// how many edges to collect before writing them out when streaming
+constexpr int kStreamedExpansionEdges = 1024;
+
 void writeExpansionProgress(Expansion* expansion,
                             const baldr::GraphId& edgeid,
                             const baldr::GraphId& prev_edgeid,
@@ -86,12 +91,12 @@ struct expansion_properties_t {
 namespace valhalla {
 namespace thor {
 
-std::string thor_worker_t::expansion(Api& request) {
+std::string thor_worker_t::expansion(Api& request, const chunk_sink_t& sink) {
   // time this whole method and save that statistic
   measure_scope_time(request);
 
   // get the request params
-  auto options = request.options();
+  const auto& options = request.options();
   auto exp_action = options.expansion_action();
   bool skip_opps = options.skip_opposites();
   bool dedupe = options.dedupe();
@@ -107,6 +112,12 @@ std::string thor_worker_t::expansion(Api& request) {
   }
 
   auto* expansion = request.mutable_expansion();
+  // with a sink the geojson is written out while the search runs instead of collected until the end
+  std::optional<tyr::expansion_writer_t> writer;
+  if (sink && options.format() != Options::pbf) {
+    writer.emplace(options, sink);
+  }
+
   // a lambda that the path algorithm can call to add stuff to the dom
   // route and isochrone produce different GeoJSON properties
   std::string algo = "";
@@ -153,6 +164,11 @@ std::string thor_worker_t::expansion(Api& request) {
         } else {
           writeExpansionProgress(expansion, edgeid, prev_edgeid, shape, exp_props, status, duration,
                                  distance, cost, expansion_type);
+          // drop the edges once they're written so the expansion stays small
+          if (writer && expansion->geometries_size() == kStreamedExpansionEdges) {
+            writer->write(*expansion);
+            expansion->Clear();
+          }
         }
       };
 
@@ -204,7 +220,15 @@ std::string thor_worker_t::expansion(Api& request) {
   isochrone_gen.SetInnerExpansionCallback(nullptr);
 
   // serialize it
-  return tyr::serializeExpansion(request, algo);
+  if (writer) {
+    return writer->finish(*expansion, algo);
+  }
+  auto bytes = tyr::serializeExpansion(request, algo);
+  if (sink) {
+    sink(bytes);
+    return "";
+  }
+  return bytes;
 }
 
 } // namespace thor
@@ -2,6 +2,7 @@
 #include "baldr/datetime.h"
 #include "midgard/distanceapproximator.h"
 #include "midgard/logging.h"
+#include "midgard/tracing.h"
 #include <algorithm>
 
 using namespace valhalla::midgard;
@@ -174,6 +175,7 @@ std::shared_ptr<const GriddedData<2>> Isochrone::Expand(const ExpansionType& exp
                                                         GraphReader& reader,
                                                         const sif::mode_costing_t& mode_costing,
                                                         const travel_mode_t mode) {
+  VALHALLA_TRACE_SCOPE("thor", "isochrone");
   // Initialize and create the isotile
   ConstructIsoTile(expansion_type == ExpansionType::multimodal, api, mode);
   // Compute the expansion
@@ -44,6 +44,7 @@ std::string thor_worker_t::isochrones(Api& request) {
     return "";
 
   // make the final output (pbf, json or geotiff)
+  auto serialization = measure_serialization(request);
   std::string ret = tyr::serializeIsochrones(request, intervals, grid);
 
   return ret;
@@ -7,6 +7,8 @@
 #include "thor/worker.h"
 #include "tyr/serializers.h"
 
+#include <algorithm>
+
 using namespace valhalla;
 using namespace valhalla::tyr;
 using namespace valhalla::midgard;
@@ -27,14 +29,18 @@ const std::string get_unfound_indices(const google::protobuf::RepeatedField<bool
   return indices;
 }
 
+// without a calibrated cost model pedestrian and bicycle matrices only use CostMatrix when they have
+// more sources and more targets than this
 constexpr uint32_t kCostMatrixThreshold = 5;
 } // namespace
 
 namespace valhalla {
 namespace thor {
 
-MatrixAlgorithm*
-thor_worker_t::get_matrix_algorithm(Api& request, const bool has_time, const std::string& costing) {
+MatrixAlgorithm* thor_worker_t::get_matrix_algorithm(Api& request,
+                                                     const bool has_time,
+                                                     const std::string& costing,
+                                                     const matrix_features_t& features) {
   if (costing == "bikeshare") {
     return &time_distance_bss_matrix_;
   }
@@ -42,7 +48,11 @@ thor_worker_t::get_matrix_algorithm(Api& request, const bool has_time, const std
   Matrix::Algorithm config_algo = Matrix::CostMatrix;
   switch (source_to_target_algorithm) {
     case SELECT_OPTIMAL:
-      // TODO - Do further performance testing to pick the best algorithm for the job
+      // when the cost model was calibrated for the travel mode it predicts the faster algorithm
+      if (matrix_cost_model.calibrated(mode)) {
+        config_algo = matrix_cost_model.select(mode, features);
+        break;
+      }
       switch (mode) {
         case travel_mode_t::kPedestrian:
         case travel_mode_t::kBicycle:
@@ -67,16 +77,25 @@ thor_worker_t::get_matrix_algorithm(Api& request, const bool has_time, const std
       break;
   }
 
+  // a calibrated cost model also decides for time dependent requests, unless bidirectional was
+  // prioritized. CostMatrix only departs at a time, so arriving at one is always left to the
+  // unidirectional algo
+  const bool modelled =
+      has_time && source_to_target_algorithm == SELECT_OPTIMAL &&
+      matrix_cost_model.calibrated(mode) && !request.options().prioritize_bidirectional() &&
+      std::any_of(request.options().sources().begin(), request.options().sources().end(),
+                  [](const Location& source) { return !source.date_time().empty(); });
+
   // similar to routing: prefer the exact unidirectional algo if not requested otherwise
   // don't use matrix_type, we only need it to set the right warnings for what will be used
   if (has_time && !request.options().prioritize_bidirectional() &&
-      source_to_target_algorithm != COST_MATRIX) {
+      source_to_target_algorithm != COST_MATRIX && !modelled) {
     return &time_distance_matrix_;
   } else if (has_time && request.options().prioritize_bidirectional() &&
              source_to_target_algorithm != TIME_DISTANCE_MATRIX) {
     return &costmatrix_;
   } else if (config_algo == Matrix::CostMatrix) {
-    if (has_time && !request.options().prioritize_bidirectional()) {
+    if (has_time && !request.options().prioritize_bidirectional() && !modelled) {
       add_warning(request, 301);
     }
     return &costmatrix_;
@@ -89,7 +108,29 @@ thor_worker_t::get_matrix_algorithm(Api& request, const bool has_time, const std
   }
 }
 
-std::string thor_worker_t::matrix(Api& request) {
+void thor_worker_t::log_matrix(const Api& request,
+                               const matrix_features_t& features,
+                               const float elapsed_ms,
+                               const boost::optional<float>& second_pass_ms) const {
+  // what the cost model would have predicted is logged next to what it took so that it can be
+  // tuned, the model is of one pass so a second pass is logged on its own. it is debug output so
+  // that production logs don't get a line per matrix, the prediction is only made when it's logged
+  LOG_DEBUG("matrix::" + MatrixAlgoToString(request.matrix().algorithm()) +
+            " sources=" + std::to_string(features.sources) +
+            " targets=" + std::to_string(features.targets) +
+            " spread_km=" + std::to_string(features.spread) +
+            " time_dependent=" + std::to_string(features.time_dependent) + " predicted_ms=" +
+            [&]() {
+              auto predicted =
+                  matrix_cost_model.predict(request.matrix().algorithm(), mode, features);
+              return predicted ? std::to_string(*predicted) : std::string("none");
+            }() +
+            " actual_ms=" + std::to_string(elapsed_ms) +
+            (second_pass_ms ? " second_pass_ms=" + std::to_string(*second_pass_ms)
+                            : std::string()));
+}
+
+std::string thor_worker_t::matrix(Api& request, const chunk_sink_t& sink) {
   // time this whole method and save that statistic
   auto _ = measure_scope_time(request);
 
@@ -111,7 +152,8 @@ std::string thor_worker_t::matrix(Api& request) {
     alg->set_has_time(has_time);
   }
 
-  auto* algo = get_matrix_algorithm(request, has_time, costing);
+  const auto features = MatrixCostModel::features(options, has_time);
+  auto* algo = get_matrix_algorithm(request, has_time, costing, features);
   if (check_hierarchy_limits(mode_costing[int(mode)]->GetHierarchyLimits(), mode_costing[int(mode)],
                              options.costings().find(options.costing_type())->second.options(),
                              hierarchy_limits_config_costmatrix, allow_hierarchy_limits_modifications,
@@ -119,13 +161,19 @@ std::string thor_worker_t::matrix(Api& request) {
     // maybe warn if we needed to change user provided hierarchy limits
     add_warning(request, allow_hierarchy_limits_modifications ? 210 : 209);
   }
-  LOG_INFO("matrix::" + std::string(algo->name()));
 
   // TODO(nils): TDMatrix doesn't care about either destonly or no_thru
+  auto start = std::chrono::steady_clock::now();
+  auto elapsed_ms = [&start]() {
+    return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+  };
   if (algo->name() != "costmatrix") {
     algo->SourceToTarget(request, *reader, mode_costing, mode,
                          max_matrix_distance.find(costing)->second);
-    return tyr::serializeMatrix(request);
+    log_matrix(request, features, elapsed_ms());
+    auto serialization = measure_serialization(request);
+    return tyr::serializeMatrix(request, sink);
   }
 
   // for costmatrix try a second pass if the first didn't work out
@@ -133,12 +181,15 @@ std::string thor_worker_t::matrix(Api& request) {
   cost->set_allow_destination_only(false);
   cost->set_pass(0);
 
-  if (!algo->SourceToTarget(request, *reader, mode_costing, mode,
-                            max_matrix_distance.find(costing)->second) &&
-      cost->AllowMultiPass() && costmatrix_allow_second_pass) {
+  const bool found = algo->SourceToTarget(request, *reader, mode_costing, mode,
+                                          max_matrix_distance.find(costing)->second);
+  const auto first_pass_ms = elapsed_ms();
+  boost::optional<float> second_pass_ms;
+  if (!found && cost->AllowMultiPass() && costmatrix_allow_second_pass) {
     // NOTE: we only look for unfound connections in a second pass; but
     // if A -> B wasn't found and B -> A was, we still expand both for bidirectional efficiency
     // TODO(nils): probably add filtered edges here too?
+    start = std::chrono::steady_clock::now();
     algo->Clear();
     cost->set_pass(1);
     cost->RelaxHierarchyLimits(true);
@@ -147,12 +198,15 @@ std::string thor_worker_t::matrix(Api& request) {
     algo->set_not_thru_pruning(false);
     algo->SourceToTarget(request, *reader, mode_costing, mode,
                          max_matrix_distance.find(costing)->second);
+    second_pass_ms = elapsed_ms();
 
     // add a warning that we needed to open destonly etc
     add_warning(request, 400, get_unfound_indices(request.matrix().second_pass()));
   };
+  log_matrix(request, features, first_pass_ms, second_pass_ms);
 
-  return tyr::serializeMatrix(request);
+  auto serialization = measure_serialization(request);
+  return tyr::serializeMatrix(request, sink);
 }
 } // namespace thor
 } // namespace valhalla
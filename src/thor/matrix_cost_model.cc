@@ -0,0 +1,116 @@
+#include "thor/matrix_cost_model.h"
+#include "midgard/pointll.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace valhalla::midgard;
+
+namespace {
+
+// the travel modes which can be calibrated, the others always go to the algorithm they need
+const std::array<std::pair<valhalla::sif::TravelMode, const char*>, 3> kModes{{
+    {valhalla::sif::TravelMode::kDrive, "drive"},
+    {valhalla::sif::TravelMode::kPedestrian, "pedestrian"},
+    {valhalla::sif::TravelMode::kBicycle, "bicycle"},
+}};
+
+// the algorithms which are modelled and where their coefficients are kept
+const std::array<std::pair<valhalla::Matrix::Algorithm, const char*>, 2> kAlgorithms{{
+    {valhalla::Matrix::CostMatrix, "costmatrix"},
+    {valhalla::Matrix::TimeDistanceMatrix, "timedistancematrix"},
+}};
+
+size_t algorithm_index(const valhalla::Matrix::Algorithm algorithm) {
+  return algorithm == valhalla::Matrix::CostMatrix ? 0 : 1;
+}
+
+} // namespace
+
+namespace valhalla {
+namespace thor {
+
+MatrixCostModel::MatrixCostModel(const boost::optional<const boost::property_tree::ptree&>& config) {
+  if (!config) {
+    return;
+  }
+  for (const auto& mode : kModes) {
+    for (const auto& algorithm : kAlgorithms) {
+      auto child = config->get_child_optional(std::string(mode.second) + "." + algorithm.second);
+      if (!child) {
+        continue;
+      }
+      coefficients_[static_cast<size_t>(mode.first)][algorithm_index(algorithm.first)] =
+          coefficients_t{child->get<float>("fixed", 0.f),
+                         child->get<float>("per_location", 0.f),
+                         child->get<float>("per_search_km", 0.f),
+                         child->get<float>("per_search_km2", 0.f),
+                         child->get<float>("per_pair", 0.f),
+                         child->get<float>("time_dependent_factor", 1.f)};
+    }
+  }
+}
+
+matrix_features_t MatrixCostModel::features(const Options& options, const bool time_dependent) {
+  float min_lng = std::numeric_limits<float>::max(), min_lat = min_lng;
+  float max_lng = std::numeric_limits<float>::lowest(), max_lat = max_lng;
+  for (const auto* locations : {&options.sources(), &options.targets()}) {
+    for (const auto& location : *locations) {
+      min_lng = std::min(min_lng, static_cast<float>(location.ll().lng()));
+      min_lat = std::min(min_lat, static_cast<float>(location.ll().lat()));
+      max_lng = std::max(max_lng, static_cast<float>(location.ll().lng()));
+      max_lat = std::max(max_lat, static_cast<float>(location.ll().lat()));
+    }
+  }
+  const float spread = min_lng > max_lng ? 0.f
+                                         : PointLL(min_lng, min_lat).Distance({max_lng, max_lat}) *
+                                               kKmPerMeter;
+  return matrix_features_t{static_cast<uint32_t>(options.sources_size()),
+                           static_cast<uint32_t>(options.targets_size()), spread, time_dependent};
+}
+
+bool MatrixCostModel::calibrated(const sif::TravelMode mode) const {
+  if (mode >= sif::TravelMode::kMaxTravelMode) {
+    return false;
+  }
+  const auto& coefficients = coefficients_[static_cast<size_t>(mode)];
+  return coefficients[0] && coefficients[1];
+}
+
+boost::optional<float> MatrixCostModel::predict(const Matrix::Algorithm algorithm,
+                                                const sif::TravelMode mode,
+                                                const matrix_features_t& features) const {
+  if (mode >= sif::TravelMode::kMaxTravelMode ||
+      (algorithm != Matrix::CostMatrix && algorithm != Matrix::TimeDistanceMatrix)) {
+    return boost::none;
+  }
+  const auto& c = coefficients_[static_cast<size_t>(mode)][algorithm_index(algorithm)];
+  if (!c) {
+    return boost::none;
+  }
+
+  const float sources = features.sources, targets = features.targets;
+  const float searches =
+      algorithm == Matrix::CostMatrix ? sources + targets : std::min(sources, targets);
+  float ms = c->fixed + c->per_location * (sources + targets) +
+             searches * (c->per_search_km * features.spread +
+                         c->per_search_km2 * features.spread * features.spread) +
+             c->per_pair * sources * targets;
+  if (features.time_dependent) {
+    ms *= c->time_dependent_factor;
+  }
+  return ms;
+}
+
+Matrix::Algorithm MatrixCostModel::select(const sif::TravelMode mode,
+                                          const matrix_features_t& features) const {
+  auto costmatrix = predict(Matrix::CostMatrix, mode, features);
+  auto time_distance_matrix = predict(Matrix::TimeDistanceMatrix, mode, features);
+  if (costmatrix && time_distance_matrix && *time_distance_matrix < *costmatrix) {
+    return Matrix::TimeDistanceMatrix;
+  }
+  return Matrix::CostMatrix;
+}
+
+} // namespace thor
+} // namespace valhalla
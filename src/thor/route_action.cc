@@ -1,5 +1,8 @@
 #include "thor/worker.h"
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <mutex>
 
 #include "baldr/attributes_controller.h"
 #include "baldr/datetime.h"
@@ -28,6 +31,17 @@ namespace {
 // A* can take excessive time for longer paths - so exclude them to protect the service.
 constexpr float kPedestrianMultipassThreshold = 50000.0f; // 50km
 
+/**
+ * A route session tree is only valid for the exact same origin candidates and costing options
+ */
+std::string route_session_key(const valhalla::Location& origin, const Options& options) {
+  std::string key = options.costings().find(options.costing_type())->second.SerializeAsString();
+  for (const auto& edge : origin.correlation().edges()) {
+    key += edge.SerializeAsString();
+  }
+  return key;
+}
+
 /**
  * Check if the paths meet at opposing edges (but not at a node). If so, add an intermediate location
  * so that the shape / distance along the path is adjusted at the location.
@@ -298,18 +312,25 @@ std::vector<std::vector<thor::PathInfo>> thor_worker_t::get_path(PathAlgorithm*
                                                                  valhalla::Location& origin,
                                                                  valhalla::Location& destination,
                                                                  const std::string& costing,
-                                                                 const Options& options) {
+                                                                 const Options& options,
+                                                                 leg_worker_t* leg_worker) {
+  // A leg worker brings its own graph reader, costing and algorithms
+  auto& graph_reader = leg_worker ? leg_worker->reader : *reader;
+  auto& costings = leg_worker ? leg_worker->mode_costing : mode_costing;
+  auto* bidirectional = leg_worker ? &leg_worker->bidir_astar : &bidir_astar;
+
   // Find the path.
-  valhalla::sif::cost_ptr_t cost = mode_costing[static_cast<uint32_t>(mode)];
+  valhalla::sif::cost_ptr_t cost = costings[static_cast<uint32_t>(mode)];
 
   // If bidirectional A* disable use of destination-only edges on the
   // first pass. If there is a failure, we allow them on the second pass.
   // Other path algorithms can use destination-only edges on the first pass.
   // TODO(nils): why not others with destonly pruning? it gets a 2nd pass as well
-  cost->set_allow_destination_only(path_algorithm == &bidir_astar ? false : true);
+  cost->set_allow_destination_only(path_algorithm == bidirectional ? false : true);
 
   cost->set_pass(0);
-  auto paths = path_algorithm->GetBestPath(origin, destination, *reader, mode_costing, mode, options);
+  auto paths =
+      path_algorithm->GetBestPath(origin, destination, graph_reader, costings, mode, options);
 
   // Check if we should run a second pass pedestrian route with different A*
   // (to look for better routes where a ferry is taken)
@@ -335,14 +356,14 @@ std::vector<std::vector<thor::PathInfo>> thor_worker_t::get_path(PathAlgorithm*
 
     path_algorithm->Clear();
     cost->set_pass(1);
-    const bool using_bd = path_algorithm == &bidir_astar;
+    const bool using_bd = path_algorithm == bidirectional;
     cost->RelaxHierarchyLimits(using_bd);
     cost->set_allow_destination_only(true);
     cost->set_allow_conditional_destination(true);
     path_algorithm->set_not_thru_pruning(false);
     // Get the best path. Return if not empty (else return the original path)
     auto relaxed_paths =
-        path_algorithm->GetBestPath(origin, destination, *reader, mode_costing, mode, options);
+        path_algorithm->GetBestPath(origin, destination, graph_reader, costings, mode, options);
     if (!relaxed_paths.empty()) {
       return relaxed_paths;
     }
@@ -601,14 +622,12 @@ void thor_worker_t::path_depart_at(Api& api, const std::string& costing) {
   bool used_bidir = false;
   bool add_hierarchy_limits_warning = false;
 
-  graph_tile_ptr tile = nullptr;
-  auto route_two_locations = [&, this](auto& origin, auto& destination) -> bool {
+  // Picks the algorithm for a location pair and sets the hierarchy limits it uses on the costing
+  auto choose_path_algorithm = [&, this](const auto& origin, const auto& destination) {
     // Get the algorithm type for this location pair
     thor::PathAlgorithm* path_algorithm =
-        this->get_path_algorithm(costing, *origin, *destination, options);
+        this->get_path_algorithm(costing, origin, destination, options);
     path_algorithm->Clear();
-    algorithms.push_back(path_algorithm->name());
-    LOG_INFO(std::string("algorithm::") + path_algorithm->name());
 
     // once we know which algorithm will be used, set the hierarchy limits accordingly
     bool is_bidir = path_algorithm == &bidir_astar;
@@ -628,15 +647,78 @@ void thor_worker_t::path_depart_at(Api& api, const std::string& costing) {
     // ..and mark hierarchy limits for this algorithm as checked
     is_bidir ? (used_bidir = true) : (used_unidir = true);
     mode_costing[static_cast<uint32_t>(mode)]->SetHierarchyLimits(hierarchy_limits);
+    return path_algorithm;
+  };
 
-    // If we are continuing through a location we need to make sure we
-    // only allow the edge that was used previously (avoid u-turns)
-    if (is_through_point(*origin) && last_edge.Is_Valid()) {
-      remove_path_edges(*origin,
-                        [&last_edge](const auto& edge) { return edge.graph_id() != last_edge; });
+  auto correlated = options.locations();
+
+  // When nothing carries over from one leg to the next, no time and no through locations, and
+  // there are workers for it, we find the paths of all the legs at once up front
+  std::vector<std::vector<std::vector<PathInfo>>> leg_paths;
+  std::vector<PathAlgorithm*> leg_algorithms;
+  bool independent_legs =
+      !leg_workers.empty() && options.action() == Options::route && correlated.size() > 2 &&
+      costing != "multimodal" && costing != "transit" && costing != "bikeshare" &&
+      std::all_of(correlated.begin(), correlated.end(),
+                  [](const valhalla::Location& l) { return l.date_time().empty(); }) &&
+      std::none_of(std::next(correlated.begin()), std::prev(correlated.end()), is_through_point);
+  if (independent_legs) {
+    std::vector<std::vector<HierarchyLimits>> leg_limits;
+    for (auto destination = std::next(correlated.begin()); destination != correlated.end();
+         ++destination) {
+      leg_algorithms.push_back(choose_path_algorithm(*std::prev(destination), *destination));
+      leg_limits.push_back(mode_costing[static_cast<uint32_t>(mode)]->GetHierarchyLimits());
+    }
+    leg_paths = get_leg_paths(options, costing, leg_algorithms, leg_limits);
+
+    // how many legs were found concurrently, none if they fell back to the serial search
+    auto* concurrent = api.mutable_info()->mutable_statistics()->Add();
+    concurrent->set_key(Options_Action_Enum_Name(options.action()) +
+                        ".info.thor.concurrent_legs");
+    concurrent->set_value(leg_paths.size());
+    concurrent->set_type(gauge);
+  }
+
+  // Routes without a time can continue the tree of an earlier route from the same origin
+  bool use_sessions = max_route_sessions > 0 && options.action() == Options::route &&
+                      options.alternates() == 0 && costing != "multimodal" &&
+                      costing != "transit" && costing != "bikeshare";
+
+  graph_tile_ptr tile = nullptr;
+  auto route_two_locations = [&, this](auto& origin, auto& destination) -> bool {
+    std::vector<std::vector<PathInfo>> temp_paths;
+    if (!leg_paths.empty()) {
+      // We already have this legs path
+      auto leg = std::distance(correlated.begin(), origin);
+      algorithms.push_back(leg_algorithms[leg]->name());
+      LOG_INFO(std::string("algorithm::") + leg_algorithms[leg]->name());
+      temp_paths = std::move(leg_paths[leg]);
+    } else {
+      thor::PathAlgorithm* path_algorithm = choose_path_algorithm(*origin, *destination);
+
+      // If we are continuing through a location we need to make sure we
+      // only allow the edge that was used previously (avoid u-turns)
+      if (is_through_point(*origin) && last_edge.Is_Valid()) {
+        remove_path_edges(*origin,
+                          [&last_edge](const auto& edge) { return edge.graph_id() != last_edge; });
+      }
+
+      // Try the route session of the origin first, it leaves anything it can't do to the path
+      // algorithm
+      if (use_sessions && origin->date_time().empty() && destination->date_time().empty()) {
+        temp_paths = get_session_path(api, *origin, *destination, costing);
+      }
+      if (!temp_paths.empty()) {
+        algorithms.push_back("route_session");
+        LOG_INFO("algorithm::route_session");
+      } else {
+        algorithms.push_back(path_algorithm->name());
+        LOG_INFO(std::string("algorithm::") + path_algorithm->name());
+
+        // Get best path and keep it
+        temp_paths = this->get_path(path_algorithm, *origin, *destination, costing, options);
+      }
     }
-    // Get best path and keep it
-    auto temp_paths = this->get_path(path_algorithm, *origin, *destination, costing, options);
     if (temp_paths.empty())
       return false;
 
@@ -721,7 +803,6 @@ void thor_worker_t::path_depart_at(Api& api, const std::string& costing) {
     return true;
   };
 
-  auto correlated = options.locations();
   bool allow_retry = true;
 
   // For each pair of locations
@@ -769,5 +850,154 @@ void thor_worker_t::path_depart_at(Api& api, const std::string& costing) {
   // assign changed locations
   *api.mutable_options()->mutable_locations() = std::move(correlated);
 }
+
+std::vector<std::vector<std::vector<PathInfo>>>
+thor_worker_t::get_leg_paths(const Options& options,
+                             const std::string& costing,
+                             const std::vector<PathAlgorithm*>& algorithms,
+                             const std::vector<std::vector<HierarchyLimits>>& limits) {
+  // the interrupt is only ever called by one thread at a time
+  std::mutex interrupt_lock;
+  std::function<void()> leg_interrupt = [this, &interrupt_lock]() {
+    if (interrupt) {
+      std::lock_guard<std::mutex> lock(interrupt_lock);
+      (*interrupt)();
+    }
+  };
+
+  // a fresh costing for each worker, made here because the factory isnt meant for threads
+  auto thread_count = std::min(leg_workers.size(), algorithms.size());
+  for (size_t i = 0; i < thread_count; ++i) {
+    leg_workers[i]->mode_costing = factory.CreateModeCosting(options, leg_workers[i]->mode);
+    leg_workers[i]->reader.SetInterrupt(&leg_interrupt);
+  }
+
+  // each worker takes the next leg until they are done or one of them needs the serial search
+  std::vector<std::vector<std::vector<PathInfo>>> leg_paths(algorithms.size());
+  std::atomic<size_t> next_leg{0};
+  std::atomic<bool> serial{false};
+  auto find_legs = [&](leg_worker_t& worker) {
+    try {
+      for (size_t leg = next_leg++; leg < algorithms.size() && !serial; leg = next_leg++) {
+        PathAlgorithm* path_algorithm = &worker.timedep_forward;
+        if (algorithms[leg] == &bidir_astar)
+          path_algorithm = &worker.bidir_astar;
+        path_algorithm->Clear();
+        path_algorithm->set_interrupt(&leg_interrupt);
+        auto& cost = worker.mode_costing[static_cast<uint32_t>(mode)];
+        cost->SetHierarchyLimits(limits[leg]);
+
+        // a second pass adds candidates to the locations, which are copies here, and relaxes the
+        // costing for all the legs after it. a failure is retried with fewer candidates. neither
+        // is something the legs can do independently
+        auto origin = options.locations(leg);
+        auto destination = options.locations(leg + 1);
+        leg_paths[leg] = get_path(path_algorithm, origin, destination, costing, options, &worker);
+        if (leg_paths[leg].empty() || cost->pass() != 0)
+          serial = true;
+      }
+    } catch (...) {
+      // the serial search will run into the same problem and report it the way it always has
+      serial = true;
+    }
+  };
+
+  for (size_t i = 1; i < thread_count; ++i) {
+    leg_workers[i]->start([&find_legs, &worker = *leg_workers[i]]() { find_legs(worker); });
+  }
+  find_legs(*leg_workers[0]);
+  for (size_t i = 1; i < thread_count; ++i) {
+    leg_workers[i]->wait();
+  }
+
+  for (size_t i = 0; i < thread_count; ++i) {
+    leg_workers[i]->bidir_astar.set_interrupt(nullptr);
+    leg_workers[i]->timedep_forward.set_interrupt(nullptr);
+    leg_workers[i]->reader.SetInterrupt(nullptr);
+  }
+  if (serial)
+    leg_paths.clear();
+  return leg_paths;
+}
+
+std::vector<std::vector<thor::PathInfo>>
+thor_worker_t::get_session_path(Api& api,
+                                const valhalla::Location& origin,
+                                const valhalla::Location& destination,
+                                const std::string& costing) {
+  auto now = std::chrono::steady_clock::now();
+  expire_route_sessions(now);
+
+  const auto& options = api.options();
+  const auto& action = Options_Action_Enum_Name(options.action());
+  auto& session = get_route_session(origin, options, now);
+  auto* reused = api.mutable_info()->mutable_statistics()->Add();
+  reused->set_key(action + ".info.thor.route_session_reused_labels");
+  reused->set_value(session.tree->label_count());
+  reused->set_type(gauge);
+
+  std::vector<std::vector<thor::PathInfo>> paths;
+  auto path = session.tree->GetBestPath(destination, *reader, route_session_max_labels);
+
+  // get_path would give a short pedestrian route with a ferry a second pass, leave it to that
+  bool ped_second_pass = false;
+  if (!path.empty() && costing == "pedestrian" &&
+      mode_costing[static_cast<uint32_t>(mode)]->AllowMultiPass()) {
+    float d = PointLL(origin.ll().lng(), origin.ll().lat())
+                  .Distance(PointLL(destination.ll().lng(), destination.ll().lat()));
+    graph_tile_ptr tile;
+    ped_second_pass = d < kPedestrianMultipassThreshold &&
+                      std::any_of(path.begin(), path.end(), [this, &tile](const PathInfo& p) {
+                        const auto* edge = reader->directededge(p.edgeid, tile);
+                        return edge && edge->use() == Use::kFerry;
+                      });
+  }
+  if (!path.empty() && !ped_second_pass) {
+    paths.push_back(std::move(path));
+  }
+
+  auto* sessions = api.mutable_info()->mutable_statistics()->Add();
+  sessions->set_key(action + ".info.thor.route_sessions");
+  sessions->set_value(route_sessions.size());
+  sessions->set_type(gauge);
+  return paths;
+}
+
+thor_worker_t::route_session_t&
+thor_worker_t::get_route_session(const valhalla::Location& origin,
+                                 const Options& options,
+                                 const std::chrono::steady_clock::time_point& now) {
+  // Move the session of this origin and costing to the front or start a new one there
+  auto key = route_session_key(origin, options);
+  auto session = std::find_if(route_sessions.begin(), route_sessions.end(),
+                              [&key](const route_session_t& s) { return s.key == key; });
+  if (session != route_sessions.end()) {
+    route_sessions.splice(route_sessions.begin(), route_sessions, session);
+  } else {
+    if (route_sessions.size() >= max_route_sessions) {
+      route_sessions.pop_back();
+    }
+
+    // The session gets a costing of its own as the one of the request changes between passes.
+    // It is the one of the first pass, which keeps out of destination only areas
+    auto cost = factory.Create(options);
+    cost->set_pass(0);
+    cost->set_allow_destination_only(false);
+    cost->set_allow_conditional_destination(false);
+    route_sessions.push_front({std::move(key), now, std::make_unique<RouteSession>()});
+    route_sessions.front().tree->Start(origin, *reader, cost, cost->travel_mode());
+  }
+
+  auto& front = route_sessions.front();
+  front.last_used = now;
+  return front;
+}
+
+void thor_worker_t::expire_route_sessions(const std::chrono::steady_clock::time_point& now) {
+  // The least recently used sessions are at the back
+  while (!route_sessions.empty() && now - route_sessions.back().last_used > route_session_ttl) {
+    route_sessions.pop_back();
+  }
+}
 } // namespace thor
 } // namespace valhalla
@@ -0,0 +1,170 @@
+#include "thor/route_session.h"
+#include "midgard/logging.h"
+#include <algorithm>
+#include <limits>
+
+using namespace valhalla::baldr;
+using namespace valhalla::sif;
+
+namespace {
+
+// Sessions are kept around between requests so they start out small and grow as needed
+constexpr uint32_t kRouteSessionLabelReservation = 16384;
+
+// A candidate edge of the destination with what is left to subtract from the cost of its label,
+// which covers the whole edge, to get the cost of reaching the destination along it
+struct destination_edge_t {
+  GraphId edgeid;
+  float distance;
+  Cost remaining_cost;
+  float remaining_length;
+};
+
+} // namespace
+
+namespace valhalla {
+namespace thor {
+
+RouteSession::RouteSession(const boost::property_tree::ptree& config)
+    : Dijkstras(config) {
+  max_reserved_labels_count_ = std::min(max_reserved_labels_count_, kRouteSessionLabelReservation);
+}
+
+void RouteSession::GetExpansionHints(uint32_t& bucket_count,
+                                     uint32_t& edge_label_reservation) const {
+  bucket_count = 20000;
+  edge_label_reservation = kRouteSessionLabelReservation;
+}
+
+void RouteSession::Start(const valhalla::Location& origin,
+                         GraphReader& reader,
+                         const cost_ptr_t& costing,
+                         const sif::TravelMode mode) {
+  Clear();
+
+  // Set the mode and costing
+  mode_ = mode;
+  costing_ = costing;
+  access_mode_ = costing_->access_mode();
+
+  // Seed the adjacency list with the origin edges
+  Initialize(bdedgelabels_, adjacencylist_, costing_->UnitSize());
+  origin_.Clear();
+  origin_.Add()->CopyFrom(origin);
+  SetOriginLocations(reader, origin_, costing_);
+}
+
+std::vector<PathInfo> RouteSession::GetBestPath(const valhalla::Location& destination,
+                                                GraphReader& reader,
+                                                const uint32_t max_labels) {
+  // Only skip outbound edges if we have other options
+  const auto& edges = destination.correlation().edges();
+  bool has_other_edges = std::any_of(edges.begin(), edges.end(),
+                                     [](const valhalla::PathEdge& e) { return !e.begin_node(); });
+
+  // Work out how much of each destination edge is not traversed to get to the destination
+  std::vector<destination_edge_t> destinations;
+  for (const auto& edge : edges) {
+    if (has_other_edges && edge.begin_node()) {
+      continue;
+    }
+
+    GraphId edgeid(edge.graph_id());
+    if (costing_->AvoidAsDestinationEdge(edgeid, edge.percent_along())) {
+      continue;
+    }
+    graph_tile_ptr tile = reader.GetGraphTile(edgeid);
+    if (tile == nullptr) {
+      continue;
+    }
+    const DirectedEdge* directededge = tile->directededge(edgeid);
+
+    // Getting to a destination behind the origin on the same edge means going around the block,
+    // the tree only has one label per edge so that path is left to the regular path algorithms
+    for (const auto& origin_edge : origin_.Get(0).correlation().edges()) {
+      if (origin_edge.graph_id() == edge.graph_id() &&
+          origin_edge.percent_along() > edge.percent_along()) {
+        return {};
+      }
+    }
+
+    uint8_t flow_sources;
+    float remaining = 1.0f - edge.percent_along();
+    Cost edge_cost = costing_->EdgeCost(directededge, tile, TimeInfo::invalid(), flow_sources);
+    destinations.push_back({edgeid, static_cast<float>(edge.distance()), edge_cost * remaining,
+                            directededge->length() * remaining});
+  }
+
+  uint32_t best_label = kInvalidLabel;
+  const destination_edge_t* best_destination = nullptr;
+  Cost best_cost{std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+  while (true) {
+    // The cost of every destination edge that has a label can only go down to the cost of what is
+    // settled next. Edges which don't have a label yet can't be reached for less than that either
+    for (const auto& dest : destinations) {
+      auto status = edgestatus_.Get(dest.edgeid);
+      if (status.set() == EdgeSet::kUnreachedOrReset) {
+        continue;
+      }
+      Cost cost = bdedgelabels_[status.index()].cost() - dest.remaining_cost;
+      cost.cost += dest.distance;
+      if (cost.cost < best_cost.cost) {
+        best_label = status.index();
+        best_destination = &dest;
+        best_cost = cost;
+      }
+    }
+
+    // Get next element from adjacency list. Check that it is valid. An
+    // invalid label indicates there are no edges that can be expanded.
+    uint32_t predindex = adjacencylist_.pop();
+    if (predindex == kInvalidLabel) {
+      break;
+    }
+
+    // Once nothing left to settle can beat the best path we are done, the label goes back on the
+    // adjacency list for the next destination to pick up from
+    if (bdedgelabels_[predindex].sortcost() >= best_cost.cost) {
+      adjacencylist_.add(predindex);
+      break;
+    }
+
+    // Don't let the tree outgrow its memory limit, whatever is in it can still be used later on
+    if (bdedgelabels_.size() >= max_labels) {
+      adjacencylist_.add(predindex);
+      LOG_DEBUG("route_session::label limit reached");
+      return {};
+    }
+
+    // Copy the EdgeLabel for use in costing and settle the edge.
+    BDEdgeLabel pred = bdedgelabels_[predindex];
+    edgestatus_.Update(pred.edgeid(), EdgeSet::kPermanent, pred.path_id());
+
+    // Expand from the end node in the forward direction
+    ExpandInner<ExpansionType::forward>(reader, pred.endnode(), pred, predindex, nullptr, false,
+                                        TimeInfo::invalid());
+  }
+
+  if (best_label == kInvalidLabel) {
+    return {};
+  }
+
+  // Work backwards from the destination
+  std::vector<PathInfo> path;
+  for (auto edgelabel_index = best_label; edgelabel_index != kInvalidLabel;
+       edgelabel_index = bdedgelabels_[edgelabel_index].predecessor()) {
+    const auto& edgelabel = bdedgelabels_[edgelabel_index];
+    path.emplace_back(edgelabel.mode(), edgelabel.cost(), edgelabel.edgeid(), 0,
+                      edgelabel.path_distance(), edgelabel.restriction_idx(),
+                      edgelabel.transition_cost());
+  }
+  std::reverse(path.begin(), path.end());
+
+  // The last edge is only traversed up to the destination
+  path.back().elapsed_cost = best_cost;
+  path.back().path_distance -= best_destination->remaining_length;
+  return path;
+}
+
+} // namespace thor
+} // namespace valhalla
@@ -3,6 +3,7 @@
 
 #include "baldr/datetime.h"
 #include "midgard/logging.h"
+#include "midgard/tracing.h"
 #include "thor/timedistancematrix.h"
 
 using namespace valhalla::baldr;
@@ -189,6 +190,7 @@ template <const ExpansionType expansion_direction, const bool FORWARD>
 bool TimeDistanceMatrix::ComputeMatrix(Api& request,
                                        baldr::GraphReader& graphreader,
                                        const float max_matrix_distance) {
+  VALHALLA_TRACE_SCOPE("thor", "timedistancematrix");
   bool invariant = request.options().date_time_type() == Options::invariant;
   uint32_t matrix_locations = request.options().matrix_locations();
 
@@ -209,6 +211,7 @@ bool TimeDistanceMatrix::ComputeMatrix(Api& request,
                      costing_->pass());
 
   for (int origin_index = 0; origin_index < origins.size(); ++origin_index) {
+    VALHALLA_TRACE_SCOPE("thor", "timedistancematrix_origin");
     // reserve some space for the next dijkstras (will be cleared at the end of the loop)
     edgelabels_.reserve(max_reserved_labels_count_);
     auto& origin = origins.Get(origin_index);
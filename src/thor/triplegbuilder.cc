@@ -19,6 +19,7 @@
 #include "midgard/encoded.h"
 #include "midgard/logging.h"
 #include "midgard/pointll.h"
+#include "midgard/tracing.h"
 #include "midgard/util.h"
 #include "proto/common.pb.h"
 #include "sif/costconstants.h"
@@ -40,6 +41,43 @@ constexpr uint8_t kNotTagged = 0;
 constexpr uint8_t kTunnelTag = static_cast<uint8_t>(baldr::TaggedValue::kTunnel);
 constexpr uint8_t kBridgeTag = static_cast<uint8_t>(baldr::TaggedValue::kBridge);
 
+/**
+ * Which of the tile lookups and decodes that go into a trip leg are needed at all, worked out once
+ * per leg rather than per edge. Legs which get narrated need whatever guidance uses regardless of
+ * the attribute filters. Legs for trace_attributes are only serialized, so they skip everything
+ * that feeds none of the attributes that were asked for.
+ */
+struct BuildPlan {
+  BuildPlan(const valhalla::Options& options, const AttributesController& controller) {
+    const bool narrated = options.action() != valhalla::Options::trace_attributes;
+    shape_attributes = controller.category_attribute_enabled(kShapeAttributesCategory);
+    shape = narrated || shape_attributes || controller(kShape) || controller(kIncidents) ||
+            controller(kEdgeBeginShapeIndex) || controller(kEdgeEndShapeIndex) ||
+            controller(kEdgeBeginHeading) || controller(kEdgeEndHeading) ||
+            controller(kEdgeLandmarks);
+    levels = shape || controller(kEdgeLevels);
+    edge_signs = narrated || controller(kEdgeSignExitNumber) || controller(kEdgeSignExitBranch) ||
+                 controller(kEdgeSignExitToward) || controller(kEdgeSignExitName) ||
+                 controller(kEdgeSignGuideBranch) || controller(kEdgeSignGuideToward) ||
+                 controller(kEdgeSignGuidanceViewJunction) ||
+                 controller(kEdgeSignGuidanceViewSignboard);
+    junction_names = narrated || controller(kEdgeSignJunctionName);
+    intersecting_edges = narrated || controller.category_attribute_enabled(kNodeCategory);
+  }
+
+  // the shape of the leg along with everything that is indexed into it
+  bool shape;
+  // the per shape point attributes, which cut the shape further
+  bool shape_attributes;
+  // the levels of the edges, the level changes along the leg are indexed into the shape
+  bool levels;
+  // the signs of the edges and the junction names at the nodes they start from
+  bool edge_signs;
+  bool junction_names;
+  // the other edges at each node and the opposing edge of the path they are compared against
+  bool intersecting_edges;
+};
+
 uint32_t
 GetAdminIndex(const AdminInfo& admin_info,
               std::unordered_map<AdminInfo, uint32_t, AdminInfo::AdminInfoHasher>& admin_info_map,
@@ -168,6 +206,7 @@ valhalla::TripLeg_Closure* fetch_or_create_closure_annotation(TripLeg& leg) {
  * and where incidents occur along the edge. Also sets the various per shape point attributes
  * such as time, distance, speed. Also updates the incidents list on the edge with their shape indices
  * @param controller
+ * @param plan
  * @param tile
  * @param edge
  * @param shape
@@ -180,6 +219,7 @@ valhalla::TripLeg_Closure* fetch_or_create_closure_annotation(TripLeg& leg) {
  * @param incidents
  */
 void SetShapeAttributes(const AttributesController& controller,
+                        const BuildPlan& plan,
                         const graph_tile_ptr& tile,
                         const graph_tile_ptr& end_node_tile,
                         const DirectedEdge* edge,
@@ -194,14 +234,12 @@ void SetShapeAttributes(const AttributesController& controller,
   // TODO: if this is a transit edge then the costing will throw
 
   // bail if nothing to do
-  if (!cut_for_traffic && incidents.start_index == incidents.end_index &&
-      !controller.category_attribute_enabled(kShapeAttributesCategory)) {
+  if (!cut_for_traffic && incidents.start_index == incidents.end_index && !plan.shape_attributes) {
     return;
   }
 
   // initialize shape_attributes once
-  if (!leg.has_shape_attributes() &&
-      controller.category_attribute_enabled(kShapeAttributesCategory)) {
+  if (!leg.has_shape_attributes() && plan.shape_attributes) {
     leg.mutable_shape_attributes();
   }
 
@@ -1038,6 +1076,7 @@ void ProcessTunnelBridgeTaggedValue(valhalla::StreetName* trip_edge_name,
 /**
  * Add trip edge. (TODO more comments)
  * @param  controller         Controller to determine which attributes to set.
+ * @param  plan               Which lookups and decodes are needed for the attributes.
  * @param  edge               Identifier of an edge within the tiled, hierarchical graph.
  * @param  edge_itr           PathInfo iterator
  * @param  block_id           Transit block Id (0 if not a transit edge)
@@ -1056,6 +1095,7 @@ void ProcessTunnelBridgeTaggedValue(valhalla::StreetName* trip_edge_name,
  * @param  levels             level information of the edge
  */
 TripLeg_Edge* AddTripEdge(const AttributesController& controller,
+                          const BuildPlan& plan,
                           const GraphId& edge,
                           const std::vector<valhalla::thor::PathInfo>::const_iterator& edge_itr,
                           const uint32_t block_id,
@@ -1129,7 +1169,7 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
 #endif
 
   // Set the signs (if the directed edge has sign information) and if requested
-  if (directededge->sign()) {
+  if (plan.edge_signs && directededge->sign()) {
     // Add the edge signs
     LinguisticMap linguistics;
     std::vector<SignInfo> edge_signs = graphtile->GetSigns(idx, linguistics);
@@ -1140,7 +1180,7 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
   }
 
   // Process the named junctions at nodes
-  if (has_junction_name && start_tile) {
+  if (plan.junction_names && has_junction_name && start_tile) {
     // Add the node signs
     LinguisticMap linguistics;
     std::vector<SignInfo> node_signs = start_tile->GetSigns(start_node_idx, linguistics, true);
@@ -1688,6 +1728,7 @@ void TripLegBuilder::Build(
     const std::function<void()>* interrupt_callback,
     const std::unordered_map<size_t, std::pair<EdgeTrimmingInfo, EdgeTrimmingInfo>>& edge_trimming,
     const std::vector<valhalla::Location>& intermediates) {
+  VALHALLA_TRACE_SCOPE("thor", "trip_leg_builder");
   // Test interrupt prior to building trip path
   if (interrupt_callback) {
     (*interrupt_callback)();
@@ -1696,6 +1737,9 @@ void TripLegBuilder::Build(
   // Remember what algorithms were used to create this leg
   *trip_path.mutable_algorithms() = {algorithms.begin(), algorithms.end()};
 
+  // Work out what the requested attributes need looked up and decoded
+  const BuildPlan plan(options, controller);
+
   // Set origin, any through locations, and destination. Origin and
   // destination are assumed to be breaks.
   CopyLocations(trip_path, origin, intermediates, dest, path_begin, path_end);
@@ -1903,19 +1947,23 @@ void TripLegBuilder::Build(
     multimodal_builder.Build(trip_node, edge_itr->trip_id, node, startnode, directededge, edge,
                              start_tile, graphtile, mode_costing, controller, graphreader);
 
-    uint32_t begin_index = is_first_edge ? 0 : trip_shape.size() - 1;
+    uint32_t begin_index = is_first_edge || trip_shape.empty() ? 0 : trip_shape.size() - 1;
     auto edgeinfo = graphtile->edgeinfo(directededge);
-    std::pair<std::vector<std::pair<float, float>>, uint32_t> levels = edgeinfo.levels();
+    std::pair<std::vector<std::pair<float, float>>, uint32_t> levels;
+    if (plan.levels) {
+      levels = edgeinfo.levels();
+    }
     // Add edge to the trip node and set its attributes
     TripLeg_Edge* trip_edge =
-        AddTripEdge(controller, edge, edge_itr, multimodal_builder.block_id, mode, travel_type,
-                    costing, directededge, node->drive_on_right(), trip_node, graphtile, time_info,
-                    startnode.id(), node->named_intersection(), start_tile,
+        AddTripEdge(controller, plan, edge, edge_itr, multimodal_builder.block_id, mode,
+                    travel_type, costing, directededge, node->drive_on_right(), trip_node,
+                    graphtile, time_info, startnode.id(), node->named_intersection(), start_tile,
                     travel_type == PedestrianType::kBlind && mode == sif::TravelMode::kPedestrian,
                     edgeinfo, levels);
 
     // for the level changes, only consider edges on a single level
-    if (levels.first.size() == 1 && levels.first[0].first == levels.first[0].second) {
+    if (plan.shape && levels.first.size() == 1 &&
+        levels.first[0].first == levels.first[0].second) {
       float lvl = levels.first[0].first;
       // if this edge is on a different level than the previous one,
       // add a level change
@@ -1933,9 +1981,18 @@ void TripLegBuilder::Build(
     float trim_end_pct = is_last_edge ? end_pct : 1;
 
     // Some edges at the beginning and end of the path and at intermediate locations will need trimmed
-    auto trimming = edge_trimming.end();
-    if (!edge_trimming.empty() &&
-        (trimming = edge_trimming.find(edge_index)) != edge_trimming.end()) {
+    auto trimming = edge_trimming.empty() ? edge_trimming.end() : edge_trimming.find(edge_index);
+    if (!plan.shape) {
+      // Without the shape only the portion of the edge that is used matters
+      if (trimming != edge_trimming.end()) {
+        if (trimming->second.first.trim) {
+          trim_start_pct = trimming->second.first.distance_along;
+        }
+        if (trimming->second.second.trim) {
+          trim_end_pct = trimming->second.second.distance_along;
+        }
+      }
+    } else if (trimming != edge_trimming.end()) {
       // Get edge shape and reverse it if directed edge is not forward.
       auto edge_shape = edgeinfo.shape();
       if (!directededge->forward()) {
@@ -2023,7 +2080,8 @@ void TripLegBuilder::Build(
     // we need to reset to the shape index then increment the iterator
     if (intermediate_itr != trip_path.mutable_location()->end() &&
         intermediate_itr->correlation().leg_shape_index() == edge_index) {
-      intermediate_itr->mutable_correlation()->set_leg_shape_index(trip_shape.size() - 1);
+      intermediate_itr->mutable_correlation()->set_leg_shape_index(
+          trip_shape.empty() ? 0 : trip_shape.size() - 1);
       intermediate_itr->mutable_correlation()->set_distance_from_leg_origin(total_distance);
       // NOTE:
       // So for intermediate locations that dont have any trimming we know they occur at the node
@@ -2053,11 +2111,13 @@ void TripLegBuilder::Build(
     auto incidents = controller(kIncidents) ? graphreader.GetIncidents(edge_itr->edgeid, graphtile)
                                             : valhalla::baldr::IncidentResult{};
 
-    graph_tile_ptr end_node_tile = graphtile;
-    graphreader.GetGraphTile(directededge->endnode(), end_node_tile);
-    SetShapeAttributes(controller, graphtile, end_node_tile, directededge, trip_shape, begin_index,
-                       trip_path, trim_start_pct, trim_end_pct, edge_seconds,
-                       costing->flow_mask() & kCurrentFlowMask, incidents);
+    if (plan.shape) {
+      graph_tile_ptr end_node_tile = graphtile;
+      graphreader.GetGraphTile(directededge->endnode(), end_node_tile);
+      SetShapeAttributes(controller, plan, graphtile, end_node_tile, directededge, trip_shape,
+                         begin_index, trip_path, trim_start_pct, trim_end_pct, edge_seconds,
+                         costing->flow_mask() & kCurrentFlowMask, incidents);
+    }
 
     // Set begin shape index if requested
     if (controller(kEdgeBeginShapeIndex)) {
@@ -2084,7 +2144,7 @@ void TripLegBuilder::Build(
 
     // Add the intersecting edges at the node. Skip it if the node was an inner node (excluding start
     // node and end node) of a shortcut that was recovered.
-    if (startnode.Is_Valid() && !edge_itr->start_node_is_recovered) {
+    if (plan.intersecting_edges && startnode.Is_Valid() && !edge_itr->start_node_is_recovered) {
       AddIntersectingEdges(controller, start_tile, node, directededge, prev_de, prior_opp_local_index,
                            graphreader, trip_node,
                            travel_type == PedestrianType::kBlind &&
@@ -2097,7 +2157,7 @@ void TripLegBuilder::Build(
     startnode = directededge->endnode();
 
     // Save the opposing edge as the previous DirectedEdge (for name consistency)
-    if (!directededge->IsTransitLine()) {
+    if (plan.intersecting_edges && !directededge->IsTransitLine()) {
       graph_tile_ptr t2 =
           directededge->leaves_tile() ? graphreader.GetGraphTile(directededge->endnode()) : graphtile;
       if (t2 == nullptr) {
@@ -2145,7 +2205,9 @@ void TripLegBuilder::Build(
   AssignAdmins(controller, trip_path, admin_info_list);
 
   // Set the bounding box of the shape
-  SetBoundingBox(trip_path, trip_shape);
+  if (plan.shape) {
+    SetBoundingBox(trip_path, trip_shape);
+  }
 
   // Set shape if requested
   if (controller(kShape)) {
@@ -3,6 +3,7 @@
 #include "baldr/graphconstants.h"
 #include "midgard/constants.h"
 #include "midgard/logging.h"
+#include "midgard/tracing.h"
 #include "worker.h"
 #include <algorithm>
 
@@ -122,8 +123,7 @@ bool UnidirectionalAStar<expansion_direction, FORWARD>::Expand(GraphReader& grap
         continue;
       }
       // setup for expansion at this level
-      hierarchy_limits_[node.level()].set_up_transition_count(
-          hierarchy_limits_[node.level()].up_transition_count() + trans->up());
+      hierarchy_limits_[node.level()].up_transition_count += trans->up();
       const auto* trans_node = trans_tile->node(trans->endnode());
       EdgeMetadata trans_meta =
           EdgeMetadata::make(trans->endnode(), trans_node, trans_tile, edgestatus_);
@@ -449,6 +449,7 @@ std::vector<std::vector<PathInfo>> UnidirectionalAStar<expansion_direction, FORW
     const sif::mode_costing_t& mode_costing,
     const travel_mode_t mode,
     const Options& /*options*/) {
+  VALHALLA_TRACE_SCOPE("thor", "unidirectional_a*");
   // Set the mode and costing
   mode_ = mode;
   costing_ = mode_costing[static_cast<uint32_t>(mode_)];
@@ -595,7 +596,7 @@ void UnidirectionalAStar<expansion_direction, FORWARD>::Init(const midgard::Poin
 
   // Get hierarchy limits from the costing. Get a copy since we increment
   // transition counts (i.e., this is not a const reference).
-  hierarchy_limits_ = costing_->GetHierarchyLimits();
+  hierarchy_limits_ = ToHierarchyLimitStates(costing_->GetHierarchyLimits());
 }
 
 // Modulate the hierarchy expansion within distance based on density at
@@ -629,7 +630,7 @@ void UnidirectionalAStar<expansion_direction, FORWARD>::ModifyHierarchyLimits(
     factor *= f;
   }*/
   // TODO - just arterial for now...investigate whether to alter local as well
-  hierarchy_limits_[1].set_expand_within_dist(hierarchy_limits_[1].expand_within_dist() * factor);
+  hierarchy_limits_[1].expand_within_dist *= factor;
 }
 
 // Add an edge at the origin to the adjacency list
@@ -28,6 +28,9 @@ namespace {
 // route starts to become suspect (due to user breaks and other factors).
 constexpr float kDefaultMaxTimeDependentDistance = 500000.0f; // 500 km
 
+// the sub phase making the costing of a request is timed as
+const std::string kCosting = "costing";
+
 // Maximum edge score - base this on costing type.
 // Large values can cause very bad performance. Setting this back
 // to 2 hours for bike and pedestrian and 12 hours for driving routes.
@@ -69,6 +72,7 @@ thor_worker_t::thor_worker_t(const boost::property_tree::ptree& config,
       timedep_reverse(config.get_child("thor")), costmatrix_(config.get_child("thor")),
       time_distance_matrix_(config.get_child("thor")),
       time_distance_bss_matrix_(config.get_child("thor")), isochrone_gen(config.get_child("thor")),
+      matrix_cost_model(config.get_child_optional("thor.matrix_cost_model")),
       reader(graph_reader ? graph_reader
                           : std::make_shared<baldr::GraphReader>(config.get_child("mjolnir"))),
       matcher_factory(config, reader), controller{},
@@ -113,6 +117,17 @@ thor_worker_t::thor_worker_t(const boost::property_tree::ptree& config,
   hierarchy_limits_config_bidirectional_astar =
       parse_hierarchy_limits_from_config(config, "bidirectional_astar", true);
 
+  // one leg worker per thread which can find the legs of a route concurrently
+  auto leg_threads = config.get<size_t>("thor.route_leg_threads", 0);
+  for (size_t i = 0; i < leg_threads; ++i) {
+    leg_workers.emplace_back(std::make_unique<leg_worker_t>(config));
+  }
+
+  // forward trees kept to answer later routes from the same origin
+  max_route_sessions = config.get<size_t>("thor.route_sessions.max_count", 0);
+  route_session_ttl = std::chrono::seconds(config.get<uint32_t>("thor.route_sessions.ttl", 60));
+  route_session_max_labels = config.get<uint32_t>("thor.route_sessions.max_labels", 1000000);
+
   // signal that the worker started successfully
   started();
 }
@@ -120,6 +135,55 @@ thor_worker_t::thor_worker_t(const boost::property_tree::ptree& config,
 thor_worker_t::~thor_worker_t() {
 }
 
+thor_worker_t::leg_worker_t::leg_worker_t(const boost::property_tree::ptree& config)
+    : reader(config.get_child("mjolnir")), bidir_astar(config.get_child("thor")),
+      timedep_forward(config.get_child("thor")), mode(valhalla::sif::TravelMode::kPedestrian),
+      stop(false) {
+}
+
+thor_worker_t::leg_worker_t::~leg_worker_t() {
+  if (thread.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stop = true;
+    }
+    condition.notify_all();
+    thread.join();
+  }
+}
+
+void thor_worker_t::leg_worker_t::start(std::function<void()> next) {
+  if (!thread.joinable()) {
+    thread = std::thread(&leg_worker_t::work, this);
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    job = std::move(next);
+  }
+  condition.notify_all();
+}
+
+void thor_worker_t::leg_worker_t::wait() {
+  std::unique_lock<std::mutex> lock(mutex);
+  condition.wait(lock, [this]() { return !job; });
+}
+
+void thor_worker_t::leg_worker_t::work() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    condition.wait(lock, [this]() { return job || stop; });
+    if (stop) {
+      return;
+    }
+    // the job stays set while it runs so that waiting only ends once it is done
+    lock.unlock();
+    job();
+    lock.lock();
+    job = nullptr;
+    condition.notify_all();
+  }
+}
+
 #ifdef ENABLE_SERVICES
 prime_server::worker_t::result_t
 thor_worker_t::work(const std::list<zmq::message_t>& job,
@@ -129,7 +193,8 @@ thor_worker_t::work(const std::list<zmq::message_t>& job,
   // get request info and make sure to record any metrics before we are done
   auto& info = *static_cast<prime_server::http_request_info_t*>(request_info);
   LOG_INFO("Got Thor Request " + std::to_string(info.id));
-  Api request;
+  // lives in the arena until cleanup
+  auto& request = arena.request();
   prime_server::worker_t::result_t result{true, {}, {}};
   try {
     // crack open the original request
@@ -170,7 +235,10 @@ thor_worker_t::work(const std::list<zmq::message_t>& job,
         result = to_response(trace_attributes(request), info, request);
         break;
       case Options::expansion: {
-        result = to_response(expansion(request), info, request);
+        // collect the response as it is written so the expansion doesn't have to be kept in full
+        std::string response;
+        expansion(request, [&response](std::string_view chunk) { response.append(chunk); });
+        result = to_response(response, info, request);
         break;
       }
       case Options::centroid: {
@@ -234,7 +302,10 @@ std::string thor_worker_t::parse_costing(const Api& request) {
   const auto& options = request.options();
   auto costing = options.costing_type();
   auto costing_str = Costing_Enum_Name(costing);
-  mode_costing = factory.CreateModeCosting(options, mode);
+  {
+    midgard::metrics::scoped_timer_t timer(Options_Action_Enum_Name(options.action()), kCosting);
+    mode_costing = factory.CreateModeCosting(options, mode);
+  }
 
   return costing_str;
 }
@@ -328,10 +399,19 @@ void thor_worker_t::cleanup() {
   time_distance_bss_matrix_.Clear();
   isochrone_gen.Clear();
   centroid_gen.Clear();
+  expire_route_sessions(std::chrono::steady_clock::now());
   matcher_factory.ClearFullCache();
   if (reader->OverCommitted()) {
     reader->Trim();
   }
+  for (auto& leg_worker : leg_workers) {
+    leg_worker->bidir_astar.Clear();
+    leg_worker->timedep_forward.Clear();
+    leg_worker->mode_costing = {};
+    if (leg_worker->reader.OverCommitted()) {
+      leg_worker->reader.Trim();
+    }
+  }
 }
 
 void thor_worker_t::set_interrupt(const std::function<void()>* interrupt_function) {
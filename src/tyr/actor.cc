@@ -1,15 +1,33 @@
 #include "tyr/actor.h"
 #include "baldr/rapidjson_utils.h"
 #include "loki/worker.h"
+#include "midgard/logging.h"
 #include "odin/worker.h"
 #include "thor/worker.h"
 #include "tyr/serializers.h"
 
+#include <atomic>
+#include <thread>
+
 using namespace valhalla;
 using namespace valhalla::loki;
 using namespace valhalla::thor;
 using namespace valhalla::odin;
 
+namespace {
+
+// whether the json request holds a batch of traces rather than a single one, only what could be
+// one is parsed into the document so the batch doesn't have to be parsed again
+bool parse_trace_batch(const std::string& request_str, rapidjson::Document& document) {
+  if (request_str.find("\"traces\"") == std::string::npos) {
+    return false;
+  }
+  document.Parse(request_str.c_str());
+  return !document.HasParseError() && document.IsObject() && document.HasMember("traces");
+}
+
+} // namespace
+
 namespace valhalla {
 namespace tyr {
 
@@ -17,25 +35,74 @@ struct actor_t::pimpl_t {
   pimpl_t(const boost::property_tree::ptree& config)
       : reader(new baldr::GraphReader(config.get_child("mjolnir"))), loki_worker(config, reader),
         thor_worker(config, reader), odin_worker(config) {
+    configure_batches(config);
   }
   pimpl_t(const boost::property_tree::ptree& config, baldr::GraphReader& graph_reader)
       : reader(&graph_reader, [](baldr::GraphReader*) {}), loki_worker(config, reader),
         thor_worker(config, reader), odin_worker(config) {
+    configure_batches(config);
+  }
+  void configure_batches(const boost::property_tree::ptree& config) {
+    batch_threads = config.get<size_t>("meili.batch_threads", 0);
+    max_batch_size = config.get<size_t>("service_limits.trace.max_batch_size", 1000);
+    // the workers of the batch pool share one tile cache and don't have pools of their own
+    if (batch_threads > 0) {
+      batch_config = config;
+      batch_config.put("mjolnir.global_synchronized_cache", true);
+      batch_config.put("meili.batch_threads", 0);
+    }
   }
   void set_interrupts(const std::function<void()>* interrupt_function) {
     loki_worker.set_interrupt(interrupt_function);
     thor_worker.set_interrupt(interrupt_function);
     odin_worker.set_interrupt(interrupt_function);
   }
-  void cleanup() {
+  void cleanup_workers() {
     loki_worker.cleanup();
     thor_worker.cleanup();
     odin_worker.cleanup();
   }
+  void cleanup() {
+    cleanup_workers();
+    arena.reset();
+  }
+  // a request object for callers that don't want one back, whatever the previous one held is freed
+  Api* scratch_request() {
+    arena.reset();
+    return &arena.request();
+  }
+  // runs a single trace request of a batch, the request object is the caller's
+  std::string trace(rapidjson::Document& request,
+                    const Options::Action action,
+                    const std::function<void()>* interrupt,
+                    Api& api) {
+    set_interrupts(interrupt);
+    ParseApi(request, action, api);
+    loki_worker.trace(api);
+    std::string bytes;
+    if (action == Options::trace_route) {
+      thor_worker.trace_route(api);
+      bytes = odin_worker.narrate(api);
+    } else {
+      bytes = thor_worker.trace_attributes(api);
+    }
+    cleanup_workers();
+    return bytes;
+  }
+  std::string trace_batch(rapidjson::Document& document,
+                          const Options::Action action,
+                          const std::function<void()>* interrupt);
   std::shared_ptr<baldr::GraphReader> reader;
   loki::loki_worker_t loki_worker;
   thor::thor_worker_t thor_worker;
   odin_worker_t odin_worker;
+  // backs the request objects made by the actor, reset after every request
+  request_arena_t arena;
+  // the workers which match the traces of a batch concurrently, made for the first batch
+  size_t batch_threads;
+  size_t max_batch_size;
+  boost::property_tree::ptree batch_config;
+  std::vector<std::unique_ptr<pimpl_t>> batch_workers;
 };
 
 actor_t::actor_t(const boost::property_tree::ptree& config, bool auto_cleanup)
@@ -85,14 +152,101 @@ std::string actor_t::act(Api& api, const std::function<void()>* interrupt) {
   }
 }
 
+#ifdef ENABLE_SERVICES
+prime_server::worker_t::result_t actor_t::work(const std::list<zmq::message_t>& job,
+                                               void* request_info,
+                                               const std::function<void()>& interrupt_function) {
+  // grab the request info and make sure to record any metrics before we are done
+  auto& info = *static_cast<prime_server::http_request_info_t*>(request_info);
+  LOG_INFO("Got Tyr Request " + std::to_string(info.id));
+  // the request lives in the arena until cleanup, all the workers share it by pointer
+  auto& request = pimpl->arena.request();
+  prime_server::worker_t::result_t result{false, {}, ""};
+  try {
+    // request parsing
+    auto http_request =
+        prime_server::http_request_t::from_string(static_cast<const char*>(job.front().data()),
+                                                  job.front().size());
+
+    // scrapes of the latency histograms and dumps of the trace points are answered right away
+    if (serve_metrics(http_request, info, result) || serve_trace(http_request, info, result)) {
+      return result;
+    }
+
+    // a batch of traces is split up into a request per trace rather than parsed as one
+    rapidjson::Document document;
+    bool batch = false;
+    if (http_request.path == "/trace_route" || http_request.path == "/trace_attributes") {
+      auto json = http_request.query.find("json");
+      batch = parse_trace_batch(json != http_request.query.end() && !json->second.empty()
+                                    ? json->second.front()
+                                    : http_request.body,
+                                document);
+    }
+
+    if (batch) {
+      request.mutable_info()->set_is_service(true);
+      request.mutable_options()->set_action(http_request.path == "/trace_route"
+                                                ? Options::trace_route
+                                                : Options::trace_attributes);
+      pimpl->loki_worker.check_action(request);
+      result = to_response(pimpl->trace_batch(document, request.options().action(),
+                                              &interrupt_function),
+                           info, request);
+    } else {
+      ParseApi(http_request, request);
+
+      // check there is a valid action
+      pimpl->loki_worker.check_action(request);
+
+      // run all the stages and serialize
+      result = to_response(act(request, &interrupt_function), info, request);
+    }
+  } catch (const valhalla_exception_t& e) {
+    LOG_WARN("400::" + std::string(e.what()) + " request_id=" + std::to_string(info.id));
+    result = serialize_error(e, info, request);
+  } catch (const std::exception& e) {
+    LOG_ERROR("400::" + std::string(e.what()) + " request_id=" + std::to_string(info.id));
+    result = serialize_error({599, std::string(e.what())}, info, request);
+  }
+
+  // the response always goes back to the client from here
+  pimpl->arena.record_statistics(request, "tyr");
+  pimpl->loki_worker.enqueue_statistics(request);
+
+  return result;
+}
+
+void run_service(const boost::property_tree::ptree& config) {
+  // gracefully shutdown when asked via SIGTERM
+  prime_server::quiesce(config.get<unsigned int>("httpd.service.drain_seconds", 28),
+                        config.get<unsigned int>("httpd.service.shutting_seconds", 1));
+
+  // gets requests from the http server
+  auto upstream_endpoint = config.get<std::string>("loki.service.proxy") + "_out";
+  // returns all results back to the server
+  auto loopback_endpoint = config.get<std::string>("httpd.service.loopback");
+  auto interrupt_endpoint = config.get<std::string>("httpd.service.interrupt");
+
+  // listen for requests
+  zmq::context_t context;
+  actor_t actor(config);
+  prime_server::worker_t worker(context, upstream_endpoint, "ipc:///dev/null", loopback_endpoint,
+                                interrupt_endpoint,
+                                std::bind(&actor_t::work, std::ref(actor), std::placeholders::_1,
+                                          std::placeholders::_2, std::placeholders::_3),
+                                std::bind(&actor_t::cleanup, std::ref(actor)));
+  worker.work();
+}
+#endif
+
 std::string
 actor_t::route(const std::string& request_str, const std::function<void()>* interrupt, Api* api) {
   // set the interrupts
   pimpl->set_interrupts(interrupt);
-  // if the caller doesn't want a copy we'll use this dummy
-  Api dummy;
+  // if the caller doesn't want a copy we'll use a scratch one
   if (!api) {
-    api = &dummy;
+    api = pimpl->scratch_request();
   }
   // parse the request
   ParseApi(request_str, Options::route, *api);
@@ -113,10 +267,9 @@ std::string
 actor_t::locate(const std::string& request_str, const std::function<void()>* interrupt, Api* api) {
   // set the interrupts
   pimpl->set_interrupts(interrupt);
-  // if the caller doesn't want a copy we'll use this dummy
-  Api dummy;
+  // if the caller doesn't want a copy we'll use a scratch one
   if (!api) {
-    api = &dummy;
+    api = pimpl->scratch_request();
   }
   // parse the request
   ParseApi(request_str, Options::locate, *api);
@@ -129,21 +282,22 @@ actor_t::locate(const std::string& request_str, const std::function<void()>* int
   return json;
 }
 
-std::string
-actor_t::matrix(const std::string& request_str, const std::function<void()>* interrupt, Api* api) {
+std::string actor_t::matrix(const std::string& request_str,
+                            const std::function<void()>* interrupt,
+                            Api* api,
+                            const chunk_sink_t& sink) {
   // set the interrupts
   pimpl->set_interrupts(interrupt);
-  // if the caller doesn't want a copy we'll use this dummy
-  Api dummy;
+  // if the caller doesn't want a copy we'll use a scratch one
   if (!api) {
-    api = &dummy;
+    api = pimpl->scratch_request();
   }
   // parse the request
   ParseApi(request_str, Options::sources_to_targets, *api);
   // check the request and locate the locations in the graph
   pimpl->loki_worker.matrix(*api);
   // compute the matrix
-  auto bytes = pimpl->thor_worker.matrix(*api);
+  auto bytes = pimpl->thor_worker.matrix(*api, sink);
   // if they want you do to do the cleanup automatically
   if (auto_cleanup) {
     cleanup();
@@ -156,10 +310,9 @@ std::string actor_t::optimized_route(const std::string& request_str,
                                      Api* api) {
   // set the interrupts
   pimpl->set_interrupts(interrupt);
-  // if the caller doesn't want a copy we'll use this dummy
-  Api dummy;
+  // if the caller doesn't want a copy we'll use a scratch one
   if (!api) {
-    api = &dummy;
+    api = pimpl->scratch_request();
   }
   // parse the request
   ParseApi(request_str, Options::optimized_route, *api);
@@ -180,10 +333,9 @@ std::string
 actor_t::isochrone(const std::string& request_str, const std::function<void()>* interrupt, Api* api) {
   // set the interrupts
   pimpl->set_interrupts(interrupt);
-  // if the caller doesn't want a copy we'll use this dummy
-  Api dummy;
+  // if the caller doesn't want a copy we'll use a scratch one
   if (!api) {
-    api = &dummy;
+    api = pimpl->scratch_request();
   }
   // parse the request
   ParseApi(request_str, Options::isochrone, *api);
@@ -201,12 +353,16 @@ actor_t::isochrone(const std::string& request_str, const std::function<void()>*
 std::string actor_t::trace_route(const std::string& request_str,
                                  const std::function<void()>* interrupt,
                                  Api* api) {
+  // a batch of traces is split up into a request per trace
+  rapidjson::Document document;
+  if (parse_trace_batch(request_str, document)) {
+    return pimpl->trace_batch(document, Options::trace_route, interrupt);
+  }
   // set the interrupts
   pimpl->set_interrupts(interrupt);
-  // if the caller doesn't want a copy we'll use this dummy
-  Api dummy;
+  // if the caller doesn't want a copy we'll use a scratch one
   if (!api) {
-    api = &dummy;
+    api = pimpl->scratch_request();
   }
   // parse the request
   ParseApi(request_str, Options::trace_route, *api);
@@ -226,12 +382,16 @@ std::string actor_t::trace_route(const std::string& request_str,
 std::string actor_t::trace_attributes(const std::string& request_str,
                                       const std::function<void()>* interrupt,
                                       Api* api) {
+  // a batch of traces is split up into a request per trace
+  rapidjson::Document document;
+  if (parse_trace_batch(request_str, document)) {
+    return pimpl->trace_batch(document, Options::trace_attributes, interrupt);
+  }
   // set the interrupts
   pimpl->set_interrupts(interrupt);
-  // if the caller doesn't want a copy we'll use this dummy
-  Api dummy;
+  // if the caller doesn't want a copy we'll use a scratch one
   if (!api) {
-    api = &dummy;
+    api = pimpl->scratch_request();
   }
   // parse the request
   ParseApi(request_str, Options::trace_attributes, *api);
@@ -246,14 +406,139 @@ std::string actor_t::trace_attributes(const std::string& request_str,
   return json;
 }
 
+std::string actor_t::trace_batch(const std::string& request_str,
+                                 const Options::Action action,
+                                 const std::function<void()>* interrupt) {
+  rapidjson::Document document;
+  document.Parse(request_str.c_str());
+  return pimpl->trace_batch(document, action, interrupt);
+}
+
+std::string actor_t::pimpl_t::trace_batch(rapidjson::Document& document,
+                                          const Options::Action action,
+                                          const std::function<void()>* interrupt) {
+  // the traces must be an array of objects and their responses have to go in a json array
+  if (document.HasParseError() || !document.IsObject()) {
+    throw valhalla_exception_t{100};
+  }
+  auto traces = document.FindMember("traces");
+  auto format = rapidjson::get_optional<std::string>(document, "/format");
+  if (traces == document.MemberEnd() || !traces->value.IsArray() ||
+      (format && *format != "json" && *format != "osrm")) {
+    throw valhalla_exception_t{138};
+  }
+  if (traces->value.Size() > max_batch_size) {
+    throw valhalla_exception_t{169, std::to_string(max_batch_size)};
+  }
+
+  // every trace gets the rest of the request with whatever it specifies itself on top, the
+  // documents are only read from here on so the workers can share them
+  rapidjson::Value batch;
+  batch.Swap(traces->value);
+  document.RemoveMember("traces");
+  document.RemoveMember("shape");
+  document.RemoveMember("encoded_polyline");
+  for (const auto& trace : batch.GetArray()) {
+    if (!trace.IsObject()) {
+      throw valhalla_exception_t{138};
+    }
+  }
+  auto make_request = [&document, &batch](const size_t i, rapidjson::Document& request) {
+    request.CopyFrom(document, request.GetAllocator());
+    for (const auto& member : batch[i].GetObject()) {
+      if (member.name == "traces") {
+        continue;
+      }
+      request.RemoveMember(member.name);
+      request.AddMember(rapidjson::Value(member.name, request.GetAllocator()),
+                        rapidjson::Value(member.value, request.GetAllocator()),
+                        request.GetAllocator());
+    }
+  };
+
+  // the pool is only made once there is a batch for it
+  for (size_t i = batch_workers.size(); i < batch_threads; ++i) {
+    batch_workers.emplace_back(new pimpl_t(batch_config));
+  }
+  std::vector<pimpl_t*> workers;
+  for (auto& worker : batch_workers) {
+    workers.push_back(worker.get());
+  }
+  if (workers.empty()) {
+    workers.push_back(this);
+  }
+
+  // each worker takes the next trace until they are all done, a trace that fails gets the error
+  // response it would have had on its own. only the calling thread can be interrupted
+  std::vector<std::string> responses(batch.Size());
+  std::atomic<size_t> next_trace{0};
+  std::atomic<bool> stop{false};
+  auto match_traces = [&](pimpl_t& worker, const std::function<void()>* interrupt) {
+    for (size_t i = next_trace++; i < responses.size() && !stop; i = next_trace++) {
+      if (interrupt) {
+        (*interrupt)();
+      }
+      Api api;
+      try {
+        rapidjson::Document request;
+        make_request(i, request);
+        responses[i] = worker.trace(request, action, interrupt, api);
+      } catch (const valhalla_exception_t& e) {
+        worker.cleanup_workers();
+        responses[i] = serialize_error(e, api);
+      } catch (const std::exception& e) {
+        worker.cleanup_workers();
+        responses[i] = serialize_error({599, std::string(e.what())}, api);
+      }
+      // an interrupt inside the trace was turned into an error above, it has to end the batch
+      if (interrupt) {
+        (*interrupt)();
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(workers.size() - 1);
+  for (size_t i = 1; i < workers.size(); ++i) {
+    threads.emplace_back(match_traces, std::ref(*workers[i]), nullptr);
+  }
+  try {
+    match_traces(*workers.front(), interrupt);
+  } catch (...) {
+    stop = true;
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    throw;
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // the responses go out in the order of the traces
+  size_t size = 13;
+  for (const auto& response : responses) {
+    size += response.size() + 1;
+  }
+  std::string json;
+  json.reserve(size);
+  json += "{\"traces\":[";
+  for (size_t i = 0; i < responses.size(); ++i) {
+    if (i > 0) {
+      json += ',';
+    }
+    json += responses[i];
+  }
+  json += "]}";
+  return json;
+}
+
 std::string
 actor_t::height(const std::string& request_str, const std::function<void()>* interrupt, Api* api) {
   // set the interrupts
   pimpl->set_interrupts(interrupt);
-  // if the caller doesn't want a copy we'll use this dummy
-  Api dummy;
+  // if the caller doesn't want a copy we'll use a scratch one
   if (!api) {
-    api = &dummy;
+    api = pimpl->scratch_request();
   }
   // parse the request
   ParseApi(request_str, Options::height, *api);
@@ -271,10 +556,9 @@ std::string actor_t::transit_available(const std::string& request_str,
                                        Api* api) {
   // set the interrupts
   pimpl->set_interrupts(interrupt);
-  // if the caller doesn't want a copy we'll use this dummy
-  Api dummy;
+  // if the caller doesn't want a copy we'll use a scratch one
   if (!api) {
-    api = &dummy;
+    api = pimpl->scratch_request();
   }
   // parse the request
   ParseApi(request_str, Options::transit_available, *api);
@@ -287,14 +571,15 @@ std::string actor_t::transit_available(const std::string& request_str,
   return json;
 }
 
-std::string
-actor_t::expansion(const std::string& request_str, const std::function<void()>* interrupt, Api* api) {
+std::string actor_t::expansion(const std::string& request_str,
+                               const std::function<void()>* interrupt,
+                               Api* api,
+                               const chunk_sink_t& sink) {
   // set the interrupts
   pimpl->set_interrupts(interrupt);
-  // if the caller doesn't want a copy we'll use this dummy
-  Api dummy;
+  // if the caller doesn't want a copy we'll use a scratch one
   if (!api) {
-    api = &dummy;
+    api = pimpl->scratch_request();
   }
   // parse the request
   ParseApi(request_str, Options::expansion, *api);
@@ -307,7 +592,7 @@ actor_t::expansion(const std::string& request_str, const std::function<void()>*
     pimpl->loki_worker.matrix(*api);
   }
   // route between the locations in the graph to find the best path
-  auto json = pimpl->thor_worker.expansion(*api);
+  auto json = pimpl->thor_worker.expansion(*api, sink);
   // if they want you do to do the cleanup automatically
   if (auto_cleanup) {
     cleanup();
@@ -319,10 +604,9 @@ std::string
 actor_t::centroid(const std::string& request_str, const std::function<void()>* interrupt, Api* api) {
   // set the interrupts
   pimpl->set_interrupts(interrupt);
-  // if the caller doesn't want a copy we'll use this dummy
-  Api dummy;
+  // if the caller doesn't want a copy we'll use a scratch one
   if (!api) {
-    api = &dummy;
+    api = pimpl->scratch_request();
   }
   // parse the request
   ParseApi(request_str, Options::centroid, *api);
@@ -343,10 +627,9 @@ std::string
 actor_t::status(const std::string& request_str, const std::function<void()>* interrupt, Api* api) {
   // set the interrupts
   pimpl->set_interrupts(interrupt);
-  // if the caller doesn't want a copy we'll use this dummy
-  Api dummy;
+  // if the caller doesn't want a copy we'll use a scratch one
   if (!api) {
-    api = &dummy;
+    api = pimpl->scratch_request();
   }
   // parse the request
   ParseApi(request_str, Options::status, *api);
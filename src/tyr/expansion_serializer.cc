@@ -1,29 +1,37 @@
-
 #include "baldr/rapidjson_utils.h"
 #include "tyr/serializers.h"
 
 using namespace valhalla;
 using namespace rapidjson;
 
+namespace {
+// how much output to buffer before handing it to the sink
+constexpr size_t kChunkSize = 256 * 1024;
+} // namespace
+
 namespace valhalla {
 namespace tyr {
-std::string serializeExpansion(Api& request, const std::string& algo) {
-  if (request.options().format() == Options::Format::Options_Format_pbf)
-    return serializePbf(request);
+
+expansion_writer_t::expansion_writer_t(const Options& options, chunk_sink_t sink)
+    : writer(sink ? kChunkSize + kChunkSize / 4 : 1024 * 1024), sink(std::move(sink)) {
+  for (const auto& prop : options.expansion_properties()) {
+    exp_props.insert(static_cast<Options_ExpansionProperties>(prop));
+  }
 
   // form GeoJSON
-  writer_wrapper_t writer(1024 * 1024);
   writer.start_object();
   writer("type", "FeatureCollection");
   writer.start_array("features");
   writer.set_precision(6);
+}
 
-  std::unordered_set<Options::ExpansionProperties> exp_props;
-  for (const auto& prop : request.options().expansion_properties()) {
-    exp_props.insert(static_cast<Options_ExpansionProperties>(prop));
-  }
-  auto expansion = request.expansion();
+void expansion_writer_t::write(const Expansion& expansion) {
   for (int i = 0; i < expansion.geometries().size(); ++i) {
+    // hand off what we have so the buffer stays bounded
+    if (sink && writer.size() >= kChunkSize) {
+      writer.flush(sink);
+    }
+
     // create features
     writer.start_object(); // feature object
     writer("type", "Feature");
@@ -74,6 +82,10 @@ std::string serializeExpansion(Api& request, const std::string& algo) {
     writer.end_object(); // properties
     writer.end_object(); // feature
   }
+}
+
+std::string expansion_writer_t::finish(const Expansion& expansion, const std::string& algo) {
+  write(expansion);
 
   // close the GeoJSON
   writer.end_array(); // features
@@ -82,7 +94,19 @@ std::string serializeExpansion(Api& request, const std::string& algo) {
   writer.end_object();
   writer.end_object(); // object
 
+  if (sink) {
+    writer.flush(sink);
+    return "";
+  }
   return writer.get_buffer();
 }
+
+std::string serializeExpansion(Api& request, const std::string& algo) {
+  if (request.options().format() == Options::Format::Options_Format_pbf)
+    return serializePbf(request);
+
+  expansion_writer_t writer(request.options());
+  return writer.finish(request.expansion(), algo);
+}
 } // namespace tyr
-} // namespace valhalla
\ No newline at end of file
+} // namespace valhalla
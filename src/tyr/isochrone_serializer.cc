@@ -2,6 +2,7 @@
 #include "baldr/json.h"
 #include "midgard/point2.h"
 #include "midgard/pointll.h"
+#include "midgard/tracing.h"
 #include "thor/worker.h"
 #include "tyr/serializers.h"
 
@@ -376,6 +377,7 @@ namespace tyr {
 std::string serializeIsochrones(Api& request,
                                 std::vector<midgard::GriddedData<2>::contour_interval_t>& intervals,
                                 const std::shared_ptr<const midgard::GriddedData<2>>& isogrid) {
+  VALHALLA_TRACE_SCOPE("tyr", "isochrones");
 
   // only generate if json or pbf output is requested
   contours_t contours;
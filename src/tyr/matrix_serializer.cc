@@ -1,6 +1,10 @@
+#include <cmath>
 #include <cstdint>
+#include <cstring>
+#include <limits>
 
 #include "baldr/json.h"
+#include "midgard/tracing.h"
 #include "proto_conversions.h"
 #include "thor/matrixalgorithm.h"
 #include "tyr/serializers.h"
@@ -262,10 +266,143 @@ std::string serialize(const Api& request, double distance_scale) {
 }
 } // namespace valhalla_serializers
 
+namespace columnar_serializers {
+
+// how much output to buffer before handing it to the sink
+constexpr size_t kChunkSize = 256 * 1024;
+
+// IEEE 754 half precision with round to nearest even, overflowing to infinity
+uint16_t to_float16(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const uint16_t sign = (bits >> 16) & 0x8000;
+  const uint32_t biased = (bits >> 23) & 0xff;
+  uint32_t mantissa = bits & 0x7fffff;
+
+  // infinity and nan keep their class
+  if (biased == 0xff) {
+    return sign | 0x7c00 | (mantissa ? 0x200 : 0);
+  }
+
+  const int32_t exponent = static_cast<int32_t>(biased) - 127 + 15;
+  if (exponent >= 31) {
+    return sign | 0x7c00;
+  }
+
+  // subnormals, including rounding up to the smallest one
+  if (exponent <= 0) {
+    if (exponent < -10) {
+      return sign;
+    }
+    mantissa |= 0x800000;
+    const uint32_t shift = 14 - exponent;
+    uint32_t half = mantissa >> shift;
+    const uint32_t remainder = mantissa & ((1u << shift) - 1);
+    const uint32_t halfway = 1u << (shift - 1);
+    if (remainder > halfway || (remainder == halfway && (half & 1))) {
+      ++half;
+    }
+    return sign | half;
+  }
+
+  // a carry out of the mantissa correctly bumps the exponent
+  uint16_t half = sign | (exponent << 10) | (mantissa >> 13);
+  const uint32_t remainder = mantissa & 0x1fff;
+  if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1))) {
+    ++half;
+  }
+  return half;
+}
+
+std::string serialize(const Api& request, double distance_scale, const chunk_sink_t& sink) {
+  const auto& options = request.options();
+  const auto& matrix = request.matrix();
+  const auto encoding = options.column_encoding();
+
+  // both columns are padded so that the second one stays aligned
+  const size_t cells = matrix.times_size();
+  const size_t cell_bytes = encoding == Options::float16 ? sizeof(uint16_t) : sizeof(float);
+  const size_t column_bytes = (cells * cell_bytes + 7) & ~size_t(7);
+
+  tyr::columnar_matrix_header_t header{};
+  std::memcpy(header.magic, "VMTX", sizeof(header.magic));
+  header.version = tyr::kColumnarMatrixVersion;
+  header.encoding = encoding;
+  header.algorithm = matrix.algorithm();
+  header.units = options.units();
+  header.sources = options.sources_size();
+  header.targets = options.targets_size();
+  header.column_bytes = column_bytes;
+
+  // the whole response at once or, with a sink, a chunk at a time
+  std::string bytes;
+  bytes.reserve(sink ? kChunkSize : sizeof(header) + 2 * column_bytes);
+  const auto append = [&bytes, &sink](const void* data, size_t size) {
+    bytes.append(static_cast<const char*>(data), size);
+    if (sink && bytes.size() >= kChunkSize) {
+      sink(bytes);
+      bytes.clear();
+    }
+  };
+  append(&header, sizeof(header));
+
+  // the columns are written straight from the repeated fields
+  constexpr float kUnreachable = std::numeric_limits<float>::quiet_NaN();
+  const auto write_column = [&](bool times) {
+    int32_t prev = 0;
+    for (size_t i = 0; i < cells; ++i) {
+      const bool found = matrix.times(i) != kMaxCost;
+      const double value = times ? matrix.times(i) : matrix.distances(i) * distance_scale;
+      switch (encoding) {
+        case Options::float16: {
+          const uint16_t cell = to_float16(found ? static_cast<float>(value) : kUnreachable);
+          append(&cell, sizeof(cell));
+          break;
+        }
+        case Options::delta: {
+          // each row starts over so rows can be decoded independently
+          if (i % header.targets == 0) {
+            prev = 0;
+          }
+          // truncated and rounded the same way as the json output
+          int32_t cell = -1;
+          if (found) {
+            cell = static_cast<int32_t>(times ? value : std::lround(value * 1000));
+          }
+          const int32_t delta = cell - prev;
+          prev = cell;
+          append(&delta, sizeof(delta));
+          break;
+        }
+        case Options::raw:
+        default: {
+          const float cell = found ? static_cast<float>(value) : kUnreachable;
+          append(&cell, sizeof(cell));
+          break;
+        }
+      }
+    }
+    static const char kPadding[8] = {};
+    append(kPadding, column_bytes - cells * cell_bytes);
+  };
+  write_column(true);
+  write_column(false);
+
+  if (sink) {
+    if (!bytes.empty()) {
+      sink(bytes);
+    }
+    return "";
+  }
+  return bytes;
+}
+} // namespace columnar_serializers
+
 namespace valhalla {
 namespace tyr {
 
-std::string serializeMatrix(Api& request) {
+std::string serializeMatrix(Api& request, const chunk_sink_t& sink) {
+  VALHALLA_TRACE_SCOPE("tyr", "matrix");
   double distance_scale = (request.options().units() == Options::miles) ? kMilePerMeter : kKmPerMeter;
 
   // error if we failed finding any connection
@@ -277,16 +414,29 @@ std::string serializeMatrix(Api& request) {
     return "";
   }
 
+  std::string bytes;
   switch (request.options().format()) {
     case Options_Format_osrm:
-      return osrm_serializers::serialize(request);
+      bytes = osrm_serializers::serialize(request);
+      break;
     case Options_Format_json:
-      return valhalla_serializers::serialize(request, distance_scale);
+      bytes = valhalla_serializers::serialize(request, distance_scale);
+      break;
     case Options_Format_pbf:
-      return serializePbf(request);
+      bytes = serializePbf(request);
+      break;
+    case Options_Format_columnar:
+      return columnar_serializers::serialize(request, distance_scale, sink);
     default:
       throw;
   }
+
+  // the other formats are only written as a whole
+  if (sink) {
+    sink(bytes);
+    return "";
+  }
+  return bytes;
 }
 
 } // namespace tyr
@@ -3,6 +3,7 @@
 #include <vector>
 
 #include "midgard/encoded.h"
+#include "midgard/tracing.h"
 #include "midgard/util.h"
 #include "route_serializer_osrm.h"
 #include "route_serializer_valhalla.cc"
@@ -75,6 +76,7 @@ namespace valhalla {
 namespace tyr {
 
 std::string serializeDirections(Api& request) {
+  VALHALLA_TRACE_SCOPE("tyr", "directions");
   // serialize them
   switch (request.options().format()) {
     case Options_Format_osrm:
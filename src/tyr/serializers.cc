@@ -1,5 +1,6 @@
 #include <boost/algorithm/string/replace.hpp>
 #include <cstdint>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -224,9 +225,14 @@ std::string serializePbf(Api& request) {
   // if they dont want the options object but its a service request we have to work around it
   bool skip_options = !request.options().pbf_field_selector().options() && request.has_info() &&
                       request.info().is_service();
-  Options dummy;
+  Options* dummy = nullptr;
+  std::unique_ptr<Options> heap_dummy;
   if (skip_options) {
-    request.mutable_options()->Swap(&dummy);
+    // on the same arena as the request so swapping it in and out doesn't deep copy
+    dummy = google::protobuf::Arena::CreateMessage<Options>(request.GetArena());
+    if (!request.GetArena())
+      heap_dummy.reset(dummy);
+    request.mutable_options()->Swap(dummy);
   }
 
   // disable all the stuff we need to disable, options must be last since we are referencing it
@@ -250,7 +256,7 @@ std::string serializePbf(Api& request) {
 
   // we do need to keep the options object though because downstream request handling relies on it
   if (skip_options) {
-    request.mutable_options()->Swap(&dummy);
+    request.mutable_options()->Swap(dummy);
   }
 
   return bytes;
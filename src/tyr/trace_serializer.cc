@@ -52,6 +52,9 @@ void serialize_edges(const AttributesController& controller,
     scale = kMilePerKm;
   }
 
+  // Checking a category goes through every attribute so only do it once
+  const bool node_attributes = controller.category_attribute_enabled(kNodeCategory);
+
   // Loop over edges to add attributes
   for (int i = 1; i < trip_path.node().size(); i++) {
     if (trip_path.node(i - 1).has_edge()) {
@@ -286,7 +289,7 @@ void serialize_edges(const AttributesController& controller,
       }
 
       // Process edge end node only if any node items are enabled
-      if (controller.category_attribute_enabled(kNodeCategory)) {
+      if (node_attributes) {
         const auto& node = trip_path.node(i);
         writer.start_object("end_node");
         if (node.intersecting_edge_size() > 0) {
@@ -12,6 +12,7 @@
 #include "argparse_utils.h"
 #include "baldr/graphreader.h"
 #include "baldr/pathlocation.h"
+#include "load_test.h"
 #include "loki/worker.h"
 #include "midgard/logging.h"
 #include "odin/directionsbuilder.h"
@@ -91,6 +92,8 @@ int main(int argc, char* argv[]) {
   uint32_t iterations;
   bool log_details;
   bool optimize;
+  std::string load_test_file;
+  load_test::options_t load_test_options{};
   boost::property_tree::ptree config;
 
   try {
@@ -115,20 +118,27 @@ int main(int argc, char* argv[]) {
       ("m,multi-run", "Generate the route N additional times before exiting.", cxxopts::value<uint32_t>()->default_value("1"))
       ("l,log-details", "Logs details about the solution", cxxopts::value<bool>()->default_value("false"))
       ("o,optimize", "Run optimization", cxxopts::value<bool>()->default_value("false"))
+      ("load-test", "File of matrix requests, one per line, to replay concurrently through the whole service stack reporting throughput and latencies.", cxxopts::value<std::string>(load_test_file))
+      ("concurrency", "Number of threads replaying the load test. Defaults to all threads.", cxxopts::value<uint32_t>())
+      ("repeat", "Number of times the load test replays the requests.", cxxopts::value<uint32_t>(load_test_options.repeat)->default_value("1"))
+      ("isolate-caches", "Give every thread of the load test its own tile cache instead of sharing one.", cxxopts::value<bool>(load_test_options.isolate_caches)->default_value("false"))
       ("c,config", "Valhalla configuration file", cxxopts::value<std::string>())
       ("i,inline-config", "Inline JSON config", cxxopts::value<std::string>());
     // clang-format on
 
     auto result = options.parse(argc, argv);
-    if (!parse_common_args(program, options, result, config, "mjolnir.logging"))
+    if (!parse_common_args(program, options, result, config, "mjolnir.logging",
+                           result.count("load-test") > 0))
       return EXIT_SUCCESS;
 
-    if (!result.count("json")) {
+    if (!result.count("json") && !result.count("load-test")) {
       throw cxxopts::exceptions::exception("A JSON format request must be present.\n\n" +
                                            options.help());
     }
 
-    json_str = result["json"].as<std::string>();
+    if (result.count("json")) {
+      json_str = result["json"].as<std::string>();
+    }
     iterations = result["multi-run"].as<uint32_t>();
     log_details = result["log-details"].as<bool>();
     optimize = result["optimize"].as<bool>();
@@ -141,6 +151,18 @@ int main(int argc, char* argv[]) {
     return EXIT_FAILURE;
   }
 
+  // Replay the requests through the actor instead of timing the matrix algorithms on one request
+  if (!load_test_file.empty()) {
+    load_test_options.threads = config.get<uint32_t>("mjolnir.concurrency");
+    auto failures = load_test::run(config, load_test::read_requests(load_test_file),
+                                   [](tyr::actor_t& actor, const std::string& request, Api& api) {
+                                     return actor.matrix(request, nullptr, &api);
+                                   },
+                                   load_test_options);
+    google::protobuf::ShutdownProtobufLibrary();
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+  }
+
   Api request;
   ParseApi(json_str, valhalla::Options::sources_to_targets, request);
   auto& options = *request.mutable_options();
@@ -16,6 +16,7 @@
 #include "baldr/graphreader.h"
 #include "baldr/pathlocation.h"
 #include "baldr/tilehierarchy.h"
+#include "load_test.h"
 #include "loki/search.h"
 #include "loki/worker.h"
 #include "midgard/distanceapproximator.h"
@@ -469,6 +470,8 @@ int main(int argc, char* argv[]) {
   bool match_test, verbose_lanes;
   bool multi_run = false;
   uint32_t iterations;
+  std::string load_test_file;
+  load_test::options_t load_test_options{};
 
   try {
     // clang-format off
@@ -493,12 +496,17 @@ int main(int argc, char* argv[]) {
       ("match-test", "Test RouteMatcher with resulting shape.", cxxopts::value<bool>(match_test)->default_value("false"))
       ("multi-run", "Generate the route N additional times before exiting.", cxxopts::value<uint32_t>(iterations)->default_value("1"))
       ("verbose-lanes", "Include verbose lanes output in DirectionsTest.", cxxopts::value<bool>(verbose_lanes)->default_value("false"))
+      ("load-test", "File of route requests, one per line, to replay concurrently through the whole service stack reporting throughput and latencies.", cxxopts::value<std::string>(load_test_file))
+      ("concurrency", "Number of threads replaying the load test. Defaults to all threads.", cxxopts::value<uint32_t>())
+      ("repeat", "Number of times the load test replays the requests.", cxxopts::value<uint32_t>(load_test_options.repeat)->default_value("1"))
+      ("isolate-caches", "Give every thread of the load test its own tile cache instead of sharing one.", cxxopts::value<bool>(load_test_options.isolate_caches)->default_value("false"))
       ("c,config", "Valhalla configuration file", cxxopts::value<std::string>())
       ("i,inline-config", "Inline JSON config", cxxopts::value<std::string>());
     // clang-format on
 
     auto result = options.parse(argc, argv);
-    if (!parse_common_args(program, options, result, config, "mjolnir.logging"))
+    if (!parse_common_args(program, options, result, config, "mjolnir.logging",
+                           result.count("load-test") > 0))
       return EXIT_SUCCESS;
 
     if (iterations > 1) {
@@ -512,8 +520,8 @@ int main(int argc, char* argv[]) {
       json_str.assign((std::istreambuf_iterator<char>(ifs)), (std::istreambuf_iterator<char>()));
     } else if (result.count("json")) {
       json_str = result["json"].as<std::string>();
-    } else {
-      throw cxxopts::exceptions::exception("Either json or json-file args must be set.");
+    } else if (load_test_file.empty()) {
+      throw cxxopts::exceptions::exception("Either json, json-file or load-test args must be set.");
     }
   } catch (cxxopts::exceptions::exception& e) {
     std::cerr << e.what() << std::endl;
@@ -524,6 +532,19 @@ int main(int argc, char* argv[]) {
     return EXIT_FAILURE;
   }
 
+  // Replay the requests through the actor instead of timing the path algorithms of a single route
+  if (!load_test_file.empty()) {
+    load_test_options.threads = config.get<uint32_t>("mjolnir.concurrency");
+    auto failures = load_test::run(config, load_test::read_requests(load_test_file),
+                                   [](valhalla::tyr::actor_t& actor, const std::string& request,
+                                      valhalla::Api& api) {
+                                     return actor.route(request, nullptr, &api);
+                                   },
+                                   load_test_options);
+    google::protobuf::ShutdownProtobufLibrary();
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+  }
+
   // Grab the directions options, if they exist
   valhalla::Api request;
   valhalla::ParseApi(json_str, valhalla::Options::route, request);
@@ -1,3 +1,4 @@
+#include <csignal>
 #include <fstream>
 #include <iostream>
 #include <list>
@@ -13,6 +14,7 @@ using namespace prime_server;
 
 #include "config.h"
 #include "midgard/logging.h"
+#include "midgard/tracing.h"
 
 #include "loki/worker.h"
 #include "odin/worker.h"
@@ -136,6 +138,13 @@ int main(int argc, char** argv) {
   prime_server::quiesce(config.get<unsigned int>("httpd.service.drain_seconds", 28),
                         config.get<unsigned int>("httpd.service.shutting_seconds", 1));
 
+  // when the trace points are compiled in what they recorded is dumped to a file on SIGUSR2
+  if (valhalla::midgard::tracing::compiled()) {
+    valhalla::midgard::tracing::dump_on_signal(SIGUSR2,
+                                               config.get<std::string>("httpd.service.trace_file",
+                                                                       "/tmp/valhalla_trace.json"));
+  }
+
   // grab the endpoints
   std::string listen = config.get<std::string>("httpd.service.listen");
   std::string loopback = config.get<std::string>("httpd.service.loopback");
@@ -183,6 +192,21 @@ int main(int argc, char** argv) {
   std::thread loki_proxy_thread(
       std::bind(&proxy_t::forward, proxy_t(context, loki_proxy + "_in", loki_proxy + "_out")));
   loki_proxy_thread.detach();
+
+  // all stages in one worker, the request never gets serialized between them
+  if (config.get<bool>("httpd.service.fused_pipeline", false)) {
+    LOG_INFO("Running loki, thor and odin as a single in-process pipeline");
+    std::list<std::thread> tyr_worker_threads;
+    for (size_t i = 0; i < worker_concurrency; ++i) {
+      tyr_worker_threads.emplace_back(valhalla::tyr::run_service, config);
+      tyr_worker_threads.back().detach();
+    }
+
+    // wait forever (or for interrupt)
+    server_thread.join();
+    return 0;
+  }
+
   std::list<std::thread> loki_worker_threads;
   for (size_t i = 0; i < worker_concurrency; ++i) {
     loki_worker_threads.emplace_back(valhalla::loki::run_service, config);
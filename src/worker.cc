@@ -8,6 +8,7 @@
 #include "loki/worker.h"
 #include "midgard/encoded.h"
 #include "midgard/logging.h"
+#include "midgard/tracing.h"
 #include "midgard/util.h"
 #include "odin/util.h"
 #include "odin/worker.h"
@@ -77,6 +78,7 @@ const std::unordered_map<unsigned, valhalla::valhalla_exception_t> error_codes{
     {135, {135, "Failed to parse trace", 400, HTTP_400, OSRM_INVALID_VALUE, "trace_parse_failed"}},
     {136, {136, "durations size not compatible with trace size", 400, HTTP_400, OSRM_INVALID_VALUE, "trace_duration_mismatch"}},
     {137, {137, "Failed to parse polygon", 400, HTTP_400, OSRM_INVALID_VALUE, "polygon_parse_failed"}},
+    {138, {138, "Failed to parse traces, a batch needs an array of trace objects and json output", 400, HTTP_400, OSRM_INVALID_VALUE, "traces_parse_failed"}},
     {140, {140, "Action does not support multimodal costing", 400, HTTP_400, OSRM_INVALID_VALUE, "no_multimodal"}},
     {141, {141, "Arrive by for multimodal not implemented yet", 501, HTTP_501, OSRM_INVALID_VALUE, "no_arrive_by_multimodal"}},
     {142, {142, "Arrive by not implemented for isochrones", 501, HTTP_501, OSRM_INVALID_VALUE, "no_arrive_by_isochrones"}},
@@ -100,6 +102,7 @@ const std::unordered_map<unsigned, valhalla::valhalla_exception_t> error_codes{
     {165, {165, "Date and time required for destination for date_type of invariant", 400, HTTP_400, OSRM_INVALID_OPTIONS, "missing_invariant_date"}},
     {167, {167, "Exceeded maximum circumference for exclude_polygons", 400, HTTP_400, OSRM_PERIMETER_EXCEEDED, "too_large_polygon"}},
     {168, {168, "Invalid expansion property type", 400, HTTP_400, OSRM_INVALID_OPTIONS, "invalid_expansion_property"}},
+    {169, {169, "Exceeded max traces in a batch", 400, HTTP_400, OSRM_INVALID_VALUE, "too_many_traces"}},
     {170, {170, "Locations are in unconnected regions. Go check/edit the map at osm.org", 400, HTTP_400, OSRM_NO_ROUTE, "impossible_route"}},
     {171, {171, "No suitable edges near location", 400, HTTP_400, OSRM_NO_SEGMENT, "no_edges_near"}},
     {172, {172, "Exceeded breakage distance for all pairs", 400, HTTP_400, OSRM_BREAKAGE_EXCEEDED, "too_large_breakage_distance"}},
@@ -171,17 +174,208 @@ const std::unordered_map<int, std::string> warning_codes = {
 };
 // clang-format on
 
-rapidjson::Document from_string(const std::string& json, const valhalla_exception_t& e) {
-  rapidjson::Document d;
-  if (json.empty()) {
-    d.SetObject();
-    return d;
+/**
+ * A SAX handler which builds the same document as rapidjson::Document::Parse except for the top
+ * level "shape" array. It can hold tens of thousands of points so they are read straight into
+ * the options and left as null in the document. from_json then validates them the
+ * same way it validates locations which came in via pbf. The points may only have the plain
+ * numeric members below, anything else stops the read so the caller can fall back to the DOM.
+ */
+class request_reader_t {
+public:
+  request_reader_t(rapidjson::Document& doc, Api& api) : doc(doc), api(api) {
   }
-  d.Parse(json.c_str());
-  if (d.HasParseError()) {
-    throw e;
+
+  bool Null() {
+    return locations ? bail() : forward().Null();
+  }
+  bool Bool(bool b) {
+    return locations ? bail() : forward().Bool(b);
+  }
+  bool Int(int i) {
+    return locations ? set(i) : forward().Int(i);
+  }
+  bool Uint(unsigned u) {
+    return locations ? set(u) : forward().Uint(u);
+  }
+  bool Int64(int64_t i) {
+    return locations ? set(i) : forward().Int64(i);
+  }
+  bool Uint64(uint64_t u) {
+    return locations ? set(u) : forward().Uint64(u);
+  }
+  bool Double(double d) {
+    return locations ? set(d) : forward().Double(d);
+  }
+  bool RawNumber(const char* str, rapidjson::SizeType length, bool copy) {
+    return locations ? bail() : forward().RawNumber(str, length, copy);
+  }
+  bool String(const char* str, rapidjson::SizeType length, bool copy) {
+    return locations ? bail() : forward().String(str, length, copy);
+  }
+  bool StartObject() {
+    if (locations) {
+      if (location)
+        return bail();
+      location = locations->Add();
+      return true;
+    }
+    ++depth;
+    return forward().StartObject();
+  }
+  bool Key(const char* str, rapidjson::SizeType length, bool copy) {
+    if (locations)
+      return member({str, length});
+    auto ok = forward().Key(str, length, copy);
+    pending = depth == 1 && std::string_view{str, length} == "shape";
+    return ok;
+  }
+  bool EndObject(rapidjson::SizeType member_count) {
+    if (locations) {
+      location = nullptr;
+      return true;
+    }
+    --depth;
+    return forward().EndObject(member_count);
+  }
+  bool StartArray() {
+    if (locations)
+      return bail();
+    if (pending) {
+      // the first time we stream anything this is a json request, from_json would clear it anyway
+      if (!streamed)
+        api.Clear();
+      streamed = true;
+      locations = api.mutable_options()->mutable_shape();
+      pending = false;
+      return true;
+    }
+    ++depth;
+    return forward().StartArray();
+  }
+  bool EndArray(rapidjson::SizeType element_count) {
+    if (locations) {
+      locations = nullptr;
+      return doc.Null();
+    }
+    --depth;
+    return forward().EndArray(element_count);
+  }
+
+  // whether any points were read into the options
+  bool streamed = false;
+  // whether we stopped because a point had something we dont read here
+  bool bailed = false;
+
+protected:
+  enum field_t { kLat, kLon, kTime, kRadius, kAccuracy, kHeading, kHeadingTolerance };
+
+  rapidjson::Document& forward() {
+    pending = false;
+    return doc;
+  }
+
+  bool bail() {
+    bailed = true;
+    return false;
+  }
+
+  bool member(std::string_view key) {
+    if (!location)
+      return bail();
+    if (key == "lat")
+      field = kLat;
+    else if (key == "lon")
+      field = kLon;
+    else if (key == "time")
+      field = kTime;
+    else if (key == "radius")
+      field = kRadius;
+    else if (key == "accuracy")
+      field = kAccuracy;
+    else if (key == "heading")
+      field = kHeading;
+    else if (key == "heading_tolerance")
+      field = kHeadingTolerance;
+    else
+      return bail();
+    return true;
+  }
+
+  // the casts match what rapidjson::get_optional does with the same values in parse_location
+  template <typename T> bool set(T value) {
+    if (!location)
+      return bail();
+    switch (field) {
+      case kLat:
+        location->mutable_ll()->set_lat(static_cast<double>(value));
+        break;
+      case kLon:
+        location->mutable_ll()->set_lng(static_cast<double>(value));
+        break;
+      case kTime:
+        location->set_time(static_cast<double>(value));
+        break;
+      case kRadius:
+        location->set_radius(static_cast<unsigned int>(value));
+        break;
+      case kAccuracy:
+        location->set_accuracy(static_cast<unsigned int>(value));
+        break;
+      case kHeading:
+        location->set_heading(static_cast<int>(value));
+        break;
+      case kHeadingTolerance:
+        location->set_heading_tolerance(static_cast<int>(value));
+        break;
+    }
+    return true;
+  }
+
+  rapidjson::Document& doc;
+  Api& api;
+  int depth = 0;
+  bool pending = false;
+  google::protobuf::RepeatedPtrField<valhalla::Location>* locations = nullptr;
+  valhalla::Location* location = nullptr;
+  field_t field = kLat;
+};
+
+/**
+ * Parses a json request into the document, streaming large location arrays into the api's options
+ * along the way (see request_reader_t)
+ *
+ * @param json  the request
+ * @param doc   the document to fill with the rest of the request
+ * @param api   the request object whose options may receive the shape points
+ * @return true if points were put into the options, in which case api was cleared beforehand
+ */
+bool read_request(const char* json, rapidjson::Document& doc, Api& api) {
+  rapidjson::ParseResult result;
+  bool streamed = false, bailed = false;
+  auto generator = [&](rapidjson::Document& handler) {
+    request_reader_t reader(handler, api);
+    rapidjson::StringStream stream(json);
+    rapidjson::Reader parser;
+    result = parser.Parse(stream, reader);
+    streamed = reader.streamed;
+    bailed = reader.bailed;
+    return !result.IsError();
+  };
+  doc.Populate(generator);
+  if (!result.IsError()) {
+    return streamed;
   }
-  return d;
+
+  // some point had more than we read above, so read it all the regular way
+  if (bailed) {
+    api.Clear();
+    doc.Parse(json);
+    if (!doc.HasParseError()) {
+      return false;
+    }
+  }
+  throw valhalla_exception_t{100};
 }
 
 bool add_date_to_locations(Options& options,
@@ -642,8 +836,9 @@ void parse_recostings(const rapidjson::Document& doc,
  * @param doc      the rapidjson request doc
  * @param action   which request action will be performed
  * @param options  the options to fill out or validate if they are already filled out
+ * @param streamed whether read_request already cleared the api and put json points into it
  */
-void from_json(rapidjson::Document& doc, Options::Action action, Api& api) {
+void from_json(rapidjson::Document& doc, Options::Action action, Api& api, bool streamed = false) {
   // if its a pbf request we want to keep the options and clear the rest
   bool pbf = false;
   if (api.has_options() && doc.ObjectEmpty()) {
@@ -653,7 +848,7 @@ void from_json(rapidjson::Document& doc, Options::Action action, Api& api) {
     api.clear_info();
     pbf = true;
   } // when its json we start with a blank slate and fill it all in
-  else {
+  else if (!streamed) {
     api.Clear();
   }
 
@@ -712,12 +907,27 @@ void from_json(rapidjson::Document& doc, Options::Action action, Api& api) {
       options.clear_jsonp();
     }
   }
+  // only the matrix has columns to write, everything else goes back as json
+  else if (options.format() == Options::columnar) {
+    if (options.action() != Options::sources_to_targets) {
+      options.set_format(Options::json);
+    } else {
+      options.clear_jsonp();
+    }
+  }
 #ifndef ENABLE_GDAL
   else if (options.format() == Options::geotiff) {
     throw valhalla_exception_t{504};
   }
 #endif
 
+  // how the columnar format encodes the time and distance columns
+  auto column_encoding = rapidjson::get_optional<std::string>(doc, "/column_encoding");
+  Options::ColumnEncoding encoding;
+  if (column_encoding && Options_ColumnEncoding_Enum_Parse(*column_encoding, &encoding)) {
+    options.set_column_encoding(encoding);
+  }
+
   auto units = rapidjson::get_optional<std::string>(doc, "/units");
   if (units && ((*units == "miles") || (*units == "mi"))) {
     options.set_units(Options::miles);
@@ -927,17 +1137,20 @@ void from_json(rapidjson::Document& doc, Options::Action action, Api& api) {
       precision = options.shape_format() == valhalla::polyline5 ? 1e-5 : 1e-6;
     }
 
-    options.mutable_shape()->Clear();
-    auto decoded =
-        midgard::decode<std::vector<midgard::PointLL>>(options.encoded_polyline(), precision);
-    for (const auto& ll : decoded) {
-      auto* sll = options.mutable_shape()->Add();
-      sll->mutable_ll()->set_lat(ll.lat());
-      sll->mutable_ll()->set_lng(ll.lng());
-      // set type to via by default
-      sll->set_type(valhalla::Location::kVia);
-      sll->set_time(-1);
-    }
+    // decode straight into the shape rather than into an intermediate container
+    auto& shape = *options.mutable_shape();
+    shape.Clear();
+    const auto& encoded = options.encoded_polyline();
+    shape.Reserve(encoded.size() / 4);
+    midgard::decode_points<midgard::PointLL>(encoded.data(), encoded.size(), precision,
+                                             [&shape](const midgard::PointLL& ll) {
+                                               auto* sll = shape.Add();
+                                               sll->mutable_ll()->set_lat(ll.lat());
+                                               sll->mutable_ll()->set_lng(ll.lng());
+                                               // set type to via by default
+                                               sll->set_type(valhalla::Location::kVia);
+                                               sll->set_time(-1);
+                                             });
     // first and last always get type break
     if (options.shape_size()) {
       options.mutable_shape(0)->set_type(valhalla::Location::kBreak);
@@ -1250,6 +1463,18 @@ void from_json(rapidjson::Document& doc, Options::Action action, Api& api) {
   options.set_voice_instructions(
       rapidjson::get<bool>(doc, "/voice_instructions", options.voice_instructions()));
 
+  // whether to form verbal instructions, by default only if the response format will use them
+  auto verbal_instructions =
+      rapidjson::get<bool>(doc, "/verbal_instructions",
+                           options.has_verbal_instructions_case()
+                               ? options.verbal_instructions()
+                               : options.format() != Options::osrm || options.voice_instructions());
+  options.set_verbal_instructions(verbal_instructions);
+
+  // how many maneuvers per leg to form instructions for, default 0 meaning all of them
+  options.set_narrative_maneuver_limit(
+      rapidjson::get<uint32_t>(doc, "/narrative_maneuver_limit", options.narrative_maneuver_limit()));
+
   // whether to include roundabout_exit maneuvers, default true
   auto roundabout_exits =
       rapidjson::get<bool>(doc, "/roundabout_exits",
@@ -1325,15 +1550,17 @@ std::string serialize_error(const valhalla_exception_t& exception, Api& request)
 
   // pbf format output, we only send back the info with errors in it
   if (request.options().format() == Options::pbf) {
-    Api error_only;
-    error_only.mutable_info()->Swap(request.mutable_info());
-    auto bytes = error_only.SerializeAsString();
+    // on the same arena as the request so the swaps below don't deep copy
+    auto* error_only = google::protobuf::Arena::CreateMessage<Api>(request.GetArena());
+    std::unique_ptr<Api> heap_error_only(request.GetArena() ? nullptr : error_only);
+    error_only->mutable_info()->Swap(request.mutable_info());
+    auto bytes = error_only->SerializeAsString();
     // if we are handling a service request we need the request intact
-    if (error_only.info().is_service())
-      error_only.mutable_info()->Swap(request.mutable_info());
+    if (error_only->info().is_service())
+      error_only->mutable_info()->Swap(request.mutable_info());
     // otherwise we can blank the object save for the info
     else
-      request.Swap(&error_only);
+      request.Swap(error_only);
     return bytes;
   }
 
@@ -1343,7 +1570,19 @@ std::string serialize_error(const valhalla_exception_t& exception, Api& request)
 
 void ParseApi(const std::string& request, Options::Action action, valhalla::Api& api) {
   // maybe parse some json
-  auto document = from_string(request, valhalla_exception_t{100});
+  rapidjson::Document document;
+  bool streamed = false;
+  if (request.empty()) {
+    document.SetObject();
+  } else {
+    streamed = read_request(request.c_str(), document, api);
+  }
+  from_json(document, action, api, streamed);
+}
+
+void ParseApi(rapidjson::Document& document, Options::Action action, valhalla::Api& api) {
+  // the json is all there is to the request, even if it is empty
+  api.Clear();
   from_json(document, action, api);
 }
 
@@ -1504,22 +1743,18 @@ void ParseApi(const http_request_t& request, valhalla::Api& api) {
 
   // parse the json input
   rapidjson::Document document;
-  auto& allocator = document.GetAllocator();
+  bool streamed = false;
   const auto& json = request.query.find("json");
   if (json != request.query.end() && json->second.size() && json->second.front().size()) {
-    document.Parse(json->second.front().c_str());
+    streamed = read_request(json->second.front().c_str(), document, api);
   } // no json parameter, check the body
   else if (!request.body.empty()) {
-    document.Parse(request.body.c_str());
+    streamed = read_request(request.body.c_str(), document, api);
   } // no json at all
   else {
     document.SetObject();
   }
-
-  // if parsing failed
-  if (document.HasParseError()) {
-    throw valhalla_exception_t{100};
-  };
+  auto& allocator = document.GetAllocator();
 
   // throw the query params into the rapidjson doc
   for (const auto& kv : request.query) {
@@ -1543,7 +1778,7 @@ void ParseApi(const http_request_t& request, valhalla::Api& api) {
   }
 
   // parse out the options
-  from_json(document, action, api);
+  from_json(document, action, api, streamed);
 }
 
 const headers_t::value_type CORS{"Access-Control-Allow-Origin", "*"};
@@ -1569,7 +1804,9 @@ to_response(const std::string& data, http_request_info_t& request_info, const Ap
   auto fmt = request.options().format();
   const auto& mime = fmt == Options::json || fmt == Options::osrm
                          ? worker::JSON_MIME
-                         : (fmt == Options::pbf ? worker::PBF_MIME : worker::GPX_MIME);
+                         : (fmt == Options::pbf
+                                ? worker::PBF_MIME
+                                : (fmt == Options::columnar ? worker::BINARY_MIME : worker::GPX_MIME));
   headers_t headers{CORS, mime};
   if (fmt == Options::gpx)
     headers.insert(ATTACHMENT);
@@ -1595,6 +1832,45 @@ to_response(const std::string& data, http_request_info_t& request_info, const Ap
   return result;
 }
 
+bool serve_metrics(const http_request_t& http_request,
+                   http_request_info_t& request_info,
+                   worker_t::result_t& result) {
+  if (http_request.path != "/metrics" || http_request.method != method_t::GET ||
+      !midgard::metrics::enabled()) {
+    return false;
+  }
+  http_response_t response(200, "OK", midgard::metrics::render(),
+                           headers_t{CORS, worker::PROMETHEUS_MIME});
+  response.from_info(request_info);
+  result = worker_t::result_t{false, std::list<std::string>(), ""};
+  result.messages.emplace_back(response.to_string());
+  return true;
+}
+
+bool serve_trace(const http_request_t& http_request,
+                 http_request_info_t& request_info,
+                 worker_t::result_t& result) {
+  if (http_request.path != "/trace" || http_request.method != method_t::GET ||
+      !midgard::tracing::compiled()) {
+    return false;
+  }
+  // a window which doesn't parse dumps everything
+  auto window = std::chrono::milliseconds::zero();
+  auto seconds = http_request.query.find("seconds");
+  if (seconds != http_request.query.end() && !seconds->second.empty()) {
+    try {
+      window = std::chrono::milliseconds(
+          static_cast<int64_t>(std::stod(seconds->second.front()) * 1000));
+    } catch (...) {}
+  }
+  http_response_t response(200, "OK", midgard::tracing::render(window),
+                           headers_t{CORS, worker::JSON_MIME});
+  response.from_info(request_info);
+  result = worker_t::result_t{false, std::list<std::string>(), ""};
+  result.messages.emplace_back(response.to_string());
+  return true;
+}
+
 #endif
 
 // TODO: when we want to use this in mjolnir too we can move this into a private header
@@ -1622,10 +1898,85 @@ struct statsd_client_t : public Statsd::StatsdClient {
   std::vector<std::string> tags;
 };
 
-service_worker_t::service_worker_t(const boost::property_tree::ptree& conf) : interrupt(nullptr) {
+namespace {
+
+// heap blocks handed out to request arenas on this thread, workers only ever touch their arena from
+// the thread they run on so the difference between two readings is what one arena took
+thread_local uint64_t arena_blocks_allocated = 0;
+
+void* allocate_arena_block(size_t size) {
+  ++arena_blocks_allocated;
+  return ::operator new(size);
+}
+
+void deallocate_arena_block(void* block, size_t size) {
+  ::operator delete(block, size);
+}
+
+google::protobuf::ArenaOptions arena_options(char* initial_block, size_t initial_block_size) {
+  google::protobuf::ArenaOptions options;
+  options.initial_block = initial_block;
+  options.initial_block_size = initial_block_size;
+  // big results like long trip legs would otherwise take thousands of the default 8kb blocks
+  options.max_block_size = 1024 * 1024;
+  options.block_alloc = &allocate_arena_block;
+  options.block_dealloc = &deallocate_arena_block;
+  return options;
+}
+
+} // namespace
+
+request_arena_t::request_arena_t(size_t initial_block_size)
+    : initial_block_(new char[initial_block_size]),
+      arena_(arena_options(initial_block_.get(), initial_block_size)),
+      blocks_at_reset_(arena_blocks_allocated) {
+}
+
+Api& request_arena_t::request() {
+  return *google::protobuf::Arena::CreateMessage<Api>(&arena_);
+}
+
+void request_arena_t::reset() {
+  arena_.Reset();
+  blocks_at_reset_ = arena_blocks_allocated;
+}
+
+uint64_t request_arena_t::blocks_allocated() const {
+  return arena_blocks_allocated - blocks_at_reset_;
+}
+
+uint64_t request_arena_t::bytes_allocated() const {
+  return arena_.SpaceAllocated();
+}
+
+uint64_t request_arena_t::bytes_used() const {
+  return arena_.SpaceUsed();
+}
+
+void request_arena_t::record_statistics(Api& api, const std::string& service) const {
+  if (api.GetArena() != &arena_)
+    return;
+
+  const auto& action = Options_Action_Enum_Name(api.options().action());
+  auto* blocks = api.mutable_info()->mutable_statistics()->Add();
+  blocks->set_key(action + ".info." + service + ".arena_blocks");
+  blocks->set_value(blocks_allocated());
+  blocks->set_type(gauge);
+  auto* bytes = api.mutable_info()->mutable_statistics()->Add();
+  bytes->set_key(action + ".info." + service + ".arena_bytes");
+  bytes->set_value(bytes_allocated());
+  bytes->set_type(gauge);
+}
+
+service_worker_t::service_worker_t(const boost::property_tree::ptree& conf)
+    : interrupt(nullptr), trace_category(nullptr) {
   if (conf.count("statsd")) {
     statsd_client = std::make_unique<statsd_client_t>(conf);
   }
+  // latency histograms are recorded for the whole process once any worker asks for them
+  if (conf.get<bool>("httpd.service.metrics", false)) {
+    midgard::metrics::enable(true);
+  }
 }
 service_worker_t::~service_worker_t() {
 }
@@ -1637,6 +1988,8 @@ void service_worker_t::cleanup() {
     // sends metrics to statsd server over udp
     statsd_client->flush();
   }
+  // the request is long gone, free all of it at once
+  arena.reset();
 }
 void service_worker_t::enqueue_statistics(Api& api) const {
   // nothing to do without stats
@@ -1685,9 +2038,25 @@ midgard::Finally<std::function<void()>> service_worker_t::measure_scope_time(Api
     stat->set_key(action + ".info." + service_name() + ".latency_ms");
     stat->set_value(e);
     stat->set_type(timing);
+    midgard::metrics::record(action, service_name(),
+                             std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    if (midgard::tracing::enabled()) {
+      if (!trace_category) {
+        trace_category = midgard::tracing::intern(service_name());
+      }
+      midgard::tracing::record(trace_category, action.c_str(), start, start + elapsed);
+    }
+
+    // how much memory the request took in this stage
+    arena.record_statistics(api, service_name());
   });
 }
 
+midgard::metrics::scoped_timer_t service_worker_t::measure_serialization(const Api& api) const {
+  static const std::string kTyr = "tyr";
+  return midgard::metrics::scoped_timer_t(Options_Action_Enum_Name(api.options().action()), kTyr);
+}
+
 void service_worker_t::started() {
   if (statsd_client) {
     statsd_client->count("none.info." + service_name() + ".worker_started", 1, 1.f,
@@ -2,6 +2,7 @@
 #include <string>
 
 #include "tyr/actor.h"
+#include "worker.h"
 
 #include "test.h"
 
@@ -76,6 +77,43 @@ TEST(Actor, TraceAttributes) {
   EXPECT_THROW(actor.trace_attributes(request, &interrupt), test_exception_t);
 }
 
+TEST(Actor, RequestArena) {
+  request_arena_t arena;
+  for (int i = 0; i < 3; ++i) {
+    // a big request spills out of the initial block into a few more
+    auto& request = arena.request();
+    request.mutable_options()->set_action(Options::route);
+    auto* leg = request.mutable_trip()->add_routes()->add_legs();
+    for (int j = 0; j < 10000; ++j) {
+      leg->add_node()->mutable_edge()->add_name()->set_value("Tulpehocken Street");
+    }
+    EXPECT_NE(request.GetArena(), nullptr);
+    EXPECT_GT(arena.blocks_allocated(), 0);
+    EXPECT_LT(arena.blocks_allocated(), 100);
+    EXPECT_GE(arena.bytes_allocated(), arena.bytes_used());
+
+    // which we can report with the request
+    arena.record_statistics(request, "thor");
+    ASSERT_EQ(request.info().statistics_size(), 2);
+    EXPECT_EQ(request.info().statistics(0).key(), "route.info.thor.arena_blocks");
+    EXPECT_EQ(request.info().statistics(0).value(), arena.blocks_allocated());
+    EXPECT_EQ(request.info().statistics(1).key(), "route.info.thor.arena_bytes");
+
+    // after a reset only the initial block is left and small requests fit in it
+    arena.reset();
+    EXPECT_EQ(arena.blocks_allocated(), 0);
+    EXPECT_EQ(arena.bytes_allocated(), request_arena_t::kInitialBlockSize);
+    arena.request().mutable_options()->set_action(Options::locate);
+    EXPECT_EQ(arena.blocks_allocated(), 0);
+    arena.reset();
+  }
+
+  // requests that don't live in the arena are left alone
+  Api request;
+  arena.record_statistics(request, "thor");
+  EXPECT_EQ(request.info().statistics_size(), 0);
+}
+
 // TODO: test the rest of them
 
 } // namespace
@@ -5,7 +5,7 @@ import os
 from pathlib import Path
 import re
 import unittest
-from valhalla import Actor, get_config
+from valhalla import Actor, ActorPool, decode_matrix, get_config
 
 
 PWD = Path(os.path.dirname(os.path.abspath(__file__)))
@@ -112,6 +112,58 @@ class TestBindings(unittest.TestCase):
         iso = self.actor.isochrone(query)
         self.assertEqual(len(iso['features']), 6)  # 4 isochrones and the 2 point layers
 
+    def test_matrix_columnar(self):
+        query = {
+            "sources": [{"lat": 52.08813, "lon": 5.03231}, {"lat": 52.09987, "lon": 5.14913}],
+            "targets": [{"lat": 52.09987, "lon": 5.14913}, {"lat": 52.08813, "lon": 5.03231}],
+            "costing": "auto",
+            "verbose": False
+        }
+        slim = self.actor.matrix(query)['sources_to_targets']
+
+        for encoding in ('raw', 'delta', 'float16'):
+            columnar = self.actor.matrix({**query, "format": "columnar", "column_encoding": encoding})
+            self.assertIsInstance(columnar, bytes)
+
+            matrix = decode_matrix(columnar)
+            self.assertEqual(matrix['encoding'], encoding)
+            self.assertEqual(matrix['durations'].shape, (2, 2))
+            self.assertEqual(matrix['distances'].shape, (2, 2))
+            for s in range(2):
+                for t in range(2):
+                    self.assertAlmostEqual(float(matrix['distances'][s][t]), slim['distances'][s][t], delta=0.01)
+                    self.assertAlmostEqual(float(matrix['durations'][s][t]), slim['durations'][s][t], delta=2)
+
+    def test_actor_pool(self):
+        pool = ActorPool(str(self.config_path), 2)
+        locations = [{"lat": 52.08813, "lon": 5.03231}, {"lat": 52.09987, "lon": 5.14913}]
+        queries = [{"locations": locations, "costing": c} for c in ("auto", "bicycle", "pedestrian")]
+        # too few locations, errors come back as responses
+        queries.append({"locations": locations[:1], "costing": "auto"})
+
+        routes = pool.map("route", queries)
+        self.assertEqual(len(routes), 4)
+        for query, route in zip(queries[:3], routes):
+            self.assertEqual(route, self.actor.route(query))
+        self.assertIn('error_code', routes[3])
+
+        # string requests get string responses as they finish
+        finished = list(pool.imap_unordered("route", [json.dumps(q) for q in queries]))
+        self.assertEqual(sorted(i for i, _ in finished), [0, 1, 2, 3])
+        self.assertTrue(all(isinstance(res, str) for _, res in finished))
+
+        matrix_query = {"sources": locations, "targets": locations[::-1], "costing": "auto"}
+        for matrix in pool.map("matrix", [matrix_query] * 3, arrays=True):
+            self.assertEqual(matrix['durations'].shape, (2, 2))
+            self.assertEqual(matrix['distances'].shape, (2, 2))
+
+        trace_query = {"encoded_polyline": routes[0]['trip']['legs'][0]['shape'], "costing": "auto",
+                       "shape_match": "edge_walk"}
+        attributes = pool.map("trace_attributes", [trace_query], arrays=True)[0]
+        self.assertEqual(attributes['shape'].shape[1], 2)
+        self.assertGreater(len(attributes['edges']['length']), 0)
+        self.assertEqual(len(attributes['edges']['length']), len(attributes['edges']['way_id']))
+
     def test_change_config(self):
         config = get_config(self.tiles_path, self.extract_path)
         config['service_limits']['bicycle']['max_distance'] = 1
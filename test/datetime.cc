@@ -1,6 +1,10 @@
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <random>
 #include <string>
+#include <thread>
 
 #include "baldr/datetime.h"
 #include "baldr/graphconstants.h"
@@ -756,6 +760,92 @@ TEST(DateTime, DiffCaching) {
   EXPECT_GE(cache.size(), unique_tzs.size());
 }
 
+TEST(DateTime, OffsetTables) {
+  // the offset tables have to agree with the timezone library for every timezone and especially
+  // right around each of their transitions
+  const auto& tzdb = DateTime::get_tz_db();
+  const size_t utc = tzdb.to_index("Etc/UTC");
+  const auto* utc_tz = tzdb.from_index(utc);
+  std::vector<size_t> indices;
+  for (size_t index = 1; index < 1000; ++index) {
+    const auto* tz = tzdb.from_index(index);
+    if (!tz) {
+      continue;
+    }
+    indices.push_back(index);
+
+    date::sys_seconds time{};
+    const date::sys_seconds end{std::chrono::seconds(4102444800)};
+    while (time < end) {
+      const auto info = tz->get_info(time);
+      for (int64_t shift : {-1, 0}) {
+        const auto seconds = static_cast<uint64_t>(
+            std::max<int64_t>(time.time_since_epoch().count() + shift, 0));
+        ASSERT_EQ(tzdb.timezone_diff(seconds, utc, index),
+                  DateTime::timezone_diff(seconds, utc_tz, tz))
+            << tz->name() << " at " << seconds;
+      }
+      if (info.end <= time) {
+        break;
+      }
+      time = info.end;
+    }
+  }
+  ASSERT_GT(indices.size(), 300);
+
+  // any two timezones at any time, including past the end of the tables
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<size_t> index(0, indices.size() - 1);
+  std::uniform_int_distribution<uint64_t> seconds(0, 5000000000);
+  for (int i = 0; i < 100000; ++i) {
+    const auto origin = indices[index(generator)];
+    const auto dest = indices[index(generator)];
+    const auto time = seconds(generator);
+    ASSERT_EQ(tzdb.timezone_diff(time, origin, dest),
+              DateTime::timezone_diff(time, tzdb.from_index(origin), tzdb.from_index(dest)))
+        << origin << " to " << dest << " at " << time;
+  }
+
+  // unknown timezones have no difference
+  EXPECT_EQ(tzdb.timezone_diff(1586660072, 0, utc), 0);
+  EXPECT_EQ(tzdb.timezone_diff(1586660072, utc, 100000), 0);
+}
+
+TEST(DateTime, OffsetTablesConcurrentFirstUse) {
+  // a fresh db has no tables yet, threads that use the same timezones for the first time all at
+  // once race to publish them and have to come out the same as the tables made one by one
+  const auto& tzdb = DateTime::get_tz_db();
+  const DateTime::tz_db_t fresh;
+  std::vector<size_t> indices;
+  for (size_t index = 1; index < 1000; ++index) {
+    if (tzdb.from_index(index)) {
+      indices.push_back(index);
+    }
+  }
+
+  std::atomic<size_t> mismatches{0};
+  std::vector<std::thread> threads;
+  for (uint32_t seed = 0; seed < 8; ++seed) {
+    threads.emplace_back([&, seed]() {
+      std::mt19937 generator(seed);
+      std::uniform_int_distribution<size_t> index(0, indices.size() - 1);
+      std::uniform_int_distribution<uint64_t> seconds(0, 4102444799);
+      for (int i = 0; i < 20000; ++i) {
+        const auto origin = indices[index(generator)];
+        const auto dest = indices[index(generator)];
+        const auto time = seconds(generator);
+        if (fresh.timezone_diff(time, origin, dest) != tzdb.timezone_diff(time, origin, dest)) {
+          ++mismatches;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(mismatches.load(), 0);
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
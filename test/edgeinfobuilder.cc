@@ -99,6 +99,47 @@ TEST(EdgeInfoBuilder, TestWriteRead) {
   }
 }
 
+TEST(EdgeInfoBuilder, TestPackedShape) {
+  // a shape with enough points for the packed offsets to be smaller than the varints
+  std::vector<PointLL> shape;
+  for (int i = 0; i < 20; ++i) {
+    shape.emplace_back(-76.3002 + i * 0.0003, 40.0433 + (i % 3) * 0.0001);
+  }
+  EdgeInfoBuilder eibuilder;
+  eibuilder.set_wayid(1234);
+  eibuilder.set_shape(shape);
+  const auto varint_size = eibuilder.SizeOf();
+  eibuilder.pack_shape();
+  EXPECT_LT(eibuilder.SizeOf(), varint_size);
+
+  boost::shared_array<char> memblock = ToFileAndBack(eibuilder);
+  EdgeInfo ei(memblock.get(), nullptr, 0);
+  EXPECT_TRUE(ei.packed_shape());
+  EXPECT_EQ(ei.wayid(), 1234);
+  ASSERT_EQ(shape.size(), ei.shape().size());
+  for (size_t i = 0; i < shape.size(); ++i) {
+    ASSERT_TRUE(shape[i].ApproximatelyEqual(ei.shape()[i])) << "index " << i;
+  }
+
+  // the lazy shape and the encoded shape are the same as for varints
+  auto lazy = ei.lazy_shape();
+  for (const auto& p : ei.shape()) {
+    ASSERT_FALSE(lazy.empty());
+    EXPECT_EQ(lazy.pop(), p);
+  }
+  EXPECT_TRUE(lazy.empty());
+  EXPECT_EQ(ei.encoded_shape(), valhalla::midgard::encode7(shape));
+
+  // 2 points are smaller as varints so they stay that way
+  EdgeInfoBuilder short_builder;
+  short_builder.set_shape(std::vector<PointLL>{shape[0], shape[1]});
+  short_builder.pack_shape();
+  boost::shared_array<char> short_memblock = ToFileAndBack(short_builder);
+  EdgeInfo short_ei(short_memblock.get(), nullptr, 0);
+  EXPECT_FALSE(short_ei.packed_shape());
+  EXPECT_EQ(short_ei.shape().size(), 2);
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
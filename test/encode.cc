@@ -2,6 +2,7 @@
 
 #include "test.h"
 
+#include <cmath>
 #include <string>
 
 using namespace std;
@@ -608,6 +609,93 @@ TEST(Encode, VarInt) {
                   {58.26482, -169.02219}});
 }
 
+TEST(Encode, PolylineBatch) {
+  // offsets of every size from a single character to the full 32 bits
+  container_t points;
+  double lon = 0, lat = 0;
+  for (int i = 0; i < 5000; ++i) {
+    double step = (i % 7 == 0) ? 10.0 : (i % 3 == 0 ? 0.01 : 0.000001);
+    lon += (i % 2 ? step : -step) * (1 + i % 5);
+    lat += (i % 4 < 2 ? step : -step) * 0.5;
+    points.emplace_back(std::round(lon * 1e6) / 1e6, std::round(lat * 1e6) / 1e6);
+  }
+
+  // short ones too, including no points and a single one
+  for (size_t size = 0; size < 40; ++size) {
+    container_t part(points.begin(), points.begin() + size);
+    auto encoded = encode<container_t>(part);
+    Shape5Decoder<std::pair<double, double>> decoder(encoded.data(), encoded.size());
+    container_t expected;
+    while (!decoder.empty())
+      expected.push_back(decoder.pop());
+    EXPECT_EQ(decode<container_t>(encoded), expected);
+    assert_approx_equal(expected, part);
+  }
+
+  auto encoded = encode<container_t>(points);
+  assert_approx_equal(decode<container_t>(encoded), points);
+
+  // decoding point by point gives the same
+  container_t each;
+  decode_points<std::pair<double, double>>(encoded.data(), encoded.size(), 1e-6,
+                                           [&each](const auto& p) { each.push_back(p); });
+  EXPECT_EQ(each, decode<container_t>(encoded));
+
+  // cut off in the middle of a value or between the lat and the lon
+  EXPECT_THROW(decode<container_t>(encoded.substr(0, encoded.size() - 1)), std::runtime_error);
+  EXPECT_THROW(decode<container_t>(encode<container_t>(points).substr(0, 4)), std::runtime_error);
+  EXPECT_THROW(decode<container_t>(std::string(20, '~')), std::runtime_error);
+}
+
+TEST(Encode, Packed) {
+  using Point = std::pair<double, double>;
+  auto check_packed = [](const container_t& points) {
+    // packed offsets decode to the same points that the varints do
+    auto packed = encode_packed<container_t>(points);
+    auto varint = decode7<container_t>(encode7<container_t>(points));
+    EXPECT_EQ((decode<container_t, PackedShapeDecoder<Point>>(packed)), varint);
+
+    // and can be decoded a point at a time
+    PackedShapeDecoder<Point> decoder(packed.data(), packed.size());
+    for (const auto& p : varint) {
+      EXPECT_FALSE(decoder.empty());
+      EXPECT_EQ(decoder.pop(), p);
+    }
+    EXPECT_TRUE(decoder.empty());
+    return packed;
+  };
+
+  EXPECT_TRUE(check_packed({}).empty());
+  check_packed({{-76.3002, 40.0433}});
+  check_packed({{-76.3002, 40.0433}, {-76.3036, 40.043}});
+  check_packed({{0, 0}, {0, 0}, {0, 0}});
+
+  // offsets of every size, some of which need many bits
+  container_t points;
+  double lon = 13.4, lat = 52.5;
+  for (int i = 0; i < 1000; ++i) {
+    double step = (i % 97 == 0) ? 1.0 : (i % 3 == 0 ? 0.001 : 0.000001);
+    lon += (i % 2 ? step : -step) * (1 + i % 5);
+    lat += (i % 4 < 2 ? step : -step) * 0.5;
+    points.emplace_back(lon, lat);
+  }
+  for (size_t size = 3; size < 40; ++size) {
+    check_packed(container_t(points.begin(), points.begin() + size));
+  }
+  auto packed = check_packed(points);
+
+  // the largest offsets that fit and the smallest that don't
+  check_packed({{-179.999999, -89.999999}, {179.999999, 89.999999}, {-179.999999, 0}});
+  EXPECT_TRUE(encode_packed<container_t>({{-600, 0}, {600, 0}}).empty());
+
+  // cut off or padded shapes are caught
+  EXPECT_THROW((decode<container_t, PackedShapeDecoder<Point>>(packed.substr(0, packed.size() - 1))),
+               std::runtime_error);
+  EXPECT_THROW((decode<container_t, PackedShapeDecoder<Point>>(packed + '\0')), std::runtime_error);
+  EXPECT_THROW((decode<container_t, PackedShapeDecoder<Point>>(packed.substr(0, 3))),
+               std::runtime_error);
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
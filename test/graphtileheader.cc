@@ -117,6 +117,11 @@ TEST(GraphtileHeader, TestWriteRead) {
   hdr.set_textlist_offset(55511);
   EXPECT_EQ(hdr.textlist_offset(), 55511);
 
+  EXPECT_EQ(hdr.format_version(), kTileFormatVersion);
+  hdr.set_has_packed_shapes(true);
+  EXPECT_TRUE(hdr.has_packed_shapes());
+  EXPECT_GE(hdr.format_version(), kPackedShapesFormatVersion);
+
   // TODO - add tests for edge bin offsets
   uint32_t offsets[kBinCount];
   offsets[10] = 66666;
@@ -255,6 +255,24 @@ TEST_F(ExpansionTest, UnsupportedPropTypeDedupe) {
   };
 }
 
+TEST_P(ExpansionTest, Streamed) {
+  std::unordered_map<std::string, std::string> options = {{"/action", "route"}};
+  for (size_t i = 0; i < GetParam().size(); ++i) {
+    options.insert({"/expansion_properties/" + std::to_string(i), GetParam()[i]});
+  }
+  std::string expected, request;
+  gurka::do_action(Options::expansion, expansion_map, {"E", "H"}, "auto", options, {}, &expected,
+                   "break", &request);
+
+  // the same geojson handed over in pieces while the search runs
+  valhalla::tyr::actor_t actor(expansion_map.config, true);
+  std::string streamed;
+  auto returned = actor.expansion(request, nullptr, nullptr,
+                                  [&streamed](std::string_view chunk) { streamed.append(chunk); });
+  EXPECT_TRUE(returned.empty());
+  EXPECT_EQ(streamed, expected);
+}
+
 INSTANTIATE_TEST_SUITE_P(ExpandPropsTest,
                          ExpansionTest,
                          ::testing::Values(std::vector<std::string>{"edge_status"},
@@ -648,6 +648,30 @@ TEST_F(DateTimeTest, DepartAtTimeDistanceMatrix) {
   }
 }
 
+TEST_F(DateTimeTest, DepartAtCostModel) {
+  // a calibrated cost model picks the algorithm for time dependent requests too
+  auto modelled = map_tz;
+  modelled.config.put("thor.matrix_cost_model.drive.costmatrix.fixed", 1);
+  modelled.config.put("thor.matrix_cost_model.drive.timedistancematrix.fixed", 100);
+  rapidjson::Document res_doc;
+  std::string res;
+  auto api = gurka::do_action(valhalla::Options::sources_to_targets, modelled, {"A", "G"},
+                              {"A", "G"}, "auto",
+                              {{"/date_time/type", "1"}, {"/date_time/value", "2020-10-30T09:00"}},
+                              nullptr, &res);
+  res_doc.Parse(res.c_str());
+  EXPECT_EQ(api.matrix().algorithm(), Matrix::CostMatrix);
+  for (const auto& warning : api.info().warnings()) {
+    EXPECT_NE(warning.code(), 301);
+  }
+  check_date_times(api, res_doc, {"+01:00", "+00:00"}, {"Europe/Madrid", "Europe/Lisbon"});
+
+  // but CostMatrix can't arrive at a time
+  api = gurka::do_action(valhalla::Options::sources_to_targets, modelled, {"A", "G"}, {"A"}, "auto",
+                         {{"/date_time/type", "2"}, {"/date_time/value", "2020-10-30T09:00"}});
+  EXPECT_EQ(api.matrix().algorithm(), Matrix::TimeDistanceMatrix);
+}
+
 TEST_F(DateTimeTest, NoTimeZone) {
   rapidjson::Document res_doc;
   std::string res;
@@ -0,0 +1,72 @@
+#include "gurka.h"
+#include <gtest/gtest.h>
+
+using namespace valhalla;
+
+class NarrativeOptions : public ::testing::Test {
+protected:
+  static gurka::map map;
+
+  static void SetUpTestSuite() {
+    constexpr double gridsize_metres = 100;
+
+    const std::string ascii_map = R"(
+      A----B----C
+           |    |
+           D    E----F
+    )";
+
+    const gurka::ways ways = {{"ABC", {{"highway", "primary"}, {"name", "Main Street"}}},
+                              {"BD", {{"highway", "residential"}, {"name", "Side Street"}}},
+                              {"CE", {{"highway", "primary"}, {"name", "Second Street"}}},
+                              {"EF", {{"highway", "primary"}, {"name", "Third Street"}}}};
+
+    const auto layout = gurka::detail::map_to_coordinates(ascii_map, gridsize_metres);
+    map = gurka::buildtiles(layout, ways, {}, {}, "test/data/gurka_narrative_options");
+  }
+};
+
+gurka::map NarrativeOptions::map = {};
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_F(NarrativeOptions, VerbalByDefault) {
+  auto result = gurka::do_action(valhalla::Options::route, map, {"A", "F"}, "auto");
+  ASSERT_EQ(result.directions().routes(0).legs(0).maneuver_size(), 4);
+  for (const auto& maneuver : result.directions().routes(0).legs(0).maneuver()) {
+    EXPECT_FALSE(maneuver.text_instruction().empty());
+    EXPECT_FALSE(maneuver.verbal_pre_transition_instruction().empty());
+  }
+}
+
+TEST_F(NarrativeOptions, NoVerbalInstructions) {
+  auto result = gurka::do_action(valhalla::Options::route, map, {"A", "F"}, "auto",
+                                 {{"/verbal_instructions", "0"}});
+  ASSERT_EQ(result.directions().routes(0).legs(0).maneuver_size(), 4);
+  for (const auto& maneuver : result.directions().routes(0).legs(0).maneuver()) {
+    EXPECT_FALSE(maneuver.text_instruction().empty());
+    EXPECT_TRUE(maneuver.verbal_succinct_transition_instruction().empty());
+    EXPECT_TRUE(maneuver.verbal_transition_alert_instruction().empty());
+    EXPECT_TRUE(maneuver.verbal_pre_transition_instruction().empty());
+    EXPECT_TRUE(maneuver.verbal_post_transition_instruction().empty());
+  }
+}
+
+TEST_F(NarrativeOptions, ManeuverLimit) {
+  auto result = gurka::do_action(valhalla::Options::route, map, {"A", "F"}, "auto",
+                                 {{"/narrative_maneuver_limit", "2"}});
+  const auto& maneuvers = result.directions().routes(0).legs(0).maneuver();
+  ASSERT_EQ(maneuvers.size(), 4);
+  for (int i = 0; i < maneuvers.size(); ++i) {
+    EXPECT_EQ(maneuvers.Get(i).text_instruction().empty(), i >= 2);
+    EXPECT_EQ(maneuvers.Get(i).verbal_pre_transition_instruction().empty(), i >= 2);
+  }
+}
+
+TEST_F(NarrativeOptions, OsrmWithoutVoiceInstructions) {
+  auto result = gurka::do_action(valhalla::Options::route, map, {"A", "F"}, "auto",
+                                 {{"/format", "osrm"}});
+  for (const auto& maneuver : result.directions().routes(0).legs(0).maneuver()) {
+    EXPECT_FALSE(maneuver.text_instruction().empty());
+    EXPECT_TRUE(maneuver.verbal_pre_transition_instruction().empty());
+  }
+}
@@ -0,0 +1,84 @@
+#include "gurka.h"
+#include "test.h"
+
+#include <gtest/gtest.h>
+
+using namespace valhalla;
+
+class RouteLegThreads : public ::testing::Test {
+protected:
+  static gurka::map serial_map;
+  static gurka::map concurrent_map;
+
+  static void SetUpTestSuite() {
+    constexpr double gridsize = 100;
+
+    const std::string ascii_map = R"(
+      A----B----C----D
+      |    |    |    |
+      E----F----G----H
+      |    |    |    |
+      I----J----K----L-----M
+                           |
+                           N
+    )";
+
+    const gurka::ways ways = {
+        {"ABCD", {{"highway", "primary"}}},        {"EFGH", {{"highway", "residential"}}},
+        {"IJKLM", {{"highway", "secondary"}}},     {"AEI", {{"highway", "residential"}}},
+        {"BFJ", {{"highway", "tertiary"}}},        {"CGK", {{"highway", "residential"}}},
+        {"DHL", {{"highway", "tertiary"}}},        {"MN", {{"highway", "service"}}},
+        {"FG", {{"highway", "service"}, {"oneway", "yes"}}},
+    };
+
+    const auto layout = gurka::detail::map_to_coordinates(ascii_map, gridsize);
+    serial_map = gurka::buildtiles(layout, ways, {}, {}, "test/data/gurka_route_leg_threads");
+
+    // same tiles but with the legs found concurrently
+    concurrent_map = serial_map;
+    concurrent_map.config.put("thor.route_leg_threads", 3);
+  }
+
+  // the concurrently found legs must come out exactly the way the serial ones do, returns how many
+  // legs were found concurrently which is 0 when the route went the serial way
+  double expect_same_route(const std::vector<std::string>& waypoints,
+                           const std::string& costing,
+                           const std::string& stop_type = "break") {
+    std::string serial, concurrent;
+    gurka::do_action(Options::route, serial_map, waypoints, costing, {}, {}, &serial, stop_type);
+    auto result = gurka::do_action(Options::route, concurrent_map, waypoints, costing, {}, {},
+                                   &concurrent, stop_type);
+    EXPECT_EQ(serial, concurrent);
+    for (const auto& stat : result.info().statistics()) {
+      if (stat.key() == "route.info.thor.concurrent_legs")
+        return stat.value();
+    }
+    return 0;
+  }
+};
+
+gurka::map RouteLegThreads::serial_map = {};
+gurka::map RouteLegThreads::concurrent_map = {};
+
+TEST_F(RouteLegThreads, BreakLegs) {
+  EXPECT_EQ(expect_same_route({"A", "H", "I", "D", "N", "E", "C"}, "auto"), 6);
+  EXPECT_EQ(expect_same_route({"A", "H", "I", "D", "N", "E", "C"}, "pedestrian"), 6);
+}
+
+TEST_F(RouteLegThreads, ViaLegs) {
+  EXPECT_EQ(expect_same_route({"A", "H", "I", "D", "N", "E", "C"}, "auto", "via"), 6);
+}
+
+TEST_F(RouteLegThreads, ThroughLegs) {
+  // through locations tie the legs together so these are always found serially
+  EXPECT_EQ(expect_same_route({"A", "H", "I", "D", "N", "E", "C"}, "auto", "through"), 0);
+}
+
+TEST_F(RouteLegThreads, FewerWorkersThanLegs) {
+  EXPECT_EQ(expect_same_route({"A", "N", "A", "N", "A", "N", "A", "N", "A"}, "bicycle"), 8);
+}
+
+TEST_F(RouteLegThreads, ConnectedLocations) {
+  // neighbouring edges make for a unidirectional a* leg in between bidirectional ones
+  EXPECT_EQ(expect_same_route({"A", "B", "N", "M", "E"}, "auto"), 4);
+}
@@ -0,0 +1,158 @@
+#include "gurka.h"
+#include "test.h"
+
+#include <gtest/gtest.h>
+
+using namespace valhalla;
+
+class RouteSessions : public ::testing::Test {
+protected:
+  static gurka::map map;
+
+  static void SetUpTestSuite() {
+    constexpr double gridsize = 100;
+
+    const std::string ascii_map = R"(
+      A----B----C----D
+      |    |    |    |
+      E----F----G----H
+      |    |    |    |
+      I----J----K----L-----M
+                           |
+                           N
+    )";
+
+    const gurka::ways ways = {
+        {"ABCD", {{"highway", "primary"}}},        {"EFGH", {{"highway", "residential"}}},
+        {"IJKLM", {{"highway", "secondary"}}},     {"AEI", {{"highway", "residential"}}},
+        {"BFJ", {{"highway", "tertiary"}}},        {"CGK", {{"highway", "residential"}}},
+        {"DHL", {{"highway", "tertiary"}}},        {"MN", {{"highway", "service"}}},
+        {"FG", {{"highway", "service"}, {"oneway", "yes"}}},
+    };
+
+    const auto layout = gurka::detail::map_to_coordinates(ascii_map, gridsize);
+    map = gurka::buildtiles(layout, ways, {}, {}, "test/data/gurka_route_sessions");
+  }
+
+  // what the route sessions of a route did, taken from the statistics of the request
+  struct session_stats_t {
+    // the labels the session of the first pass already had, 0 for a new session
+    double reused_labels;
+    // the number of sessions kept after the route
+    double sessions;
+  };
+
+  static double statistic(const Api& api, const std::string& key) {
+    for (const auto& stat : api.info().statistics()) {
+      if (stat.key() == key)
+        return stat.value();
+    }
+    ADD_FAILURE() << "No " << key << " statistic";
+    return -1;
+  }
+
+  // routes from one origin through a single actor, whose thor worker keeps the sessions, must be
+  // the same as the ones the path algorithms find from scratch
+  std::vector<session_stats_t>
+  expect_same_routes(const gurka::map& session_map,
+                     const std::vector<std::pair<std::string, std::string>>& legs,
+                     const std::string& costing,
+                     const std::string& expected_algorithm) {
+    auto reader = test::make_clean_graphreader(session_map.config.get_child("mjolnir"));
+    tyr::actor_t actor(session_map.config, *reader, true);
+    std::vector<session_stats_t> stats;
+    for (const auto& leg : legs) {
+      auto expected = gurka::do_action(Options::route, map, {leg.first, leg.second}, costing);
+
+      Api result;
+      actor.route(gurka::detail::build_valhalla_request("locations",
+                                                        {{map.nodes.at(leg.first),
+                                                          map.nodes.at(leg.second)}},
+                                                        costing),
+                  nullptr, &result);
+      actor.cleanup();
+
+      EXPECT_EQ(gurka::detail::get_paths(result), gurka::detail::get_paths(expected))
+          << leg.first << " -> " << leg.second;
+      EXPECT_NEAR(result.directions().routes(0).legs(0).summary().length(),
+                  expected.directions().routes(0).legs(0).summary().length(), 0.001);
+      EXPECT_EQ(result.trip().routes(0).legs(0).algorithms(0), expected_algorithm);
+      stats.push_back({statistic(result, "route.info.thor.route_session_reused_labels"),
+                       statistic(result, "route.info.thor.route_sessions")});
+    }
+    return stats;
+  }
+};
+
+gurka::map RouteSessions::map = {};
+
+TEST_F(RouteSessions, OneOrigin) {
+  auto session_map = map;
+  session_map.config.put("thor.route_sessions.max_count", 2);
+  for (const auto& costing : {"auto", "pedestrian"}) {
+    // every route after the first one continues the tree of the first
+    auto stats = expect_same_routes(session_map,
+                                    {{"A", "N"}, {"A", "H"}, {"A", "E"}, {"A", "K"}, {"A", "N"}},
+                                    costing, "route_session");
+    EXPECT_EQ(stats[0].reused_labels, 0) << costing;
+    for (size_t i = 1; i < stats.size(); ++i) {
+      EXPECT_GT(stats[i].reused_labels, 0) << costing << " " << i;
+      EXPECT_GE(stats[i].reused_labels, stats[i - 1].reused_labels) << costing << " " << i;
+    }
+    for (const auto& stat : stats) {
+      EXPECT_EQ(stat.sessions, 1) << costing;
+    }
+  }
+}
+
+TEST_F(RouteSessions, Eviction) {
+  // a single session is kept so every change of origin starts over
+  auto session_map = map;
+  session_map.config.put("thor.route_sessions.max_count", 1);
+  auto stats = expect_same_routes(session_map,
+                                  {{"A", "N"}, {"N", "A"}, {"A", "H"}, {"N", "E"}, {"N", "C"}},
+                                  "auto", "route_session");
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(stats[i].reused_labels, 0) << i;
+  }
+  EXPECT_GT(stats[4].reused_labels, 0);
+  for (const auto& stat : stats) {
+    EXPECT_EQ(stat.sessions, 1);
+  }
+
+  // with two the least recently used one goes, here N once C comes along
+  session_map.config.put("thor.route_sessions.max_count", 2);
+  stats = expect_same_routes(session_map,
+                             {{"A", "N"}, {"N", "A"}, {"A", "H"}, {"C", "A"}, {"N", "E"}}, "auto",
+                             "route_session");
+  EXPECT_EQ(stats[0].reused_labels, 0);
+  EXPECT_EQ(stats[1].reused_labels, 0);
+  EXPECT_GT(stats[2].reused_labels, 0);
+  EXPECT_EQ(stats[3].reused_labels, 0);
+  EXPECT_EQ(stats[4].reused_labels, 0);
+  EXPECT_EQ(stats[0].sessions, 1);
+  for (size_t i = 1; i < stats.size(); ++i) {
+    EXPECT_EQ(stats[i].sessions, 2) << i;
+  }
+}
+
+TEST_F(RouteSessions, Expiry) {
+  // sessions which weren't used within the ttl are dropped before the next route
+  auto session_map = map;
+  session_map.config.put("thor.route_sessions.max_count", 2);
+  session_map.config.put("thor.route_sessions.ttl", 0);
+  auto stats =
+      expect_same_routes(session_map, {{"A", "N"}, {"A", "H"}, {"A", "E"}}, "auto", "route_session");
+  for (const auto& stat : stats) {
+    EXPECT_EQ(stat.reused_labels, 0);
+    EXPECT_EQ(stat.sessions, 1);
+  }
+}
+
+TEST_F(RouteSessions, LabelLimit) {
+  // sessions which can't grow far enough leave the route to the path algorithms
+  auto session_map = map;
+  session_map.config.put("thor.route_sessions.max_count", 2);
+  session_map.config.put("thor.route_sessions.max_labels", 1);
+  expect_same_routes(session_map, {{"A", "N"}, {"A", "H"}}, "auto", "bidirectional_a*");
+}
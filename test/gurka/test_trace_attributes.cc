@@ -116,3 +116,129 @@ TEST(Standalone, InterpolatedPoints) {
   ASSERT_EQ(result_doc["matched_points"][4]["edge_index"].GetInt(), 1);
   ASSERT_EQ(result_doc["matched_points"][5]["edge_index"].GetInt(), 1);
 }
+
+TEST(Standalone, BatchOfTraces) {
+  const std::string ascii_map = R"(
+    A--1--B--2--C
+          |     |
+          3     4
+          |     |
+          D--5--E--6--F)";
+
+  const gurka::ways ways = {{"ABC", {{"highway", "primary"}}},
+                            {"BD", {{"highway", "residential"}}},
+                            {"CE", {{"highway", "residential"}}},
+                            {"DEF", {{"highway", "secondary"}}}};
+
+  const double gridsize = 10;
+  const auto layout = gurka::detail::map_to_coordinates(ascii_map, gridsize);
+  auto map = gurka::buildtiles(layout, ways, {}, {}, "test/data/batch_of_traces");
+  map.config.put("meili.batch_threads", 2);
+
+  auto reader = test::make_clean_graphreader(map.config.get_child("mjolnir"));
+  tyr::actor_t actor(map.config, *reader, true);
+
+  // the batch holds every trace, the last one can't be matched
+  rapidjson::Document batch;
+  batch.Parse(R"({"costing":"auto","shape_match":"map_snap","traces":[]})");
+  std::vector<std::string> expected;
+  for (const auto& nodes : std::vector<std::vector<std::string>>{{"1", "2", "4", "6"},
+                                                                 {"3", "5", "6"},
+                                                                 {"2", "1", "3", "5"}}) {
+    std::vector<midgard::PointLL> points;
+    for (const auto& node : nodes) {
+      points.push_back(map.nodes.at(node));
+    }
+    auto request = gurka::detail::build_valhalla_request({"shape"}, {points}, "auto",
+                                                         {{"/shape_match", "map_snap"}});
+    rapidjson::Document single;
+    single.Parse(actor.trace_attributes(request));
+    expected.push_back(rapidjson::to_string(single));
+
+    // each trace takes the whole request along, what it has overrides the rest of the batch
+    rapidjson::Document request_doc;
+    request_doc.Parse(request);
+    batch["traces"].PushBack(rapidjson::Value(request_doc, batch.GetAllocator()),
+                             batch.GetAllocator());
+  }
+  rapidjson::Value empty(rapidjson::kObjectType);
+  empty.AddMember("shape", rapidjson::Value(rapidjson::kArrayType), batch.GetAllocator());
+  batch["traces"].PushBack(empty, batch.GetAllocator());
+
+  // the responses come back in order and match what each trace gets on its own
+  rapidjson::Document result;
+  result.Parse(actor.trace_attributes(rapidjson::to_string(batch)));
+  auto traces = result["traces"].GetArray();
+  ASSERT_EQ(traces.Size(), expected.size() + 1);
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(rapidjson::to_string(traces[i]), expected[i]) << "trace " << i;
+  }
+  EXPECT_TRUE(traces[expected.size()].HasMember("error_code"));
+
+  // batches are limited in size
+  map.config.put("service_limits.trace.max_batch_size", 2);
+  tyr::actor_t limited_actor(map.config, *reader, true);
+  try {
+    limited_actor.trace_attributes(rapidjson::to_string(batch));
+    FAIL() << "Expected the batch to be too large";
+  } catch (const valhalla_exception_t& e) { EXPECT_EQ(e.code, 169); }
+
+  // an interrupt while matching the last trace cancels the batch instead of becoming its error
+  size_t interrupt_calls = 0;
+  const std::function<void()> interrupt = [&interrupt_calls]() {
+    if (++interrupt_calls > 1)
+      throw std::runtime_error("Cancelled");
+  };
+  rapidjson::Document single_batch;
+  single_batch.Parse(rapidjson::to_string(batch));
+  single_batch["traces"].Erase(single_batch["traces"].Begin() + 1, single_batch["traces"].End());
+  map.config.put("meili.batch_threads", 0);
+  tyr::actor_t interrupted_actor(map.config, *reader, true);
+  EXPECT_THROW(interrupted_actor.trace_attributes(rapidjson::to_string(single_batch), &interrupt),
+               std::runtime_error);
+}
+
+TEST(Standalone, SelectedAttributesOnly) {
+  const std::string ascii_map = R"(
+    A--1--B--2--C--3--D
+          |     |
+          E     F
+         )";
+
+  const gurka::ways ways = {{"ABCD", {{"highway", "primary"}, {"name", "Main"}}},
+                            {"BE", {{"highway", "residential"}, {"name", "Side"}}},
+                            {"CF",
+                             {{"highway", "motorway_link"},
+                              {"oneway", "yes"},
+                              {"destination", "Town"},
+                              {"junction:ref", "4"}}}};
+
+  const double gridsize = 10;
+  const auto layout = gurka::detail::map_to_coordinates(ascii_map, gridsize);
+  auto map = gurka::buildtiles(layout, ways, {}, {}, "test/data/selected_attributes");
+
+  std::string all_json;
+  gurka::do_action(valhalla::Options::trace_attributes, map, {"1", "2", "3"}, "auto", {}, {},
+                   &all_json, "via");
+  std::string selected_json;
+  gurka::do_action(valhalla::Options::trace_attributes, map, {"1", "2", "3"}, "auto",
+                   {{"/filters/action", "include"},
+                    {"/filters/attributes/0", "edge.id"},
+                    {"/filters/attributes/1", "edge.speed"}},
+                   {}, &selected_json, "via");
+
+  rapidjson::Document all, selected;
+  all.Parse(all_json);
+  selected.Parse(selected_json);
+
+  // the edges only have what was asked for and it is the same as with everything else around it
+  ASSERT_FALSE(selected.HasMember("shape"));
+  auto all_edges = all["edges"].GetArray();
+  auto selected_edges = selected["edges"].GetArray();
+  ASSERT_EQ(selected_edges.Size(), all_edges.Size());
+  for (size_t i = 0; i < selected_edges.Size(); ++i) {
+    EXPECT_EQ(selected_edges[i].MemberCount(), 2);
+    EXPECT_EQ(selected_edges[i]["id"].GetUint64(), all_edges[i]["id"].GetUint64());
+    EXPECT_EQ(selected_edges[i]["speed"].GetDouble(), all_edges[i]["speed"].GetDouble());
+  }
+}
@@ -0,0 +1,109 @@
+#include "midgard/histogram.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "test.h"
+
+using namespace valhalla::midgard;
+
+namespace {
+
+TEST(Histogram, Empty) {
+  Histogram histogram;
+  EXPECT_EQ(histogram.count(), 0);
+  EXPECT_EQ(histogram.min(), 0);
+  EXPECT_EQ(histogram.max(), 0);
+  EXPECT_EQ(histogram.mean(), 0);
+  EXPECT_EQ(histogram.percentile(50), 0);
+}
+
+TEST(Histogram, SmallValuesAreExact) {
+  Histogram histogram;
+  for (uint64_t value = 1; value <= 100; ++value) {
+    histogram.record(value);
+  }
+  EXPECT_EQ(histogram.count(), 100);
+  EXPECT_EQ(histogram.min(), 1);
+  EXPECT_EQ(histogram.max(), 100);
+  EXPECT_DOUBLE_EQ(histogram.mean(), 50.5);
+  EXPECT_EQ(histogram.percentile(0), 1);
+  EXPECT_EQ(histogram.percentile(50), 50);
+  EXPECT_EQ(histogram.percentile(99), 99);
+  EXPECT_EQ(histogram.percentile(100), 100);
+}
+
+TEST(Histogram, RelativeError) {
+  // every percentile of values spread over many magnitudes is within the precision of the exact one
+  std::mt19937_64 generator(42);
+  std::lognormal_distribution<double> distribution(8, 3);
+  Histogram histogram;
+  std::vector<uint64_t> values;
+  for (int i = 0; i < 100000; ++i) {
+    values.push_back(static_cast<uint64_t>(distribution(generator)));
+    histogram.record(values.back());
+  }
+  std::sort(values.begin(), values.end());
+  for (double percentile : {1., 10., 25., 50., 75., 90., 99., 99.9, 99.99}) {
+    auto exact = values[static_cast<size_t>(percentile / 100. * values.size() + .5) - 1];
+    auto reported = histogram.percentile(percentile);
+    EXPECT_GE(reported, exact) << percentile;
+    EXPECT_LE(reported, exact + exact / 64) << percentile;
+  }
+  EXPECT_EQ(histogram.percentile(100), values.back());
+  EXPECT_EQ(histogram.max(), values.back());
+  EXPECT_EQ(histogram.min(), values.front());
+}
+
+TEST(Histogram, ExtremeValues) {
+  Histogram histogram;
+  histogram.record(0);
+  histogram.record(std::numeric_limits<uint64_t>::max());
+  EXPECT_EQ(histogram.percentile(50), 0);
+  EXPECT_EQ(histogram.percentile(100), std::numeric_limits<uint64_t>::max());
+
+  size_t buckets = 0;
+  uint64_t previous = 0;
+  histogram.for_each_bucket([&](uint64_t value, uint64_t count) {
+    EXPECT_TRUE(buckets == 0 || value > previous);
+    EXPECT_EQ(count, 1);
+    previous = value;
+    ++buckets;
+  });
+  EXPECT_EQ(buckets, 2);
+}
+
+TEST(Histogram, Merge) {
+  Histogram a, b, both;
+  for (uint64_t value = 0; value < 10000; value += 7) {
+    (value % 2 ? a : b).record(value * value);
+    both.record(value * value);
+  }
+  a.merge(b);
+  EXPECT_EQ(a.count(), both.count());
+  EXPECT_EQ(a.min(), both.min());
+  EXPECT_EQ(a.max(), both.max());
+  EXPECT_DOUBLE_EQ(a.sum(), both.sum());
+  for (double percentile : {0., 33., 50., 66., 95., 100.}) {
+    EXPECT_EQ(a.percentile(percentile), both.percentile(percentile));
+  }
+
+  EXPECT_THROW(a.merge(Histogram(5)), std::invalid_argument);
+  EXPECT_THROW(Histogram(0), std::invalid_argument);
+  EXPECT_THROW(Histogram(17), std::invalid_argument);
+
+  a.reset();
+  EXPECT_EQ(a.count(), 0);
+  EXPECT_EQ(a.percentile(50), 0);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,6 +1,7 @@
 #include "gurka/gurka.h"
 #include "test.h"
 
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -568,6 +569,70 @@ TEST(Matrix, slim_matrix) {
   EXPECT_TRUE(json.HasMember("units"));
 }
 
+TEST(Matrix, columnar_matrix) {
+  tyr::actor_t actor(cfg, true);
+
+  rapidjson::Document json;
+  json.Parse(actor.matrix(test_matrix_verbose_false));
+  ASSERT_FALSE(json.HasParseError());
+  const auto& durations = json["sources_to_targets"]["durations"];
+  const auto& distances = json["sources_to_targets"]["distances"];
+
+  for (const std::string encoding : {"raw", "delta", "float16"}) {
+    rapidjson::Document request;
+    request.Parse(test_matrix_verbose_false);
+    rapidjson::Pointer("/format").Set(request, "columnar");
+    rapidjson::Pointer("/column_encoding").Set(request, encoding);
+    auto bytes = actor.matrix(rapidjson::to_string(request));
+
+    tyr::columnar_matrix_header_t header;
+    ASSERT_GE(bytes.size(), sizeof(header));
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    EXPECT_EQ(std::string(header.magic, 4), "VMTX");
+    EXPECT_EQ(header.version, tyr::kColumnarMatrixVersion);
+    Options::ColumnEncoding column_encoding;
+    ASSERT_TRUE(Options_ColumnEncoding_Enum_Parse(encoding, &column_encoding));
+    EXPECT_EQ(header.encoding, column_encoding);
+    EXPECT_EQ(header.sources, 2);
+    EXPECT_EQ(header.targets, 3);
+    ASSERT_EQ(bytes.size(), sizeof(header) + 2 * header.column_bytes);
+    EXPECT_EQ(header.column_bytes, encoding == "float16" ? 16 : 24);
+
+    const char* times = bytes.data() + sizeof(header);
+    const char* dists = times + header.column_bytes;
+    for (uint32_t s = 0; s < header.sources; ++s) {
+      int32_t time = 0, dist = 0;
+      for (uint32_t t = 0; t < header.targets; ++t) {
+        const size_t i = s * header.targets + t;
+        const double expected_time = durations[s][t].GetDouble();
+        const double expected_dist = distances[s][t].GetDouble();
+        if (encoding == "raw") {
+          float cell[2];
+          std::memcpy(&cell[0], times + i * sizeof(float), sizeof(float));
+          std::memcpy(&cell[1], dists + i * sizeof(float), sizeof(float));
+          EXPECT_NEAR(cell[0], expected_time, 1.0);
+          EXPECT_NEAR(cell[1], expected_dist, 0.001);
+        } else if (encoding == "delta") {
+          int32_t cell[2];
+          std::memcpy(&cell[0], times + i * sizeof(int32_t), sizeof(int32_t));
+          std::memcpy(&cell[1], dists + i * sizeof(int32_t), sizeof(int32_t));
+          time += cell[0];
+          dist += cell[1];
+          EXPECT_EQ(time, expected_time);
+          EXPECT_NEAR(dist / 1000.0, expected_dist, 0.0011);
+        }
+      }
+    }
+
+    // streamed it arrives as the same bytes
+    std::string streamed;
+    auto returned = actor.matrix(rapidjson::to_string(request), nullptr, nullptr,
+                                 [&streamed](std::string_view chunk) { streamed.append(chunk); });
+    EXPECT_TRUE(returned.empty());
+    EXPECT_EQ(streamed, bytes);
+  }
+}
+
 /**************************************************************************************************/
 
 int main(int argc, char* argv[]) {
@@ -0,0 +1,113 @@
+#include "thor/matrix_cost_model.h"
+
+#include <boost/property_tree/json_parser.hpp>
+#include <sstream>
+
+#include "test.h"
+
+using namespace valhalla;
+using namespace valhalla::thor;
+
+namespace {
+
+boost::property_tree::ptree config(const std::string& json) {
+  boost::property_tree::ptree pt;
+  std::stringstream ss(json);
+  boost::property_tree::read_json(ss, pt);
+  return pt;
+}
+
+// costmatrix grows with the number of locations, timedistancematrix with the product of them
+const auto kConfig = config(R"({
+  "drive": {
+    "costmatrix": {"fixed": 1, "per_location": 2, "per_search_km": 0.5},
+    "timedistancematrix": {"fixed": 2, "per_search_km2": 0.25, "per_pair": 1,
+                           "time_dependent_factor": 2}
+  },
+  "pedestrian": {
+    "costmatrix": {"fixed": 1}
+  }
+})");
+
+TEST(MatrixCostModel, Uncalibrated) {
+  MatrixCostModel model;
+  const matrix_features_t features{1, 1, 1.f, false};
+  EXPECT_FALSE(model.calibrated(sif::TravelMode::kDrive));
+  EXPECT_FALSE(model.predict(Matrix::CostMatrix, sif::TravelMode::kDrive, features));
+  EXPECT_FALSE(model.predict(Matrix::TimeDistanceMatrix, sif::TravelMode::kDrive, features));
+  EXPECT_EQ(model.select(sif::TravelMode::kDrive, features), Matrix::CostMatrix);
+}
+
+TEST(MatrixCostModel, Calibrated) {
+  MatrixCostModel model(kConfig);
+  EXPECT_TRUE(model.calibrated(sif::TravelMode::kDrive));
+  // a travel mode needs both algorithms to be calibrated
+  EXPECT_FALSE(model.calibrated(sif::TravelMode::kPedestrian));
+  EXPECT_FALSE(model.calibrated(sif::TravelMode::kBicycle));
+  EXPECT_FALSE(model.calibrated(sif::TravelMode::kMaxTravelMode));
+  EXPECT_TRUE(model.predict(Matrix::CostMatrix, sif::TravelMode::kPedestrian, {1, 1, 1.f, false}));
+  EXPECT_FALSE(
+      model.predict(Matrix::TimeDistanceMatrix, sif::TravelMode::kPedestrian, {1, 1, 1.f, false}));
+}
+
+TEST(MatrixCostModel, Predict) {
+  MatrixCostModel model(kConfig);
+  const matrix_features_t features{2, 3, 4.f, false};
+  // 1 + 2 * 5 locations + 5 searches * 0.5 * 4 km
+  EXPECT_FLOAT_EQ(*model.predict(Matrix::CostMatrix, sif::TravelMode::kDrive, features), 21.f);
+  // 2 + 2 searches * 0.25 * 16 km^2 + 6 pairs
+  EXPECT_FLOAT_EQ(*model.predict(Matrix::TimeDistanceMatrix, sif::TravelMode::kDrive, features),
+                  16.f);
+
+  // only time dependent requests are scaled
+  const matrix_features_t time_dependent{2, 3, 4.f, true};
+  EXPECT_FLOAT_EQ(*model.predict(Matrix::CostMatrix, sif::TravelMode::kDrive, time_dependent), 21.f);
+  EXPECT_FLOAT_EQ(
+      *model.predict(Matrix::TimeDistanceMatrix, sif::TravelMode::kDrive, time_dependent), 32.f);
+}
+
+TEST(MatrixCostModel, Select) {
+  MatrixCostModel model(kConfig);
+  // few locations close together are cheaper one search at a time
+  EXPECT_EQ(model.select(sif::TravelMode::kDrive, {2, 3, 4.f, false}), Matrix::TimeDistanceMatrix);
+  // the time dependent factor tips it over
+  EXPECT_EQ(model.select(sif::TravelMode::kDrive, {2, 3, 4.f, true}), Matrix::CostMatrix);
+  // many to many is cheaper bidirectionally
+  EXPECT_EQ(model.select(sif::TravelMode::kDrive, {50, 50, 4.f, false}), Matrix::CostMatrix);
+  // so is far apart
+  EXPECT_EQ(model.select(sif::TravelMode::kDrive, {2, 3, 100.f, false}), Matrix::CostMatrix);
+  // uncalibrated modes never pick timedistancematrix
+  EXPECT_EQ(model.select(sif::TravelMode::kPedestrian, {1, 1, 0.f, false}), Matrix::CostMatrix);
+}
+
+TEST(MatrixCostModel, Features) {
+  Options options;
+  auto* source = options.add_sources()->mutable_ll();
+  source->set_lng(5.0);
+  source->set_lat(52.0);
+  for (double lat : {52.0, 52.1}) {
+    auto* target = options.add_targets()->mutable_ll();
+    target->set_lng(5.1);
+    target->set_lat(lat);
+  }
+
+  auto features = MatrixCostModel::features(options, true);
+  EXPECT_EQ(features.sources, 1);
+  EXPECT_EQ(features.targets, 2);
+  EXPECT_TRUE(features.time_dependent);
+  // the diagonal of 0.1 by 0.1 degrees at 52 degrees north
+  EXPECT_NEAR(features.spread, 13.1f, 0.2f);
+
+  features = MatrixCostModel::features(Options{}, false);
+  EXPECT_EQ(features.sources, 0);
+  EXPECT_EQ(features.targets, 0);
+  EXPECT_EQ(features.spread, 0.f);
+  EXPECT_FALSE(features.time_dependent);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,73 @@
+#include "midgard/metrics.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "test.h"
+
+using namespace valhalla::midgard;
+
+namespace {
+
+const std::string kRoute = "route", kThor = "thor", kTileLoad = "tile_load";
+
+TEST(Metrics, DisabledByDefault) {
+  metrics::reset();
+  EXPECT_FALSE(metrics::enabled());
+  metrics::record(kRoute, kThor, 1000);
+  metrics::flush();
+  EXPECT_EQ(metrics::render().find("stage=\"thor\""), std::string::npos);
+}
+
+TEST(Metrics, Render) {
+  metrics::reset();
+  metrics::enable(true);
+  for (uint64_t i = 1; i <= 100; ++i) {
+    metrics::record(kRoute, kThor, i * 1000);
+  }
+  { metrics::scoped_timer_t timer(metrics::kNoAction, kTileLoad); }
+  metrics::flush();
+  metrics::enable(false);
+
+  auto text = metrics::render();
+  EXPECT_NE(text.find("# TYPE valhalla_latency_seconds summary\n"), std::string::npos);
+  EXPECT_NE(text.find("valhalla_latency_seconds_count{action=\"route\",stage=\"thor\"} 100\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("valhalla_latency_seconds_sum{action=\"route\",stage=\"thor\"} 5.05\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("valhalla_latency_seconds{action=\"route\",stage=\"thor\",quantile=\"0.5\"} "
+                      "0.05"),
+            std::string::npos)
+      << text;
+  EXPECT_NE(text.find("valhalla_latency_seconds_count{action=\"none\",stage=\"tile_load\"} 1\n"),
+            std::string::npos);
+}
+
+TEST(Metrics, Threads) {
+  // what threads recorded is merged when they exit
+  metrics::reset();
+  metrics::enable(true);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([]() {
+      for (int i = 0; i < 1000; ++i) {
+        metrics::record(kRoute, kThor, 10);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  metrics::enable(false);
+  EXPECT_NE(metrics::render().find(
+                "valhalla_latency_seconds_count{action=\"route\",stage=\"thor\"} 4000\n"),
+            std::string::npos);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
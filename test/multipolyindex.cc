@@ -0,0 +1,89 @@
+#include <map>
+#include <vector>
+
+#include "mjolnir/admin.h"
+
+#include "test.h"
+
+using namespace valhalla::midgard;
+using namespace valhalla::mjolnir;
+
+namespace {
+
+multi_polygon_type make_poly(const std::string& wkt) {
+  multi_polygon_type poly;
+  bg::read_wkt(wkt, poly);
+  return poly;
+}
+
+// every point of a fine grid over (and a bit past) the tile has to resolve to what the linear scan
+// over the polygons would give us, including points sitting on polygon and cell borders
+void check_grid(const std::multimap<uint32_t, multi_polygon_type>& polys,
+                const AABB2<PointLL>& bounds,
+                const MultiPolyIndex::final_predicate_t& is_final,
+                const std::function<uint32_t(const PointLL&)>& expected) {
+  MultiPolyIndex index(polys, bounds, is_final);
+  constexpr int kSteps = 100;
+  for (int x = -5; x <= kSteps + 5; ++x) {
+    for (int y = -5; y <= kSteps + 5; ++y) {
+      PointLL ll(bounds.minx() + x * bounds.Width() / kSteps,
+                 bounds.miny() + y * bounds.Height() / kSteps);
+      EXPECT_EQ(index.GetId(ll), expected(ll)) << ll.lng() << "," << ll.lat();
+    }
+  }
+}
+
+TEST(MultiPolyIndex, MatchesLinearScan) {
+  std::multimap<uint32_t, multi_polygon_type> polys;
+  polys.emplace(1, make_poly("MULTIPOLYGON(((0 0,0 0.13,0.13 0.13,0.13 0,0 0)))"));
+  polys.emplace(2, make_poly("MULTIPOLYGON(((0.1 0.1,0.1 0.3,0.4 0.3,0.1 0.1)),"
+                             "((0.2 0.05,0.2 0.07,0.22 0.07,0.22 0.05,0.2 0.05)))"));
+  polys.emplace(3, make_poly("MULTIPOLYGON(((0.05 -1,0.05 1,0.5 1,0.5 -1,0.05 -1),"
+                             "(0.3 0.1,0.3 0.2,0.35 0.2,0.35 0.1,0.3 0.1)))"));
+  AABB2<PointLL> bounds(0, 0, 0.25, 0.25);
+
+  check_grid(polys, bounds, {}, [&polys](const PointLL& ll) { return GetMultiPolyId(polys, ll); });
+
+  MultiPolyIndex index(polys, bounds);
+  EXPECT_GT(index.boundary_cell_count(), 0);
+  EXPECT_LT(index.boundary_cell_count(),
+            MultiPolyIndex::kDefaultGridSize * MultiPolyIndex::kDefaultGridSize);
+}
+
+TEST(MultiPolyIndex, NonFinalPolys) {
+  // odd ids are countries which only win if no state covers the point
+  std::multimap<uint32_t, multi_polygon_type> polys;
+  polys.emplace(1, make_poly("MULTIPOLYGON(((0 0,0 1,1 1,1 0,0 0)))"));
+  polys.emplace(2, make_poly("MULTIPOLYGON(((0.1 0.1,0.1 0.2,0.2 0.2,0.2 0.1,0.1 0.1)))"));
+  polys.emplace(3, make_poly("MULTIPOLYGON(((0.15 0,0.15 1,1 1,1 0,0.15 0)))"));
+  AABB2<PointLL> bounds(0, 0, 0.25, 0.25);
+  auto is_state = [](uint32_t id) { return id % 2 == 0; };
+
+  check_grid(polys, bounds, is_state, [&](const PointLL& ll) {
+    uint32_t index = 0;
+    point_type p(ll.lng(), ll.lat());
+    for (const auto& poly : polys) {
+      if (bg::covered_by(p, poly.second, bg::strategy::within::crossings_multiply<point_type>())) {
+        if (is_state(poly.first))
+          return poly.first;
+        index = poly.first;
+      }
+    }
+    return index;
+  });
+}
+
+TEST(MultiPolyIndex, Empty) {
+  std::multimap<uint32_t, multi_polygon_type> polys;
+  MultiPolyIndex index(polys, AABB2<PointLL>(0, 0, 0.25, 0.25));
+  EXPECT_EQ(index.GetId({0.1, 0.1}), 0);
+  EXPECT_EQ(index.GetId({1, 1}), 0);
+  EXPECT_EQ(index.boundary_cell_count(), 0);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
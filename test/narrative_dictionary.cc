@@ -1339,6 +1339,37 @@ TEST(NarrativeDictionary, test_en_US_approach_verbal_alert) {
   validate(us_customary_lengths, kExpectedUsCustomaryLengths);
 }
 
+TEST(NarrativeDictionary, test_en_US_phrase_templates) {
+  std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
+
+  // Every phrase is compiled into a template with the same id
+  for (const auto& phrase : dictionary->start_subset.phrases) {
+    const auto& phrase_template = dictionary->start_subset.GetTemplate(std::stoul(phrase.first));
+    EXPECT_EQ(phrase_template.phrase(), phrase.second);
+  }
+  EXPECT_THROW(dictionary->start_subset.GetTemplate(3), std::out_of_range);
+  EXPECT_THROW(dictionary->start_subset.GetTemplate(100), std::out_of_range);
+
+  // "2": "Head <CARDINAL_DIRECTION> on <BEGIN_STREET_NAMES>. Continue on <STREET_NAMES>."
+  std::string instruction = "previous contents";
+  dictionary->start_subset.GetTemplate(2).Format(instruction,
+                                                 {{PhraseTag::kCardinalDirection, "north"},
+                                                  {PhraseTag::kStreetNames, "Main Street"},
+                                                  {PhraseTag::kBeginStreetNames, "1st Avenue"}});
+  EXPECT_EQ(instruction, "Head north on 1st Avenue. Continue on Main Street.");
+
+  // Tags without a value are written as is and empty values remove the tag
+  dictionary->start_subset.GetTemplate(2).Format(instruction,
+                                                 {{PhraseTag::kCardinalDirection, ""},
+                                                  {PhraseTag::kLength, "1 mile"}});
+  EXPECT_EQ(instruction, "Head  on <BEGIN_STREET_NAMES>. Continue on <STREET_NAMES>.");
+
+  // Unknown tags stay literal text and tags may repeat
+  PhraseTemplate phrase_template("<STREET_NAME> <STREET_NAMES>, <STREET_NAMES> <");
+  phrase_template.Format(instruction, {{PhraseTag::kStreetNames, "A"}});
+  EXPECT_EQ(instruction, "<STREET_NAME> A, A <");
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
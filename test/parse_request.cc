@@ -2,6 +2,7 @@
 #include <string>
 #include <vector>
 
+#include "midgard/encoded.h"
 #include "proto/options.pb.h"
 #include "proto_conversions.h"
 #include "sif/costconstants.h"
@@ -1656,6 +1657,60 @@ void set_disable_hierarchy_pruning(Options& options, Costing::Type type) {
   co->set_disable_hierarchy_pruning(true);
 }
 
+std::string get_trace_request_str(size_t points, const std::string& extra_point_member = "") {
+  std::string request = R"({"costing":"auto","shape_match":"map_snap","shape":[)";
+  for (size_t i = 0; i < points; ++i) {
+    request += R"({"lat":)" + std::to_string(52.09 + i * 1e-5) + R"(,"lon":)" +
+               std::to_string(5.11 + i * 1e-5) + R"(,"time":)" + std::to_string(i) +
+               R"(,"radius":)" + std::to_string(i % 50) + extra_point_member + "}";
+    request += i + 1 < points ? "," : "";
+  }
+  return request + R"(],"trace_options":{"search_radius":25}})";
+}
+
+TEST(ParseRequest, test_streamed_shape) {
+  // plain points are read straight into the options, the name forces the regular dom parse
+  auto streamed = get_request(get_trace_request_str(100), Options::trace_route);
+  auto dom = get_request(get_trace_request_str(100, R"(,"name":"x")"), Options::trace_route);
+
+  ASSERT_EQ(streamed.options().shape_size(), 100);
+  ASSERT_EQ(dom.options().shape_size(), 100);
+  for (int i = 0; i < dom.options().shape_size(); ++i) {
+    auto* loc = dom.mutable_options()->mutable_shape(i);
+    EXPECT_EQ(loc->name(), "x");
+    loc->clear_name();
+    EXPECT_EQ(streamed.options().shape(i).SerializeAsString(), loc->SerializeAsString());
+  }
+  EXPECT_EQ(streamed.options().shape(42).radius(), 42u);
+  EXPECT_EQ(streamed.options().shape(42).time(), 42);
+  EXPECT_EQ(streamed.options().search_radius(), 25);
+
+  // points still have to be valid
+  EXPECT_THROW(get_request(R"({"costing":"auto","shape":[{"lat":91,"lon":5}]})",
+                           Options::trace_route),
+               valhalla_exception_t);
+  EXPECT_THROW(get_request(R"({"costing":"auto","shape":[{"lat":52.1}]})", Options::trace_route),
+               valhalla_exception_t);
+  EXPECT_THROW(get_request(R"({"costing":"auto","shape":[{"lat":52.1,"lon":5}})",
+                           Options::trace_route),
+               valhalla_exception_t);
+}
+
+TEST(ParseRequest, test_large_shape) {
+  // every way of passing a long shape ends up with all of its points
+  constexpr int kPoints = 10000;
+  std::vector<midgard::PointLL> points;
+  for (int i = 0; i < kPoints; ++i) {
+    points.emplace_back(5.11 + i * 1e-5, 52.09 + i * 1e-5);
+  }
+  for (const auto& request :
+       {get_trace_request_str(kPoints), get_trace_request_str(kPoints, R"(,"name":"x")"),
+        R"({"costing":"auto","encoded_polyline":")" + midgard::encode(points) + R"("})"}) {
+    auto api = get_request(request, Options::trace_route);
+    ASSERT_EQ(api.options().shape_size(), kPoints);
+  }
+}
+
 // test disable_hierarchy_pruning
 class HierarchyTest : public ::testing::TestWithParam<Costing::Type> {
 protected:
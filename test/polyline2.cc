@@ -2,6 +2,7 @@
 #include <cstdint>
 
 #include <algorithm>
+#include <list>
 #include <vector>
 
 #include "midgard/point2.h"
@@ -235,6 +236,56 @@ TEST(Polyline2, PeuckerSelfIntersectionTest2) {
   }
 }
 
+TEST(Polyline2, TestGeneralizeListAndVector) {
+  // a zigzag that folds back over itself so that avoiding self-intersections matters
+  std::vector<PointLL> points;
+  for (int i = 0; i < 200; ++i) {
+    points.emplace_back(-76.5 + 0.0001 * i, 40.3 + 0.00005 * (i % 7) - 0.0002 * (i > 100));
+  }
+  for (bool avoid_self_intersections : {false, true}) {
+    for (double gen_factor : {1.0, 5.0, 20.0}) {
+      std::vector<PointLL> vector_points = points;
+      std::list<PointLL> list_points(points.begin(), points.end());
+      Polyline2<PointLL>::Generalize(vector_points, gen_factor, {5, 50}, avoid_self_intersections);
+      Polyline2<PointLL>::Generalize(list_points, gen_factor, {5, 50}, avoid_self_intersections);
+      EXPECT_EQ(vector_points, std::vector<PointLL>(list_points.begin(), list_points.end()));
+      EXPECT_LT(vector_points.size(), points.size());
+      EXPECT_NE(std::find(vector_points.begin(), vector_points.end(), points[5]),
+                vector_points.end());
+      EXPECT_NE(std::find(vector_points.begin(), vector_points.end(), points[50]),
+                vector_points.end());
+    }
+  }
+}
+
+TEST(Polyline2, TestGeneralizeAfterLargerPolyline) {
+  // the buffers grown for a large polyline are released for the small one after it, which has
+  // to come out the same as before either way
+  std::vector<PointLL> small, large;
+  for (int i = 0; i < 200; ++i) {
+    small.emplace_back(-76.5 + 0.0001 * i, 40.3 + 0.00005 * (i % 7) - 0.0002 * (i > 100));
+  }
+  for (int i = 0; i < 20000; ++i) {
+    large.emplace_back(-76.5 + 0.00001 * i, 40.3 + 0.000001 * (i % 11));
+  }
+  for (bool avoid_self_intersections : {false, true}) {
+    auto expected = small;
+    Polyline2<PointLL>::Generalize(expected, 5.0, {5, 50}, avoid_self_intersections);
+    auto generalized = large;
+    Polyline2<PointLL>::Generalize(generalized, 5.0, {}, avoid_self_intersections);
+    std::list<PointLL> list_points(large.begin(), large.end());
+    Polyline2<PointLL>::Generalize(list_points, 5.0, {}, avoid_self_intersections);
+    EXPECT_LT(generalized.size(), large.size());
+
+    generalized = small;
+    Polyline2<PointLL>::Generalize(generalized, 5.0, {5, 50}, avoid_self_intersections);
+    EXPECT_EQ(generalized, expected);
+    list_points.assign(small.begin(), small.end());
+    Polyline2<PointLL>::Generalize(list_points, 5.0, {5, 50}, avoid_self_intersections);
+    EXPECT_EQ(std::vector<PointLL>(list_points.begin(), list_points.end()), expected);
+  }
+}
+
 void TryClosestPoint(const Polyline2<Point2>& pl, const Point2& a, const Point2& b) {
   auto result = pl.ClosestPoint(a);
   EXPECT_EQ(std::get<0>(result), b);
@@ -122,6 +122,111 @@ TEST(Reach, transition_misscount) {
   EXPECT_EQ(reach.outbound, 7);
 }
 
+// exposes the label lookup and the exact expansion so we can compare them
+struct TestableReach : public Reach {
+  using Reach::exact;
+  using Reach::labelled;
+};
+
+// a costing with the defaults a request gets, plus whatever costing options are given
+vs::cost_ptr_t make_costing(Costing::Type type, const std::string& costing_options = "{}") {
+  Options options;
+  options.set_costing_type(type);
+  rapidjson::Document doc;
+  doc.Parse(R"({"costing_options":{")" + Costing_Enum_Name(type) + R"(":)" + costing_options +
+            "}}");
+  vs::ParseCosting(doc, "/costing_options", options);
+  return vs::CostFactory{}.Create(options);
+}
+
+TEST(Reach, labels_are_lower_bounds) {
+  GraphReader reader(conf.get_child("mjolnir"));
+  TestableReach reach_finder;
+
+  for (const auto& costing : {make_costing(Costing::auto_), make_costing(Costing::pedestrian),
+                              make_costing(Costing::bicycle), make_costing(Costing::truck),
+                              make_costing(Costing::auto_, R"({"exclude_unpaved":true})")}) {
+    for (auto tile_id : reader.GetTileSet()) {
+      auto tile = reader.GetGraphTile(tile_id);
+      for (GraphId edge_id = tile->header()->graphid();
+           edge_id.id() < tile->header()->directededgecount(); ++edge_id) {
+        // the labels may never claim more than what an expansion actually finds
+        const auto* edge = tile->directededge(edge_id);
+        auto labelled = reach_finder.labelled(edge, edge_id, reader, costing);
+        if (labelled.outbound == 0 && labelled.inbound == 0)
+          continue;
+        auto max_reach = std::max<uint32_t>(labelled.outbound, labelled.inbound);
+        auto exact = reach_finder.exact(edge, edge_id, max_reach, reader, costing);
+        EXPECT_LE(labelled.outbound, exact.outbound) << std::to_string(edge_id.value);
+        EXPECT_LE(labelled.inbound, exact.inbound) << std::to_string(edge_id.value);
+      }
+    }
+  }
+}
+
+TEST(Reach, labels_need_default_costing) {
+  // costings which rule out more than the labels were computed with dont get to use them
+  EXPECT_TRUE(make_costing(Costing::auto_)->ReachLabelsApply());
+  EXPECT_TRUE(make_costing(Costing::truck)->ReachLabelsApply());
+  EXPECT_TRUE(make_costing(Costing::bicycle)->ReachLabelsApply());
+  EXPECT_TRUE(make_costing(Costing::pedestrian)->ReachLabelsApply());
+  EXPECT_FALSE(make_costing(Costing::auto_, R"({"exclude_unpaved":true})")->ReachLabelsApply());
+  EXPECT_FALSE(make_costing(Costing::auto_, R"({"exclude_tolls":true})")->ReachLabelsApply());
+  EXPECT_FALSE(make_costing(Costing::truck, R"({"exclude_bridges":true})")->ReachLabelsApply());
+  EXPECT_FALSE(make_costing(Costing::bicycle, R"({"avoid_bad_surfaces":1})")->ReachLabelsApply());
+  EXPECT_FALSE(
+      make_costing(Costing::pedestrian, R"({"max_hiking_difficulty":0})")->ReachLabelsApply());
+  EXPECT_FALSE(make_costing(Costing::pedestrian, R"({"type":"wheelchair"})")->ReachLabelsApply());
+  EXPECT_FALSE(make_costing(Costing::motorcycle)->ReachLabelsApply());
+  EXPECT_FALSE(make_costing(Costing::motor_scooter)->ReachLabelsApply());
+}
+
+TEST(Reach, labels) {
+  const std::string ascii_map = R"(
+      b--c--d
+      |  |  |
+      |  |  |
+      a--f--e--j
+      |  |  |
+      |  |  |
+      g--h--i
+    )";
+
+  const gurka::ways ways = {
+      {"abcdefaghie", {{"highway", "residential"}}},
+      {"cfh", {{"highway", "tertiary"}}},
+      {"ej", {{"highway", "residential"}, {"oneway", "yes"}}},
+  };
+
+  const auto layout = gurka::detail::map_to_coordinates(ascii_map, 100);
+  auto map = gurka::buildtiles(layout, ways, {}, {}, "test/data/reach_labels");
+  baldr::GraphReader reader(map.config.get_child("mjolnir"));
+  auto costing = sif::CostFactory{}.Create(Costing::auto_);
+  TestableReach reach_checker;
+
+  // everything in the loop is one component, the 2 extra nodes are where the way crosses itself
+  auto af = gurka::findEdgeByNodes(reader, map.nodes, "a", "f");
+  auto reach = reach_checker.labelled(std::get<1>(af), std::get<0>(af), reader, costing);
+  EXPECT_EQ(reach.inbound, 7);
+  EXPECT_EQ(reach.outbound, 7);
+
+  // so asking for less than that is answered without an expansion
+  reach = reach_checker(std::get<1>(af), std::get<0>(af), 5, reader, costing);
+  EXPECT_EQ(reach.inbound, 5);
+  EXPECT_EQ(reach.outbound, 5);
+
+  // you cant get back from the end of the oneway so it only has the loop behind it
+  auto ej = gurka::findEdgeByNodes(reader, map.nodes, "e", "j");
+  reach = reach_checker.labelled(std::get<1>(ej), std::get<0>(ej), reader, costing);
+  EXPECT_EQ(reach.inbound, 7);
+  EXPECT_EQ(reach.outbound, 1);
+
+  // and an expansion is needed to find out it really cant go anywhere
+  reach = reach_checker(std::get<1>(ej), std::get<0>(ej), 5, reader, costing);
+  EXPECT_EQ(reach.inbound, 5);
+  EXPECT_EQ(reach.outbound, 1);
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -0,0 +1,124 @@
+#include "midgard/tracing.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "test.h"
+
+using namespace valhalla::midgard;
+
+namespace {
+
+size_t count(const std::string& text, const std::string& what) {
+  size_t found = 0;
+  for (auto pos = text.find(what); pos != std::string::npos; pos = text.find(what, pos + 1)) {
+    ++found;
+  }
+  return found;
+}
+
+TEST(Tracing, Scopes) {
+  tracing::clear();
+  {
+    VALHALLA_TRACE_SCOPE("test", "outer");
+    { VALHALLA_TRACE_SCOPE("test", "inner"); }
+  }
+  auto json = tracing::render();
+  EXPECT_EQ(json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0);
+  EXPECT_EQ(json.substr(json.size() - 2), "]}");
+
+  // without the trace points compiled in there is nothing to render
+  const size_t expected = tracing::compiled() ? 1 : 0;
+  EXPECT_EQ(count(json, "\"cat\":\"test\",\"name\":\"outer\""), expected) << json;
+  EXPECT_EQ(count(json, "\"cat\":\"test\",\"name\":\"inner\""), expected) << json;
+  // spans are recorded when they end so the inner one comes first
+  if (tracing::compiled()) {
+    EXPECT_LT(json.find("\"name\":\"inner\""), json.find("\"name\":\"outer\""));
+  }
+}
+
+TEST(Tracing, Disabled) {
+  tracing::clear();
+  tracing::enable(false);
+  { VALHALLA_TRACE_SCOPE("test", "disabled"); }
+  tracing::enable(true);
+  EXPECT_EQ(count(tracing::render(), "\"name\":\"disabled\""), 0);
+}
+
+TEST(Tracing, Wraps) {
+  // a full ring keeps the most recent spans
+  tracing::clear();
+  const auto now = std::chrono::steady_clock::now();
+  const char* oldest = tracing::intern("oldest");
+  const char* newest = tracing::intern("newest");
+  EXPECT_EQ(tracing::intern("newest"), newest);
+  tracing::record("test", oldest, now, now);
+  for (int i = 0; i < 100000; ++i) {
+    tracing::record("test", "middle", now, now + std::chrono::microseconds(i));
+  }
+  tracing::record("test", newest, now, now + std::chrono::milliseconds(1));
+
+  auto json = tracing::render();
+  EXPECT_EQ(count(json, "\"name\":\"oldest\""), 0);
+  EXPECT_EQ(count(json, "\"name\":\"newest\""), tracing::compiled() ? 1 : 0);
+  EXPECT_LT(count(json, "\"ph\":\"X\""), 100000);
+  if (tracing::compiled()) {
+    EXPECT_NE(json.find("\"name\":\"newest\",\"ts\":"), std::string::npos);
+    EXPECT_NE(json.find(",\"dur\":1000.000}"), std::string::npos) << json.substr(json.size() - 200);
+  }
+}
+
+TEST(Tracing, Window) {
+  tracing::clear();
+  const auto now = std::chrono::steady_clock::now();
+  tracing::record("test", "old", now - std::chrono::seconds(20), now - std::chrono::seconds(10));
+  tracing::record("test", "new", now - std::chrono::seconds(1), now);
+
+  auto json = tracing::render(std::chrono::seconds(5));
+  EXPECT_EQ(count(json, "\"name\":\"old\""), 0);
+  EXPECT_EQ(count(json, "\"name\":\"new\""), tracing::compiled() ? 1 : 0);
+  EXPECT_EQ(count(tracing::render(), "\"name\":\"old\""), tracing::compiled() ? 1 : 0);
+}
+
+TEST(Tracing, Threads) {
+  // every thread has a track of its own, which is kept after it exits
+  tracing::clear();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([]() {
+      for (int i = 0; i < 100; ++i) {
+        VALHALLA_TRACE_SCOPE("test", "thread");
+      }
+    });
+  }
+  // render while they record
+  tracing::render();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto json = tracing::render();
+  EXPECT_EQ(count(json, "\"name\":\"thread\""), tracing::compiled() ? 400 : 0);
+}
+
+TEST(Tracing, Reuse) {
+  // a thread which exits hands its track to the next one rather than every thread getting its own
+  tracing::clear();
+  for (int t = 0; t < 8; ++t) {
+    std::thread([]() { VALHALLA_TRACE_SCOPE("test", "reused"); }).join();
+  }
+  auto json = tracing::render();
+  EXPECT_EQ(count(json, "\"name\":\"reused\""), tracing::compiled() ? 8 : 0);
+  if (tracing::compiled()) {
+    const auto begin = json.find("\"tid\":");
+    const auto tid = json.substr(begin, json.find(',', begin) - begin);
+    EXPECT_EQ(count(json, tid + ","), 8) << json;
+  }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,10 +1,12 @@
 #ifndef VALHALLA_BALDR_DATETIME_H_
 #define VALHALLA_BALDR_DATETIME_H_
 
+#include <atomic>
 #include <cstdint>
 #include <ctime>
 #include <iomanip>
 #include <locale>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <unordered_map>
@@ -37,14 +39,42 @@ namespace valhalla {
 namespace baldr {
 namespace DateTime {
 
+// a cache for timezone sys_info lookup (since its expensive)
+using tz_sys_info_cache_t = std::unordered_map<const date::time_zone*, std::vector<date::sys_info>>;
+
+// the utc offsets of a timezone over the years as a table of when they change
+struct tz_offsets_t;
+
 // tz db
 struct tz_db_t {
   tz_db_t();
+  ~tz_db_t();
   size_t to_index(const std::string& zone) const;
   const date::time_zone* from_index(size_t index) const;
 
+  /**
+   * Get the difference between two timezones like timezone_diff below but by timezone index. The
+   * offsets are looked up in a table per timezone, made the first time the timezone is used and
+   * never changed after, so the lookup needs no locks. Times past the end of the tables go to the
+   * timezone library instead.
+   * @param   seconds        seconds since epoch
+   * @param   origin_index   timezone index of the origin
+   * @param   dest_index     timezone index of the dest
+   * @param   cache          a cache for the timezone library when it is used
+   * @return Returns the seconds difference between the 2 timezones.
+   */
+  int timezone_diff(const uint64_t seconds,
+                    size_t origin_index,
+                    size_t dest_index,
+                    tz_sys_info_cache_t* cache = nullptr) const;
+
 protected:
+  const tz_offsets_t& offsets(size_t index) const;
+
   std::unordered_map<size_t, const date::time_zone*> zones;
+  // the offset table of every timezone index, null until the timezone is first used
+  std::unique_ptr<std::atomic<const tz_offsets_t*>[]> offset_tables;
+  size_t offset_tables_size;
 };
 
 struct dt_info_t {
@@ -116,7 +146,6 @@ uint64_t seconds_since_epoch(const std::string& date_time, const date::time_zone
  * @param   cache         a cache for timezone sys_info lookup (since its expensive)
  * @return Returns the seconds difference between the 2 timezones.
  */
-using tz_sys_info_cache_t = std::unordered_map<const date::time_zone*, std::vector<date::sys_info>>;
 int timezone_diff(const uint64_t seconds,
                   const date::time_zone* origin_tz,
                   const date::time_zone* dest_tz,
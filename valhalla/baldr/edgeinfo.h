@@ -93,6 +93,29 @@ struct linguistic_text_header_t {
  */
 std::pair<std::vector<std::pair<float, float>>, uint32_t> decode_levels(const std::string& encoded);
 
+/**
+ * Lazily decodes the shape of an edge a point at a time, whichever way it is stored in the tile:
+ * as 7 bit varints (see midgard::encode7) or bit packed (see midgard::encode_packed).
+ */
+class EdgeShapeDecoder {
+public:
+  EdgeShapeDecoder(const char* encoded, const size_t size, const bool packed)
+      : packed_(packed), varint_decoder_(encoded, packed ? 0 : size),
+        packed_decoder_(encoded, packed ? size : 0) {
+  }
+  midgard::PointLL pop() noexcept(false) {
+    return packed_ ? packed_decoder_.pop() : varint_decoder_.pop();
+  }
+  bool empty() const {
+    return packed_ ? packed_decoder_.empty() : varint_decoder_.empty();
+  }
+
+protected:
+  bool packed_;
+  midgard::Shape7Decoder<midgard::PointLL> varint_decoder_;
+  midgard::PackedShapeDecoder<midgard::PointLL> packed_decoder_;
+};
+
 /**
  * Edge information not required in shortest path algorithm and is
  * common among the 2 directions.
@@ -253,12 +276,26 @@ public:
    */
   const std::vector<midgard::PointLL>& shape() const;
 
-  midgard::Shape7Decoder<midgard::PointLL> lazy_shape() const {
-    return midgard::Shape7Decoder<midgard::PointLL>(encoded_shape_, ei_.encoded_shape_size_);
+  /**
+   * Get a decoder that hands out the shape of the edge one point at a time, for when not all of
+   * it may be needed.
+   * @return  Returns the shape decoder.
+   */
+  EdgeShapeDecoder lazy_shape() const {
+    return EdgeShapeDecoder(encoded_shape_, ei_.encoded_shape_size_, ei_.packed_shape_);
+  }
+
+  /**
+   * Is the shape stored bit packed rather than as 7 bit varints.
+   * @return  Returns true if the shape is bit packed.
+   */
+  bool packed_shape() const {
+    return ei_.packed_shape_;
   }
 
   /**
-   * Returns the encoded shape string.
+   * Returns the encoded shape string. This is always 7 bit varint encoded (see midgard::encode7),
+   * bit packed shapes are re-encoded.
    * @return  Returns the encoded shape string.
    */
   std::string encoded_shape() const;
@@ -328,7 +365,7 @@ public:
     uint32_t extended_wayid1_ : 8;     // Next next byte of the way id
     uint32_t extended_wayid_size_ : 2; // How many more bytes the way id is stored in
     uint32_t has_elevation_ : 1;       // Does the edgeinfo have elevation?
-    uint32_t spare0_ : 1;              // not used
+    uint32_t packed_shape_ : 1;        // Is the shape bit packed rather than varint encoded
   };
 
 protected:
@@ -15,6 +15,7 @@
 #include <valhalla/baldr/nodeinfo.h>
 #include <valhalla/baldr/nodetransition.h>
 #include <valhalla/baldr/predictedspeeds.h>
+#include <valhalla/baldr/reachlabel.h>
 #include <valhalla/baldr/sign.h>
 #include <valhalla/baldr/signinfo.h>
 #include <valhalla/baldr/traffictile.h>
@@ -183,6 +184,16 @@ public:
         " nodecount= " + std::to_string(header_->nodecount()));
   }
 
+  /**
+   * Get the reach label of a node, the sizes of the strongly connected components it belongs to
+   * within this tile. Tiles which were built without them return an empty label.
+   * @param  idx  Index of the node within the current tile.
+   * @return  Returns the reach label of the node.
+   */
+  ReachLabel reach_label(const size_t idx) const {
+    return reach_labels_ && idx < header_->nodecount() ? reach_labels_[idx] : ReachLabel{};
+  }
+
   /**
    * Convenience method to get the lat,lon of a node.
    * @param  nodeid  GraphId of the node.
@@ -883,6 +894,9 @@ protected:
   // Predicted speeds
   PredictedSpeeds predictedspeeds_;
 
+  // Reach labels, one per node (can be nullptr if the tile has none)
+  ReachLabel* reach_labels_{};
+
   // Map of stop one stops in this tile.
   std::unordered_map<std::string, GraphId> stop_one_stops;
 
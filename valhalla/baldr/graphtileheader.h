@@ -18,12 +18,18 @@ namespace baldr {
 // something to the tile simply subtract one from this number and add it
 // just before the empty_slots_ array below. NOTE that it can ONLY be an
 // offset in bytes and NOT a bitfield or union or anything of that sort
-constexpr size_t kEmptySlots = 11;
+constexpr size_t kEmptySlots = 10;
 
 // Maximum size of the version string (stored as a fixed size
 // character array so the GraphTileHeader size remains fixed).
 constexpr size_t kMaxVersionSize = 16;
 
+// Version of the tile format, raised whenever tiles can hold something that older software would
+// misread rather than ignore. Readers refuse tiles whose format is newer than theirs. Tiles with
+// bit packed edge shapes need at least kPackedShapesFormatVersion
+constexpr uint32_t kPackedShapesFormatVersion = 1;
+constexpr uint32_t kTileFormatVersion = kPackedShapesFormatVersion;
+
 // Maximum value used for quality metrics
 constexpr uint32_t kMaxQualityMeasure = 15;
 
@@ -160,6 +166,36 @@ public:
     has_ext_directededge_ = ext;
   }
 
+  /**
+   * Gets the flag indicating whether edge shapes in this tile are written bit packed wherever that
+   * is smaller than the 7 bit varint encoding. Each edge info says which encoding its shape uses so
+   * this only matters when the tile is (re)built. Setting it raises the format version of the tile
+   * so that software which can't read packed shapes refuses the tile.
+   * @return  Returns true if edge shapes are bit packed.
+   */
+  bool has_packed_shapes() const {
+    return has_packed_shapes_;
+  }
+
+  /**
+   * Sets flag indicating whether edge shapes in this tile are written bit packed.
+   * @param  packed  True if edge shapes are to be bit packed.
+   */
+  void set_has_packed_shapes(const bool packed) {
+    has_packed_shapes_ = packed;
+    if (packed && format_version_ < kPackedShapesFormatVersion) {
+      format_version_ = kPackedShapesFormatVersion;
+    }
+  }
+
+  /**
+   * Gets the version of the tile format, 0 for tiles built before the format was versioned.
+   * @return  Returns the format version of this tile.
+   */
+  uint32_t format_version() const {
+    return format_version_;
+  }
+
   /**
    * Get the base (SW corner) of the tile.
    * @return Returns the base lat,lon of the tile (degrees).
@@ -574,6 +610,22 @@ public:
     predictedspeeds_offset_ = offset;
   }
 
+  /**
+   * Gets the offset to the reach labels.
+   * @return  Returns the offset (bytes) to the reach labels, 0 if the tile has none.
+   */
+  uint32_t reach_labels_offset() const {
+    return reach_labels_offset_;
+  }
+
+  /**
+   * Sets the offset to the reach labels within the tile.
+   * @param offset Offset to the reach labels within the tile.
+   */
+  void set_reach_labels_offset(const uint32_t offset) {
+    reach_labels_offset_ = offset;
+  }
+
   /**
    * Get the offset to the end of the tile
    * @return the number of bytes in the tile, unless the last slot is used
@@ -616,7 +668,7 @@ protected:
   uint64_t nodecount_ : 21;             // Number of nodes
   uint64_t directededgecount_ : 21;     // Number of directed edges
   uint64_t predictedspeeds_count_ : 21; // Number of predictive speed records
-  uint64_t spare1_ : 1;
+  uint64_t has_packed_shapes_ : 1;      // Are edge shapes bit packed where that is smaller
 
   // Currently there can only be twice as many transitions as there are nodes,
   // but in practice the number should be much less.
@@ -625,7 +677,7 @@ protected:
   uint32_t turnlane_count_ : 21;  // Number of turnlane records
   uint32_t spare4_ : 11;          // TODO: DELETE ME IN V4
   uint64_t transfercount_ : 16;   // Number of transit transfer records
-  uint64_t spare2_ : 7;
+  uint64_t format_version_ : 7;   // Version of the tile format, see kTileFormatVersion
 
   // Number of transit records
   uint64_t departurecount_ : 24;
@@ -642,7 +694,7 @@ protected:
   uint64_t spare7_ : 24;                   // TODO: DELETE ME IN V4
 
   // Note all of the comments about deleting spare in v4
-  // There are typos in the bitfield containing spare2_ above
+  // There are typos in the bitfield containing spare2_ (now format_version_) above
   // They cause the fields to be spread across multiple words
   // The code should have been something like:
   /*
@@ -689,6 +741,9 @@ protected:
   // GraphTile data size in bytes
   uint32_t tile_size_ = 0;
 
+  // Offset to the beginning of the per node reach labels (0 if the tile has none)
+  uint32_t reach_labels_offset_ = 0;
+
   // Marks the end of this version of the tile with the rest of the slots
   // being available for growth. If you want to use one of the empty slots,
   // simply add a uint32_t some_offset_; just above empty_slots_ and decrease
@@ -6,6 +6,7 @@
 #include <locale>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 #include <boost/lexical_cast.hpp>
@@ -319,6 +320,16 @@ public:
     return buffer.GetString();
   }
 
+  inline size_t size() const {
+    return buffer.GetSize();
+  }
+
+  // hands what has been written so far to the sink and starts over with the same memory
+  template <typename sink_t> inline void flush(const sink_t& sink) {
+    sink(std::string_view(buffer.GetString(), buffer.GetSize()));
+    buffer.Clear();
+  }
+
   inline void set_precision(int precision) {
     writer.SetMaxDecimalPlaces(precision);
   }
@@ -0,0 +1,83 @@
+#ifndef VALHALLA_BALDR_REACHLABEL_H_
+#define VALHALLA_BALDR_REACHLABEL_H_
+
+#include <cstdint>
+
+#include <valhalla/baldr/graphconstants.h>
+
+namespace valhalla {
+namespace baldr {
+
+// Largest component size a reach label can hold, bigger components are clamped to it
+constexpr uint32_t kMaxReachLabel = 255;
+
+/**
+ * The size of the strongly connected component a node belongs to within its tile, one per access
+ * mode. Every node in the component can reach and be reached from all of the others so the size is
+ * a lower bound on both the inbound and outbound reach of the edges touching the node.
+ *
+ * The components are computed when the tiles are validated using only those edges which every
+ * costing of the mode would allow with its default options: no shortcuts, no access, turn or
+ * destination only restrictions, nothing impassable or under construction and no rail ferries or
+ * transit. Live traffic closures and costing options which exclude more of the graph are not known
+ * at that time so it is up to the user of the label to only trust it when those don't apply, see
+ * sif::DynamicCost::ReachLabelsApply.
+ */
+class ReachLabel {
+public:
+  ReachLabel() = default;
+
+  /**
+   * Get the component size for an access mode.
+   * @param  access_mode  one of kAutoAccess, kTruckAccess, kBicycleAccess or kPedestrianAccess
+   * @return the size of the component or 0 if the mode has no label
+   */
+  uint32_t get(uint32_t access_mode) const {
+    switch (access_mode) {
+      case kAutoAccess:
+        return auto_;
+      case kTruckAccess:
+        return truck_;
+      case kBicycleAccess:
+        return bicycle_;
+      case kPedestrianAccess:
+        return pedestrian_;
+      default:
+        return 0;
+    }
+  }
+
+  /**
+   * Set the component size for an access mode, sizes larger than kMaxReachLabel are clamped.
+   * @param  access_mode  one of kAutoAccess, kTruckAccess, kBicycleAccess or kPedestrianAccess
+   * @param  size         the number of nodes in the component
+   */
+  void set(uint32_t access_mode, uint32_t size) {
+    uint8_t clamped = size > kMaxReachLabel ? kMaxReachLabel : size;
+    switch (access_mode) {
+      case kAutoAccess:
+        auto_ = clamped;
+        break;
+      case kTruckAccess:
+        truck_ = clamped;
+        break;
+      case kBicycleAccess:
+        bicycle_ = clamped;
+        break;
+      case kPedestrianAccess:
+        pedestrian_ = clamped;
+        break;
+    }
+  }
+
+protected:
+  uint8_t auto_{};
+  uint8_t truck_{};
+  uint8_t bicycle_{};
+  uint8_t pedestrian_{};
+};
+
+} // namespace baldr
+} // namespace valhalla
+
+#endif // VALHALLA_BALDR_REACHLABEL_H_
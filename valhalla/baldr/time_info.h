@@ -175,8 +175,7 @@ struct TimeInfo {
     // if the timezone changed we need to account for that offset as well
     if (next_tz_index != timezone_index) {
       namespace dt = baldr::DateTime;
-      int tz_diff = dt::timezone_diff(lt, dt::get_tz_db().from_index(timezone_index),
-                                      dt::get_tz_db().from_index(next_tz_index), tz_cache);
+      int tz_diff = dt::get_tz_db().timezone_diff(lt, timezone_index, next_tz_index, tz_cache);
       lt += tz_diff;
       sw += tz_diff;
     }
@@ -222,8 +221,7 @@ struct TimeInfo {
     // if the timezone changed we need to account for that offset as well
     if (next_tz_index != timezone_index) {
       namespace dt = baldr::DateTime;
-      int tz_diff = dt::timezone_diff(lt, dt::get_tz_db().from_index(timezone_index),
-                                      dt::get_tz_db().from_index(next_tz_index), tz_cache);
+      int tz_diff = dt::get_tz_db().timezone_diff(lt, timezone_index, next_tz_index, tz_cache);
       lt += tz_diff;
       sw += tz_diff;
     }
@@ -56,6 +56,15 @@ public:
                             uint8_t direction = kInbound | kOutbound);
 
 protected:
+  // the tiles label each node with the size of its strongly connected component within the tile.
+  // as long as the request doesnt rule out more of the graph than those were computed with, an
+  // edge whose begin and end nodes sit in big enough components needs no expansion at all. this
+  // returns the reach those labels imply, which is 0 when they cant be used
+  directed_reach labelled(const baldr::DirectedEdge* edge,
+                          const baldr::GraphId edge_id,
+                          baldr::GraphReader& reader,
+                          const std::shared_ptr<sif::DynamicCost>& costing);
+
   // the main method above will do a conservative reach estimate stopping the expansion at any
   // edges which the costing could decide to skip (because of restrictions and possibly more?)
   // when that happens and the maximum reach is not found, this is then validated with a more
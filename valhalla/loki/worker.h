@@ -44,6 +44,12 @@ public:
   std::string transit_available(Api& request);
   void status(Api& request) const;
 
+  /**
+   * Throws if the action of the request is not one of the actions enabled in the config
+   * @param request  the request whose action to check
+   */
+  void check_action(const Api& request) const;
+
   void set_interrupt(const std::function<void()>* interrupt) override;
 
 protected:
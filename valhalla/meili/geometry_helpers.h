@@ -15,11 +15,11 @@ namespace valhalla {
 namespace meili {
 namespace helpers {
 
-// snapped point, squared distance, segment index, offset
+// snapped point, squared distance, segment index, offset. The shape is one of the point at a time
+// decoders, either a midgard::Shape7Decoder or the baldr::EdgeShapeDecoder of an edge
+template <class shape_decoder_t>
 std::tuple<midgard::PointLL, double, typename std::vector<midgard::PointLL>::size_type, double>
-Project(const midgard::projector_t& p,
-        midgard::Shape7Decoder<midgard::PointLL>& shape,
-        double snap_distance = 0.0);
+Project(const midgard::projector_t& p, shape_decoder_t& shape, double snap_distance = 0.0);
 
 } // namespace helpers
 } // namespace meili
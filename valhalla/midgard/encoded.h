@@ -1,6 +1,9 @@
 #pragma once
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
@@ -60,6 +63,115 @@ private:
   }
 };
 
+/**
+ * Decodes shapes that were bit packed with encode_packed. Like the other decoders it hands out one
+ * point at a time so that callers can stop without decoding the rest of the shape. Every offset
+ * takes the same number of bits, so each one is read with a single unaligned load and a mask
+ * rather than a loop over its bytes.
+ */
+template <typename Point> class PackedShapeDecoder {
+public:
+  PackedShapeDecoder(const char* begin,
+                     const size_t size,
+                     const double precision = DECODE_PRECISION) noexcept(false)
+      : begin(begin), end(begin + size),
+        last_word(size >= sizeof(uint64_t) ? end - sizeof(uint64_t) : nullptr), prec(precision) {
+    if (size == 0) {
+      return;
+    }
+    // the first point is stored just like the varint encoding stores it
+    lat = unzigzag(varint());
+    lon = unzigzag(varint());
+    have_first = true;
+    // then the number of offsets and their widths, if there are any
+    if (this->begin != end) {
+      const uint32_t counts = varint();
+      remaining = counts >> 10;
+      lat_width = (counts >> 5) & 0x1f;
+      lon_width = counts & 0x1f;
+      if ((uint64_t(remaining) * (lat_width + lon_width) + 7) / 8 !=
+          static_cast<uint64_t>(end - this->begin)) {
+        throw std::runtime_error("Bad packed shape");
+      }
+    }
+  }
+  Point pop() noexcept(false) {
+    if (have_first) {
+      have_first = false;
+    } else {
+      if (remaining == 0) {
+        throw std::runtime_error("Bad packed shape");
+      }
+      lat += unzigzag(bits(lat_width));
+      lon += unzigzag(bits(lon_width));
+      --remaining;
+    }
+    return Point(double(static_cast<int32_t>(lon)) * prec,
+                 double(static_cast<int32_t>(lat)) * prec);
+  }
+  bool empty() const {
+    return !have_first && remaining == 0;
+  }
+
+private:
+  const char* begin;
+  const char* end;
+  // where the last 8 bytes of the shape start, if it has that many
+  const char* last_word;
+  double prec;
+  // unsigned so that offsets which overflow wrap around rather than being undefined
+  uint32_t lat = 0;
+  uint32_t lon = 0;
+  bool have_first = false;
+  uint32_t remaining = 0;
+  uint32_t lat_width = 0;
+  uint32_t lon_width = 0;
+  // how many bits of the packed offsets have been read so far
+  uint64_t bit = 0;
+
+  static uint32_t unzigzag(const uint32_t value) {
+    return (value >> 1) ^ (0u - (value & 1));
+  }
+
+  uint32_t varint() noexcept(false) {
+    uint32_t byte, shift = 0, result = 0;
+    do {
+      if (begin == end) {
+        throw std::runtime_error("Bad packed shape");
+      }
+      byte = static_cast<uint8_t>(*begin++);
+      if (shift < 32) {
+        result |= (byte & 0x7f) << shift;
+      }
+      shift += 7;
+    } while (byte & 0x80);
+    return result;
+  }
+
+  uint32_t bits(const uint32_t width) {
+    // at most 7 + 31 bits are needed so 8 bytes are always enough
+    const char* at = begin + (bit >> 3);
+    uint64_t word;
+    if (last_word) {
+      // near the end we load the last 8 bytes of the shape instead and shift off the ones before
+      std::memcpy(&word, std::min(at, last_word), sizeof(word));
+      if (at > last_word) {
+        word = (word >> (8 * (at - last_word - 1))) >> 8;
+      }
+    } else {
+      // the whole shape is shorter than 8 bytes
+      word = 0;
+      for (int shift = 0; at != end; shift += 8) {
+        word |= uint64_t(static_cast<uint8_t>(*at++)) << shift;
+      }
+    }
+    const uint64_t mask = (uint64_t(1) << width) - 1;
+    const uint32_t value = static_cast<uint32_t>((word >> (bit & 7)) & mask);
+    bit += width;
+    return value;
+  }
+};
+
 template <typename Point> class Shape5Decoder {
 public:
   Shape5Decoder(const char* begin, const size_t size, const double precision = DECODE_PRECISION)
@@ -99,17 +211,80 @@ private:
   }
 };
 
+/**
+ * Polyline decode the next value from a run of characters, advancing past it.
+ *
+ * @param begin  the first character of the value, moved to the first one after it
+ * @param end    one past the last encoded character
+ * @return the decoded value
+ */
+inline int32_t decode_value(const char*& begin, const char* end) noexcept(false) {
+  uint32_t result = 0;
+  // grab each 5 bits and mask it in where it belongs, chunks past 32 bits fall off
+  int shift = 0;
+  int32_t byte;
+  do {
+    // the value was cut off
+    if (begin == end) {
+      throw std::runtime_error("Bad encoded polyline");
+    }
+    byte = int32_t(*begin++) - 63;
+    if (shift < 32) {
+      result |= static_cast<uint32_t>(byte & 0x1f) << shift;
+      shift += 5;
+    }
+    // if the most significant bit is set there is more to this number
+  } while (byte >= 0x20);
+  // the zigzag encoding keeps the sign in the least significant bit
+  return static_cast<int32_t>(result >> 1) ^ -static_cast<int32_t>(result & 1);
+}
+
+/**
+ * Polyline decode a string into points, calling the given function with each of them. This
+ * decodes the whole string in one go rather than point by point like the Shape5Decoder does,
+ * without having to keep the decoder state between points.
+ *
+ * @param encoded    the encoded points
+ * @param length     the number of encoded characters
+ * @param precision  decoding precision (1/encoding precision)
+ * @param point      called with each decoded point
+ */
+template <class Point, class point_callback_t>
+void decode_points(const char* encoded,
+                   size_t length,
+                   const double precision,
+                   point_callback_t&& point) noexcept(false) {
+  // unsigned so that offsets which overflow wrap around the way they do for the Shape5Decoder
+  uint32_t lat = 0, lon = 0;
+  const char* end = encoded + length;
+  while (encoded != end) {
+    lat += static_cast<uint32_t>(decode_value(encoded, end));
+    // a lat without its lon
+    if (encoded == end) {
+      throw std::runtime_error("Bad encoded polyline");
+    }
+    lon += static_cast<uint32_t>(decode_value(encoded, end));
+    point(Point(double(static_cast<int32_t>(lon)) * precision,
+                double(static_cast<int32_t>(lat)) * precision));
+  }
+}
+
 // specialized implementation for std::vector with reserve
 template <class container_t, class ShapeDecoder = Shape5Decoder<typename container_t::value_type>>
 typename std::enable_if<
     std::is_same<std::vector<typename container_t::value_type>, container_t>::value,
     container_t>::type
 decode(const char* encoded, size_t length, const double precision = DECODE_PRECISION) {
-  ShapeDecoder shape(encoded, length, precision);
   container_t c;
   c.reserve(length / 4);
-  while (!shape.empty()) {
-    c.emplace_back(shape.pop());
+  if constexpr (std::is_same<ShapeDecoder, Shape5Decoder<typename container_t::value_type>>::value) {
+    decode_points<typename container_t::value_type>(encoded, length, precision,
+                                                     [&c](auto&& p) { c.emplace_back(p); });
+  } else {
+    ShapeDecoder shape(encoded, length, precision);
+    while (!shape.empty()) {
+      c.emplace_back(shape.pop());
+    }
   }
   return c;
 }
@@ -120,10 +295,15 @@ typename std::enable_if<
     !std::is_same<std::vector<typename container_t::value_type>, container_t>::value,
     container_t>::type
 decode(const char* encoded, size_t length, const double precision = DECODE_PRECISION) {
-  ShapeDecoder shape(encoded, length, precision);
   container_t c;
-  while (!shape.empty()) {
-    c.emplace_back(shape.pop());
+  if constexpr (std::is_same<ShapeDecoder, Shape5Decoder<typename container_t::value_type>>::value) {
+    decode_points<typename container_t::value_type>(encoded, length, precision,
+                                                     [&c](auto&& p) { c.emplace_back(p); });
+  } else {
+    ShapeDecoder shape(encoded, length, precision);
+    while (!shape.empty()) {
+      c.emplace_back(shape.pop());
+    }
   }
   return c;
 }
@@ -168,25 +348,24 @@ container_t decode7(const std::string& encoded, const double precision = DECODE_
  */
 template <class container_t>
 std::string encode(const container_t& points, const int precision = ENCODE_PRECISION) {
-  // a place to keep the output
+  // a place to keep the output, sized for the worst case of 7 chunks of 5 bits for each of the
+  // coords so that we can write straight into it without checking the capacity every character
   std::string output;
-  // unless the shape is very course you should probably only need about 3 bytes
-  // per coord, which is 6 bytes with 2 coords, so we overshoot to 8 just in case
-  output.reserve(points.size() * 8);
+  output.resize(points.size() * 14);
+  char* out = &output[0];
 
   // handy lambda to turn an integer into an encoded string
-  auto serialize = [&output](int number) {
+  auto serialize = [&out](int number) {
     // move the bits left 1 position and flip all the bits if it was a negative number
-    number = number < 0 ? ~(*reinterpret_cast<unsigned int*>(&number) << 1) : (number << 1);
+    uint32_t bits = number < 0 ? ~(static_cast<uint32_t>(number) << 1)
+                               : static_cast<uint32_t>(number) << 1;
     // write 5 bit chunks of the number
-    while (number >= 0x20) {
-      int nextValue = (0x20 | (number & 0x1f)) + 63;
-      output.push_back(static_cast<char>(nextValue));
-      number >>= 5;
+    while (bits >= 0x20) {
+      *out++ = static_cast<char>((0x20 | (bits & 0x1f)) + 63);
+      bits >>= 5;
     }
     // write the last chunk
-    number += 63;
-    output.push_back(static_cast<char>(number));
+    *out++ = static_cast<char>(bits + 63);
   };
 
   // this is an offset encoding so we remember the last point we saw
@@ -203,6 +382,7 @@ std::string encode(const container_t& points, const int precision = ENCODE_PRECI
     last_lon = lon;
     last_lat = lat;
   }
+  output.resize(out - output.data());
   return output;
 }
 
@@ -253,5 +433,90 @@ std::string encode7(const container_t& points, const int precision = ENCODE_PREC
   return output;
 }
 
+/**
+ * Bit pack a container of points. Where the varint encoding of encode7 spends a whole number of
+ * bytes on each offset, this works out how many bits the largest lat and lon offsets need and
+ * stores every offset in exactly that many bits. The layout is
+ *   - the first point as encode7 stores it, zigzag varints of lat and then lon
+ *   - if there are more points, a varint holding how many with the bit widths of the lat and lon
+ *     offsets in its low 10 bits, 5 bits each
+ *   - the zigzag lat and lon offsets from each point to the next, least significant bit first,
+ *     padded with zeros to a whole byte
+ * Because every offset costs the same, shapes with a few points or with one long segment among
+ * many short ones can come out larger than encode7 would make them.
+ *
+ * @param points     the list of points to encode
+ * @param precision  number of decimal places of precision
+ * @return the packed points or an empty string if an offset needs more than 31 bits
+ */
+template <class container_t>
+std::string encode_packed(const container_t& points, const int precision = ENCODE_PRECISION) {
+  std::string output;
+  if (points.empty()) {
+    return output;
+  }
+
+  // the same integers that encode7 would work with
+  std::vector<uint32_t> offsets;
+  offsets.reserve(points.size() * 2);
+  int last_lon = 0, last_lat = 0;
+  uint32_t lat_bits = 0, lon_bits = 0;
+  for (const auto& p : points) {
+    int lon = static_cast<int>(round(static_cast<double>(p.first) * precision));
+    int lat = static_cast<int>(round(static_cast<double>(p.second) * precision));
+    // zigzag so the sign ends up in the least significant bit
+    for (int offset : {lat - last_lat, lon - last_lon}) {
+      offsets.push_back(offset < 0 ? ~(static_cast<uint32_t>(offset) << 1)
+                                   : static_cast<uint32_t>(offset) << 1);
+    }
+    if (offsets.size() > 2) {
+      lat_bits |= offsets[offsets.size() - 2];
+      lon_bits |= offsets.back();
+    }
+    last_lon = lon;
+    last_lat = lat;
+  }
+  uint32_t lat_width = 0, lon_width = 0;
+  for (; lat_width < 32 && (lat_bits >> lat_width); ++lat_width) {
+  }
+  for (; lon_width < 32 && (lon_bits >> lon_width); ++lon_width) {
+  }
+  if (lat_width > 31 || lon_width > 31) {
+    return output;
+  }
+
+  auto serialize = [&output](uint64_t number) {
+    while (number > 0x7f) {
+      output.push_back(static_cast<char>(0x80 | (number & 0x7f)));
+      number >>= 7;
+    }
+    output.push_back(static_cast<char>(number));
+  };
+  serialize(offsets[0]);
+  serialize(offsets[1]);
+  if (points.size() == 1) {
+    return output;
+  }
+  serialize((uint64_t(points.size() - 1) << 10) | (lat_width << 5) | lon_width);
+
+  // fill the bits in a word at a time and flush whole bytes as they fill up
+  uint64_t word = 0;
+  uint32_t used = 0;
+  for (size_t i = 2; i < offsets.size(); i += 2) {
+    for (auto value_width : {std::make_pair(offsets[i], lat_width),
+                             std::make_pair(offsets[i + 1], lon_width)}) {
+      word |= uint64_t(value_width.first) << used;
+      used += value_width.second;
+      for (; used >= 8; used -= 8, word >>= 8) {
+        output.push_back(static_cast<char>(word & 0xff));
+      }
+    }
+  }
+  if (used) {
+    output.push_back(static_cast<char>(word & 0xff));
+  }
+  return output;
+}
+
 } // namespace midgard
 } // namespace valhalla
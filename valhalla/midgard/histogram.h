@@ -0,0 +1,194 @@
+#ifndef VALHALLA_MIDGARD_HISTOGRAM_H_
+#define VALHALLA_MIDGARD_HISTOGRAM_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace valhalla {
+namespace midgard {
+
+/**
+ * A high dynamic range histogram of unsigned integer values, such as latencies in microseconds.
+ * Values are counted in log linear buckets: every power of two range is split into the same number
+ * of equally wide buckets so the relative error of what is reported is bounded no matter the
+ * magnitude of the value while recording stays a couple of bit operations and an increment.
+ *
+ * With the default of 7 bits of precision values below 128 are counted exactly and everything else
+ * is reported within 1/64th of what was recorded. Histograms of the same precision can be merged,
+ * which is how histograms recorded on different threads are combined.
+ */
+class Histogram {
+public:
+  /**
+   * Constructor.
+   * @param precision_bits  the number of bits of each value which are kept, between 1 and 16
+   */
+  explicit Histogram(const uint32_t precision_bits = 7)
+      : precision_bits_(checked_precision(precision_bits)),
+        half_bucket_count_(uint64_t(1) << (precision_bits - 1)),
+        counts_((64 - precision_bits + 2) * half_bucket_count_, 0) {
+    reset();
+  }
+
+  /**
+   * Counts a value
+   * @param value  the value
+   * @param count  the number of times it was seen
+   */
+  void record(const uint64_t value, const uint64_t count = 1) {
+    counts_[index(value)] += count;
+    total_ += count;
+    sum_ += static_cast<double>(value) * count;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+  }
+
+  /**
+   * Adds the counts of another histogram to this one
+   * @param other  a histogram with the same precision
+   */
+  void merge(const Histogram& other) {
+    if (other.precision_bits_ != precision_bits_) {
+      throw std::invalid_argument("Histograms of different precisions can't be merged");
+    }
+    for (size_t i = 0; i < counts_.size(); ++i) {
+      counts_[i] += other.counts_[i];
+    }
+    total_ += other.total_;
+    sum_ += other.sum_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+  }
+
+  /**
+   * Forgets everything that was recorded
+   */
+  void reset() {
+    std::fill(counts_.begin(), counts_.end(), 0);
+    total_ = 0;
+    sum_ = 0;
+    min_ = std::numeric_limits<uint64_t>::max();
+    max_ = 0;
+  }
+
+  /**
+   * @return the number of values recorded
+   */
+  uint64_t count() const {
+    return total_;
+  }
+
+  /**
+   * @return the sum of the values recorded
+   */
+  double sum() const {
+    return sum_;
+  }
+
+  /**
+   * @return the mean of the values recorded or 0 if there are none
+   */
+  double mean() const {
+    return total_ ? sum_ / total_ : 0.;
+  }
+
+  /**
+   * @return the smallest value recorded or 0 if there are none
+   */
+  uint64_t min() const {
+    return total_ ? min_ : 0;
+  }
+
+  /**
+   * @return the largest value recorded
+   */
+  uint64_t max() const {
+    return max_;
+  }
+
+  /**
+   * Finds the value which the given percentage of the recorded values are at or below. The value
+   * is the upper end of its bucket, clamped to what was actually recorded, so it never understates
+   * @param percentile  between 0 and 100
+   * @return the value or 0 if nothing was recorded
+   */
+  uint64_t percentile(const double percentile) const {
+    if (total_ == 0) {
+      return 0;
+    }
+    const double clamped = std::min(std::max(percentile, 0.), 100.);
+    const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(clamped / 100. * total_ + .5));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts_.size(); ++i) {
+      seen += counts_[i];
+      if (seen >= rank) {
+        return std::min(std::max(highest_value(i), min_), max_);
+      }
+    }
+    return max_;
+  }
+
+  /**
+   * Visits the buckets which have counts in ascending order of value
+   * @param visit  called with the highest value of each bucket and the number of values in it
+   */
+  template <typename visitor_t> void for_each_bucket(visitor_t&& visit) const {
+    for (size_t i = 0; i < counts_.size(); ++i) {
+      if (counts_[i]) {
+        visit(highest_value(i), counts_[i]);
+      }
+    }
+  }
+
+protected:
+  static uint32_t checked_precision(const uint32_t precision_bits) {
+    if (precision_bits < 1 || precision_bits > 16) {
+      throw std::invalid_argument("Histogram precision must be between 1 and 16 bits");
+    }
+    return precision_bits;
+  }
+
+  // the bucket a value is counted in
+  size_t index(const uint64_t value) const {
+    // small values have a bucket each
+    if (value < (half_bucket_count_ << 1)) {
+      return static_cast<size_t>(value);
+    }
+    // larger values keep their top bits, there are half as many buckets per power of two after
+    // the first ones since the top bit is always set
+    uint32_t magnitude = 63;
+    while (!(value >> magnitude)) {
+      --magnitude;
+    }
+    const uint32_t shift = magnitude - precision_bits_ + 1;
+    return static_cast<size_t>(shift * half_bucket_count_ + (value >> shift));
+  }
+
+  // the largest value which is counted in a bucket
+  uint64_t highest_value(const size_t index) const {
+    if (index < (half_bucket_count_ << 1)) {
+      return index;
+    }
+    const uint64_t shift = index / half_bucket_count_ - 1;
+    const uint64_t top = index - shift * half_bucket_count_;
+    const uint64_t lowest = top << shift;
+    const uint64_t width = uint64_t(1) << shift;
+    return lowest + (width - 1);
+  }
+
+  uint32_t precision_bits_;
+  uint64_t half_bucket_count_;
+  std::vector<uint64_t> counts_;
+  uint64_t total_;
+  double sum_;
+  uint64_t min_;
+  uint64_t max_;
+};
+
+} // namespace midgard
+} // namespace valhalla
+
+#endif // VALHALLA_MIDGARD_HISTOGRAM_H_
@@ -0,0 +1,105 @@
+#ifndef VALHALLA_MIDGARD_METRICS_H_
+#define VALHALLA_MIDGARD_METRICS_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace valhalla {
+namespace midgard {
+namespace metrics {
+
+/**
+ * Latencies of the stages requests go through and of the sub phases within them, kept in high
+ * dynamic range histograms per action and stage for the service to expose to a scraper.
+ *
+ * Each thread records into histograms of its own without any locking and merges them into the
+ * process wide ones at most once per second, when it records something. What is rendered can be
+ * up to a second behind for busy threads and a thread's last recordings only show once it records
+ * again or exits. Nothing is recorded until recording is enabled, which the services do if their
+ * config asks for it.
+ */
+
+namespace detail {
+extern std::atomic<bool> enabled;
+} // namespace detail
+
+/**
+ * Turns recording on or off for the whole process
+ * @param enabled  whether to record
+ */
+void enable(bool enabled);
+
+/**
+ * @return whether latencies are being recorded
+ */
+inline bool enabled() {
+  return detail::enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * Records a latency, does nothing unless recording is enabled
+ * @param action        the action of the request or none for work that isn't tied to one
+ * @param stage         the stage or sub phase
+ * @param microseconds  how long it took
+ */
+void record(const std::string& action, const std::string& stage, uint64_t microseconds);
+
+/**
+ * Merges what this thread recorded into the process wide histograms right away
+ */
+void flush();
+
+/**
+ * Forgets everything recorded so far, what other threads have not merged yet is kept
+ */
+void reset();
+
+/**
+ * Renders the process wide histograms in the prometheus text exposition format, as a summary of
+ * latencies in seconds per action and stage
+ * @return the text
+ */
+std::string render();
+
+/**
+ * Records the time between its construction and its destruction, so it can be put at the top of a
+ * scope to time the rest of it. Whether to record is decided on construction, the action and stage
+ * have to outlive it.
+ */
+class scoped_timer_t {
+public:
+  scoped_timer_t(const std::string& action, const std::string& stage)
+      : action_(action), stage_(stage), recording_(enabled()) {
+    if (recording_) {
+      start_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  ~scoped_timer_t() {
+    if (recording_) {
+      auto elapsed = std::chrono::steady_clock::now() - start_;
+      record(action_, stage_,
+             std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    }
+  }
+
+  scoped_timer_t(const scoped_timer_t&) = delete;
+  scoped_timer_t& operator=(const scoped_timer_t&) = delete;
+
+protected:
+  const std::string& action_;
+  const std::string& stage_;
+  bool recording_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+// the action of work which isn't tied to one request, like loading a tile into the cache
+extern const std::string kNoAction;
+
+} // namespace metrics
+} // namespace midgard
+} // namespace valhalla
+
+#endif // VALHALLA_MIDGARD_METRICS_H_
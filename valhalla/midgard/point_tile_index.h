@@ -2,6 +2,8 @@
 
 #include <memory>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "midgard/linesegment2.h"
 #include "midgard/pointll.h"
@@ -28,15 +30,31 @@ class PointTileIndex {
   // This guy can tell us which tile a points belongs to.
   std::unique_ptr<Tiles<PointLL>> tiles;
 
-  // key: TileId (uint32_t)
-  // value: unordered_set of point indices that live in this tile
-  std::unordered_map<uint32_t, std::unordered_set<size_t>> tiled_space;
+  // The tile id and index of every point, sorted by tile. The tiles of a row are numbered
+  // consecutively so the points of a run of tiles in a row are a contiguous range in here
+  std::vector<std::pair<int32_t, size_t>> tiled_points;
+
+  // Whether each point has been removed from the tiled space
+  std::vector<bool> removed;
+
+  // Adds the points of the tiles in the row between the two tile ids to near_pts
+  void get_points_in_tiles(int32_t first_tile,
+                           int32_t last_tile,
+                           std::vector<size_t>& near_pts) const;
 
 public:
+  PointTileIndex() = default;
+
   // The given tile_width_degrees determines how the PointTileIndex will subdivide
   // space. All "near" queries will be based on this distance. The given polyline
   // points will be binned/indexed into our tiled space.
-  template <class container_t> PointTileIndex(double tile_width_degrees, const container_t& polyline);
+  template <class container_t>
+  PointTileIndex(double tile_width_degrees, const container_t& polyline) {
+    reset(tile_width_degrees, polyline);
+  }
+
+  // Index another polyline, reusing the memory of the previous one
+  template <class container_t> void reset(double tile_width_degrees, const container_t& polyline);
 
   // Get all the points roughly within the "tile_width_degrees" of the given pt.
   // Some of the returned points could be as far as 2*tile_width_degrees from
@@ -50,6 +68,9 @@ public:
   // to use to determine exact distances.
   std::unordered_set<size_t> get_points_near_segment(const LineSegment2<PointLL>& seg);
 
+  // Same as above but the points are appended to near_pts, which can be reused between queries
+  void get_points_near_segment(const LineSegment2<PointLL>& seg, std::vector<size_t>& near_pts) const;
+
   // Removes a point from our tiled space given its index.
   void remove_point(size_t idx);
 
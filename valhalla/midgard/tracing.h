@@ -0,0 +1,151 @@
+#ifndef VALHALLA_MIDGARD_TRACING_H_
+#define VALHALLA_MIDGARD_TRACING_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * Trace points which record spans of what a thread was doing, to see where the time of a request
+ * went on a running instance. They are only compiled in when building with ENABLE_TRACING, without
+ * it the VALHALLA_TRACE macros expand to nothing and there is no cost at all.
+ *
+ * When compiled in, each thread records its spans into a fixed size ring buffer of its own without
+ * any locking, so only the most recent spans of each thread are kept, like a flight recorder. The
+ * buffers can be dumped at any time in the chrome trace event format, which chrome://tracing and
+ * https://ui.perfetto.dev open. The service dumps them when asked for /trace over http or to a file
+ * when it gets a SIGUSR2.
+ */
+
+#ifdef ENABLE_TRACING
+
+#define VALHALLA_TRACE_CONCAT_(a, b) a##b
+#define VALHALLA_TRACE_CONCAT(a, b) VALHALLA_TRACE_CONCAT_(a, b)
+
+// records a span from here to the end of the scope, category and name must be string literals
+#define VALHALLA_TRACE_SCOPE(category, name)                                                        \
+  valhalla::midgard::tracing::scoped_span_t VALHALLA_TRACE_CONCAT(trace_span_,                      \
+                                                                  __LINE__)(category, name)
+
+#else
+
+#define VALHALLA_TRACE_SCOPE(category, name)
+
+#endif
+
+namespace valhalla {
+namespace midgard {
+namespace tracing {
+
+/**
+ * @return whether the trace points were compiled in
+ */
+constexpr bool compiled() {
+#ifdef ENABLE_TRACING
+  return true;
+#else
+  return false;
+#endif
+}
+
+namespace detail {
+extern std::atomic<bool> enabled;
+} // namespace detail
+
+/**
+ * Turns recording on or off for the whole process, it is on by default when compiled in
+ * @param enabled  whether to record
+ */
+void enable(bool enabled);
+
+/**
+ * @return whether the trace points were compiled in and are recording
+ */
+inline bool enabled() {
+  return compiled() && detail::enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * Records a span on the calling thread. The category and name are kept by pointer so they have to
+ * live until the process exits, see intern() for the ones which aren't literals
+ * @param category  what the span belongs to, for example the module
+ * @param name      what was done
+ * @param begin     when it started
+ * @param end       when it was done
+ */
+void record(const char* category,
+            const char* name,
+            std::chrono::steady_clock::time_point begin,
+            std::chrono::steady_clock::time_point end);
+
+/**
+ * Keeps a copy of a string for the lifetime of the process, the same string is only kept once
+ * @param value  the string
+ * @return the copy which can be used as the category or name of a span
+ */
+const char* intern(const std::string& value);
+
+/**
+ * Renders the spans which are still in the buffers of all threads, oldest first per thread, as a
+ * chrome trace event json document. Threads keep recording while it is rendered.
+ * @param window  only the spans which ended this long ago or less are rendered, all when zero
+ * @return the json
+ */
+std::string render(std::chrono::milliseconds window = std::chrono::milliseconds::zero());
+
+/**
+ * Renders all of the spans into a file
+ * @param path  the file
+ * @return whether the file could be written
+ */
+bool dump(const std::string& path);
+
+/**
+ * Dumps the spans into a file whenever the process gets the signal. The file is written from a
+ * thread which waits for the signal rather than from the handler. Does nothing on windows or when
+ * the trace points weren't compiled in.
+ * @param signal  the signal, SIGUSR2 for the service
+ * @param path    the file, which is overwritten on every dump
+ */
+void dump_on_signal(int signal, const std::string& path);
+
+/**
+ * Forgets the spans recorded so far, only safe when no thread is recording
+ */
+void clear();
+
+/**
+ * Records the time between its construction and its destruction as a span, use it through the
+ * VALHALLA_TRACE_SCOPE macro so it is compiled out unless tracing is
+ */
+class scoped_span_t {
+public:
+  scoped_span_t(const char* category, const char* name)
+      : category_(category), name_(name), recording_(enabled()) {
+    if (recording_) {
+      begin_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  ~scoped_span_t() {
+    if (recording_) {
+      record(category_, name_, begin_, std::chrono::steady_clock::now());
+    }
+  }
+
+  scoped_span_t(const scoped_span_t&) = delete;
+  scoped_span_t& operator=(const scoped_span_t&) = delete;
+
+protected:
+  const char* category_;
+  const char* name_;
+  bool recording_;
+  std::chrono::steady_clock::time_point begin_;
+};
+
+} // namespace tracing
+} // namespace midgard
+} // namespace valhalla
+
+#endif // VALHALLA_MIDGARD_TRACING_H_
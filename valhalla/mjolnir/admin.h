@@ -8,6 +8,8 @@
 #include <boost/geometry/multi/geometries/multi_polygon.hpp>
 
 #include <cstdint>
+#include <functional>
+#include <map>
 #include <sqlite3.h>
 #include <unordered_map>
 #include <valhalla/baldr/graphconstants.h>
@@ -56,6 +58,82 @@ uint32_t GetMultiPolyId(const std::multimap<uint32_t, multi_polygon_type>& polys
  */
 uint32_t GetMultiPolyId(const std::multimap<uint32_t, multi_polygon_type>& polys, const PointLL& ll);
 
+/**
+ * Per tile spatial index over a set of admin or timezone polygons. Every polygon ring is clipped to
+ * the segments that can still change the outcome of a point in polygon test inside of the tile and
+ * the tile is rasterized into a grid of cells. Each cell either stores the final answer (when no
+ * polygon border runs through it) or the short list of candidate polygons, so that the exact test
+ * is only run for points that fall into boundary cells. Lookups return the same ids as a linear scan
+ * with GetMultiPolyId.
+ */
+class MultiPolyIndex {
+public:
+  // Decides whether a covering polygon id ends the search, see GetMultiPolyId
+  using final_predicate_t = std::function<bool(uint32_t)>;
+
+  /**
+   * Build the index for one tile
+   * @param  polys       polys intersecting the tile, the index keeps a reference to them
+   * @param  bounds      bounds of the tile
+   * @param  is_final    when a covering poly is final its id is returned, otherwise its id is
+   *                     remembered and the search continues. If empty every hit is final.
+   * @param  grid_size   number of rows and columns of the raster
+   */
+  MultiPolyIndex(const std::multimap<uint32_t, multi_polygon_type>& polys,
+                 const AABB2<PointLL>& bounds,
+                 const final_predicate_t& is_final = {},
+                 uint32_t grid_size = kDefaultGridSize);
+
+  /**
+   * Get the polygon id covering the point, 0 if there is none.
+   * @param  ll  point that needs to be checked.
+   */
+  uint32_t GetId(const PointLL& ll) const;
+
+  /**
+   * @return the number of raster cells that need an exact test, mostly useful for benchmarking
+   */
+  size_t boundary_cell_count() const;
+
+  static constexpr uint32_t kDefaultGridSize = 16;
+
+protected:
+  // what is left of a ring after clipping, the segments are not necessarily connected anymore
+  using segments_t = std::vector<std::pair<point_type, point_type>>;
+  struct clipped_polygon_t {
+    segments_t outer;
+    std::vector<segments_t> inners;
+  };
+  struct clipped_multi_polygon_t {
+    uint32_t id;
+    std::vector<clipped_polygon_t> polygons;
+  };
+  struct candidate_t {
+    uint32_t poly; // index into clipped_
+    bool covers;   // the poly covers the whole cell, no exact test required
+  };
+  struct cell_t {
+    bool resolved;                       // id holds the answer for the whole cell
+    uint32_t id;                         // the answer when resolved
+    std::vector<candidate_t> candidates; // in multimap order when not resolved
+  };
+
+  // the same crossings test boost runs, over the clipped segments only
+  static bool Covers(const clipped_multi_polygon_t& poly, const point_type& p);
+
+  // resolves a point using the original polygons, used for points outside of the tile bounds
+  uint32_t Fallback(const PointLL& ll) const;
+
+  const std::multimap<uint32_t, multi_polygon_type>& polys_;
+  final_predicate_t is_final_;
+  AABB2<PointLL> bounds_;
+  uint32_t grid_size_;
+  double cell_width_;
+  double cell_height_;
+  std::vector<clipped_multi_polygon_t> clipped_;
+  std::vector<cell_t> cells_;
+};
+
 /**
  * Get the vector of languages for this LL.  Used by admin areas.  Checks if the pointLL is covered_by
  * the poly.
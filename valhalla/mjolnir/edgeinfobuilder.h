@@ -94,6 +94,12 @@ public:
    */
   void set_encoded_shape(const std::string& encoded_shape);
 
+  /**
+   * Store the shape bit packed (see midgard::encode_packed) instead of as 7 bit varints if that
+   * takes fewer bytes. Call this once the shape has been set.
+   */
+  void pack_shape();
+
   /**
    * Set encoded elevation.
    * @param  encoded_elevation  Encoded elevation
@@ -15,6 +15,7 @@
 #include <valhalla/baldr/graphtile.h>
 #include <valhalla/baldr/graphtileheader.h>
 #include <valhalla/baldr/nodetransition.h>
+#include <valhalla/baldr/reachlabel.h>
 #include <valhalla/baldr/sign.h>
 #include <valhalla/baldr/signinfo.h>
 #include <valhalla/baldr/transitdeparture.h>
@@ -70,8 +71,12 @@ public:
    * information.
    * @param nodes Updated list of nodes
    * @param directededges Updated list of edges.
+   * @param reach_labels Optional reach labels, one per node, which replace any the tile already
+   *                     has or are appended to the end of it
    */
-  void Update(const std::vector<NodeInfo>& nodes, const std::vector<DirectedEdge>& directededges);
+  void Update(const std::vector<NodeInfo>& nodes,
+              const std::vector<DirectedEdge>& directededges,
+              const std::vector<baldr::ReachLabel>& reach_labels = {});
 
   /**
    * Get the current list of node builders.
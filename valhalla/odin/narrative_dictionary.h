@@ -1,9 +1,14 @@
 #ifndef VALHALLA_ODIN_NARRATIVE_DICTIONARY_H_
 #define VALHALLA_ODIN_NARRATIVE_DICTIONARY_H_
 
+#include <cstdint>
+#include <initializer_list>
 #include <locale>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <boost/property_tree/ptree.hpp>
@@ -174,8 +179,102 @@ constexpr auto kLevelTag = "<LEVEL>";
 namespace valhalla {
 namespace odin {
 
+/**
+ * The tags that can be substituted into a phrase. Each one corresponds to
+ * one of the phrase tag strings above, e.g. kStreetNames to kStreetNamesTag.
+ */
+enum class PhraseTag : uint8_t {
+  kCardinalDirection,
+  kRelativeDirection,
+  kOrdinalValue,
+  kStreetNames,
+  kPreviousStreetNames,
+  kBeginStreetNames,
+  kCrossStreetNames,
+  kRoundaboutExitStreetNames,
+  kRoundaboutExitBeginStreetNames,
+  kRampExitNumbersVisual,
+  kObjectLabel,
+  kLength,
+  kDestination,
+  kCurrentVerbalCue,
+  kNextVerbalCue,
+  kNumberSign,
+  kBranchSign,
+  kTowardSign,
+  kNameSign,
+  kJunctionName,
+  kFerryLabel,
+  kTransitPlatform,
+  kStationLabel,
+  kTime,
+  kTransitName,
+  kTransitHeadSign,
+  kTransitPlatformCount,
+  kTransitPlatformCountLabel,
+  kLevel,
+  kLiteral // not a tag, marks the literal text between tags
+};
+
+/**
+ * A phrase compiled into runs of literal text and tag slots when the
+ * dictionary is loaded. Forming an instruction is then a single pass over
+ * the slots instead of a search and replace over the whole phrase per tag.
+ */
+class PhraseTemplate {
+public:
+  using tag_value_t = std::pair<PhraseTag, std::string_view>;
+
+  /**
+   * Compiles the specified phrase. Text that looks like a tag but isn't one
+   * of the known phrase tags is kept as literal text.
+   *
+   * @param  phrase  The tagged phrase, e.g. "Turn <RELATIVE_DIRECTION>."
+   */
+  explicit PhraseTemplate(const std::string& phrase);
+
+  /**
+   * Replaces the contents of the specified buffer with the phrase, writing
+   * each tag's value in its slots. Tags without a value are written as is.
+   * The buffer keeps its capacity, so callers can reserve it up front.
+   *
+   * @param  buffer  The buffer to write the phrase into.
+   * @param  values  The values for the tags in the phrase.
+   */
+  void Format(std::string& buffer, std::initializer_list<tag_value_t> values) const;
+
+  /**
+   * Returns the tagged phrase this template was compiled from.
+   *
+   * @return the tagged phrase this template was compiled from.
+   */
+  const std::string& phrase() const;
+
+protected:
+  struct slot_t {
+    uint32_t offset; // into phrase_
+    uint32_t length;
+    PhraseTag tag;
+  };
+
+  std::string phrase_;
+  std::vector<slot_t> slots_;
+};
+
 struct PhraseSet {
   std::unordered_map<std::string, std::string> phrases;
+
+  // The phrases compiled into templates, indexed by phrase id
+  std::vector<std::optional<PhraseTemplate>> templates;
+
+  /**
+   * Returns the compiled template of the specified phrase.
+   * Throws std::out_of_range if there is no phrase with that id.
+   *
+   * @param  phrase_id  The id of the phrase.
+   * @return the compiled template of the specified phrase.
+   */
+  const PhraseTemplate& GetTemplate(size_t phrase_id) const;
 };
 
 struct StartSubset : PhraseSet {
@@ -577,6 +577,16 @@ protected:
                               const std::string& delim = "/",
                               const VerbalTextFormatter* verbal_formatter = nullptr);
 
+  /////////////////////////////////////////////////////////////////////////////
+  /**
+   * Sets the verbal alert, pre, post, succinct, depart and arrive instructions of the
+   * specified maneuver. Expects the text instruction to already be set.
+   *
+   * @param maneuver      The maneuver to process.
+   * @param prev_maneuver The previous maneuver, may be null.
+   */
+  void FormVerbalInstructions(Maneuver& maneuver, Maneuver* prev_maneuver);
+
   /////////////////////////////////////////////////////////////////////////////
   /**
    * Processes the specified maneuver list and creates verbal multi-cue
@@ -536,6 +536,7 @@ const std::string& ShapeMatch_Enum_Name(const ShapeMatch match);
 bool Options_Format_Enum_Parse(const std::string& format, Options::Format* f);
 const std::string& Options_Format_Enum_Name(const Options::Format match);
 const std::string& Options_Units_Enum_Name(const Options::Units unit);
+bool Options_ColumnEncoding_Enum_Parse(const std::string& encoding, Options::ColumnEncoding* e);
 bool FilterAction_Enum_Parse(const std::string& action, FilterAction* a);
 const std::string& FilterAction_Enum_Name(const FilterAction action);
 bool DirectionsType_Enum_Parse(const std::string& dtype, DirectionsType* t);
@@ -926,6 +926,26 @@ public:
             user_exclude_edges_.find(edgeid) != user_exclude_edges_.end());
   }
 
+  /**
+   * Check if the request excludes parts of the graph the mode could otherwise use, either by road
+   * attributes like tolls, ferries or unpaved roads or by avoid locations and polygons.
+   * @return Returns true if anything is excluded, false otherwise.
+   */
+  bool HasExclusions() const {
+    return has_excludes_ || exclude_unpaved_ || exclude_cash_only_tolls_ ||
+           !user_exclude_edges_.empty();
+  }
+
+  /**
+   * Check if the reach labels of the tiles are a lower bound on the reach of this costing. They
+   * are computed over the edges every costing of the access mode allows with its default options,
+   * see baldr::ReachLabel, so they only are when this costing is no stricter than that.
+   * @return Returns true if the labels can be used in place of a search, false otherwise.
+   */
+  virtual bool ReachLabelsApply() const {
+    return false;
+  }
+
   /**
    * Check if the edge is in the user-specified avoid list and should be avoided when used
    * as an origin. In this case the edge is avoided if the avoid percent along is greater than
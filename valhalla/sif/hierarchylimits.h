@@ -3,6 +3,8 @@
 
 #include <cstdint>
 #include <limits>
+#include <vector>
+
 #include <valhalla/proto/options.pb.h>
 
 // Default hierarchy transitions. Note that this corresponds to a 3 level
@@ -31,6 +33,36 @@ constexpr float kDefaultExpansionWithinDistBidir[] = {kMaxDistance, 20000.0f, 50
 namespace valhalla {
 namespace sif {
 
+/**
+ * The hierarchy limits of one level as the path algorithms use them during a search. The
+ * upward transition count changes with every transition that is expanded so the algorithms
+ * keep these plain copies instead of the HierarchyLimits messages of the costing, which are
+ * only read when a search is initialized.
+ */
+struct HierarchyLimitState {
+  uint32_t up_transition_count = 0;
+  uint32_t max_up_transitions = kUnlimitedTransitions;
+  float expand_within_dist = kMaxDistance;
+
+  HierarchyLimitState() = default;
+
+  explicit HierarchyLimitState(const valhalla::HierarchyLimits& limits)
+      : up_transition_count(limits.up_transition_count()),
+        max_up_transitions(limits.max_up_transitions()),
+        expand_within_dist(limits.expand_within_dist()) {
+  }
+};
+
+/**
+ * Copy the hierarchy limits of all levels, e.g. those of a costing, for use in a search.
+ * @param hierarchy_limits Hierarchy limits per level.
+ * @return                 Returns the search state of the limits per level.
+ */
+inline std::vector<HierarchyLimitState>
+ToHierarchyLimitStates(const std::vector<valhalla::HierarchyLimits>& hierarchy_limits) {
+  return {hierarchy_limits.begin(), hierarchy_limits.end()};
+}
+
 /**
  * Determine if expansion of a hierarchy level should be stopped once
  * the number of upward transitions has been exceeded. Allows expansion
@@ -40,9 +72,9 @@ namespace sif {
  * @param dist             Distance (meters) from the destination.
  * @return                 Returns true if expansion at this hierarchy level should stop.
  */
-inline bool StopExpanding(const valhalla::HierarchyLimits& hierarchy_limits, const float dist) {
-  return (hierarchy_limits.up_transition_count() > hierarchy_limits.max_up_transitions() &&
-          dist > hierarchy_limits.expand_within_dist());
+inline bool StopExpanding(const HierarchyLimitState& hierarchy_limits, const float dist) {
+  return (hierarchy_limits.up_transition_count > hierarchy_limits.max_up_transitions &&
+          dist > hierarchy_limits.expand_within_dist);
 }
 
 /**
@@ -53,8 +85,8 @@ inline bool StopExpanding(const valhalla::HierarchyLimits& hierarchy_limits, con
  * @param hierarchy_limits Hierarchy limits.
  * @return                 Returns true if expansion at this hierarchy level should stop.
  */
-inline bool StopExpanding(const valhalla::HierarchyLimits& hierarchy_limits) {
-  return hierarchy_limits.up_transition_count() > hierarchy_limits.max_up_transitions();
+inline bool StopExpanding(const HierarchyLimitState& hierarchy_limits) {
+  return hierarchy_limits.up_transition_count > hierarchy_limits.max_up_transitions;
 }
 
 /**
@@ -0,0 +1,111 @@
+#ifndef VALHALLA_THOR_MATRIX_COST_MODEL_H_
+#define VALHALLA_THOR_MATRIX_COST_MODEL_H_
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include <boost/optional.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <valhalla/proto/matrix.pb.h>
+#include <valhalla/proto/options.pb.h>
+#include <valhalla/sif/costconstants.h>
+
+namespace valhalla {
+namespace thor {
+
+/**
+ * What the runtime of a matrix request depends on, taken from the request before it is computed
+ */
+struct matrix_features_t {
+  uint32_t sources;
+  uint32_t targets;
+  // the diagonal of the bounding box of all the locations in kilometers, which is how far the
+  // searches have to go
+  float spread;
+  // whether the costs depend on the time of day
+  bool time_dependent;
+};
+
+/**
+ * Predicts how long CostMatrix and TimeDistanceMatrix take for a request so thor can pick the one
+ * that will be faster. Both are modelled as a fixed cost, a cost per location, the cost of their
+ * searches, which grows with how far they have to go, and a cost per pair of locations:
+ *
+ *   ms = fixed + per_location * (sources + targets)
+ *        + searches * (per_search_km * spread + per_search_km2 * spread^2)
+ *        + per_pair * sources * targets
+ *
+ * CostMatrix is the bidirectional many to many algorithm, it runs a search from every location
+ * and connects them where they meet so it has sources + targets searches. TimeDistanceMatrix runs
+ * one unidirectional search from each location on the smaller side to all of the other side so it
+ * has min(sources, targets) searches. Time dependent requests are scaled by another factor.
+ *
+ * The coefficients are per algorithm and travel mode, they come from the config as
+ * thor.matrix_cost_model.<drive|pedestrian|bicycle>.<costmatrix|timedistancematrix> and are
+ * calibrated with the benchmarks in bench/. A travel mode is only calibrated when both algorithms
+ * have coefficients, nothing is predicted for it otherwise.
+ */
+class MatrixCostModel {
+public:
+  struct coefficients_t {
+    float fixed;
+    float per_location;
+    float per_search_km;
+    float per_search_km2;
+    float per_pair;
+    float time_dependent_factor;
+  };
+
+  /**
+   * Constructor.
+   * @param config  the thor.matrix_cost_model part of the config, if any
+   */
+  explicit MatrixCostModel(const boost::optional<const boost::property_tree::ptree&>& config = {});
+
+  /**
+   * Takes the features of a matrix request
+   * @param options         the options of the request
+   * @param time_dependent  whether the request has a time
+   * @return the features
+   */
+  static matrix_features_t features(const Options& options, const bool time_dependent);
+
+  /**
+   * @param mode  the travel mode of the request
+   * @return whether there are coefficients for both algorithms for the travel mode
+   */
+  bool calibrated(const sif::TravelMode mode) const;
+
+  /**
+   * Predicts the runtime of an algorithm
+   * @param algorithm  CostMatrix or TimeDistanceMatrix
+   * @param mode       the travel mode of the request
+   * @param features   the features of the request
+   * @return the runtime in milliseconds or nothing if the algorithm isn't calibrated for the mode
+   */
+  boost::optional<float> predict(const Matrix::Algorithm algorithm,
+                                 const sif::TravelMode mode,
+                                 const matrix_features_t& features) const;
+
+  /**
+   * Picks the algorithm which is predicted to be the fastest, only meaningful when the travel mode
+   * is calibrated
+   * @param mode      the travel mode of the request
+   * @param features  the features of the request
+   * @return CostMatrix or TimeDistanceMatrix
+   */
+  Matrix::Algorithm select(const sif::TravelMode mode, const matrix_features_t& features) const;
+
+protected:
+  // per travel mode, the coefficients of CostMatrix and TimeDistanceMatrix
+  std::array<std::array<boost::optional<coefficients_t>, 2>,
+             static_cast<size_t>(sif::TravelMode::kMaxTravelMode)>
+      coefficients_;
+};
+
+} // namespace thor
+} // namespace valhalla
+
+#endif // VALHALLA_THOR_MATRIX_COST_MODEL_H_
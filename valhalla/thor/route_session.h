@@ -0,0 +1,98 @@
+#ifndef VALHALLA_THOR_ROUTE_SESSION_H_
+#define VALHALLA_THOR_ROUTE_SESSION_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <valhalla/baldr/graphreader.h>
+#include <valhalla/proto/common.pb.h>
+#include <valhalla/sif/dynamiccost.h>
+#include <valhalla/sif/edgelabel.h>
+#include <valhalla/thor/dijkstras.h>
+#include <valhalla/thor/pathinfo.h>
+
+namespace valhalla {
+namespace thor {
+
+/**
+ * A forward shortest path tree from a single origin which is kept between requests. Unlike the
+ * goal directed path algorithms, which are only valid for the destination they were searching
+ * for, the tree settles edges strictly by cost from the origin. That means it can be grown a bit
+ * further whenever a route to another destination is asked of it and everything it settled for
+ * earlier destinations is reused.
+ *
+ * The tree is time independent, it is only meant for routes without a date_time.
+ */
+class RouteSession : public Dijkstras {
+public:
+  /**
+   * Constructor.
+   * @param config A config object of key, value pairs
+   */
+  explicit RouteSession(const boost::property_tree::ptree& config = {});
+
+  /**
+   * Destructor
+   */
+  virtual ~RouteSession() {
+  }
+
+  /**
+   * Seeds the tree with the edges of the origin location. The costing is kept by the session, the
+   * paths it finds later on are only valid for requests with an equivalent costing.
+   * @param origin    the correlated origin location
+   * @param reader    graph reader to provide access to graph primitives
+   * @param costing   the costing to expand with
+   * @param mode      the travel mode of the costing
+   */
+  void Start(const valhalla::Location& origin,
+             baldr::GraphReader& reader,
+             const sif::cost_ptr_t& costing,
+             const sif::TravelMode mode);
+
+  /**
+   * Grows the tree until the best path from the origin to the destination is known and forms it.
+   * @param destination  the correlated destination location
+   * @param reader       graph reader to provide access to graph primitives
+   * @param max_labels   the tree is not grown past this many edge labels
+   * @return the path or nothing if the destination could not be reached within the label limit
+   *         or needs a path which loops back over an origin edge, which the tree can't represent
+   */
+  std::vector<PathInfo> GetBestPath(const valhalla::Location& destination,
+                                    baldr::GraphReader& reader,
+                                    const uint32_t max_labels);
+
+  /**
+   * @return the number of edge labels in the tree, which is what its memory use grows with
+   */
+  size_t label_count() const {
+    return bdedgelabels_.size();
+  }
+
+protected:
+  // The tree has nothing to do at each node
+  void ExpandingNode(baldr::GraphReader&,
+                     graph_tile_ptr,
+                     const baldr::NodeInfo*,
+                     const sif::EdgeLabel&,
+                     const sif::EdgeLabel*) override {
+  }
+
+  // The tree is grown by GetBestPath rather than Compute so this is never asked
+  ExpansionRecommendation ShouldExpand(baldr::GraphReader&,
+                                       const sif::EdgeLabel&,
+                                       const ExpansionType) override {
+    return ExpansionRecommendation::continue_expansion;
+  }
+
+  void GetExpansionHints(uint32_t& bucket_count, uint32_t& edge_label_reservation) const override;
+
+  // The origin the tree was started from
+  google::protobuf::RepeatedPtrField<valhalla::Location> origin_;
+};
+
+} // namespace thor
+} // namespace valhalla
+
+#endif // VALHALLA_THOR_ROUTE_SESSION_H_
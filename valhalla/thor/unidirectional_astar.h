@@ -160,7 +160,7 @@ protected:
   uint8_t travel_type_;  // Current travel type
 
   // Hierarchy limits.
-  std::vector<HierarchyLimits> hierarchy_limits_;
+  std::vector<sif::HierarchyLimitState> hierarchy_limits_;
 
   // A* heuristic
   AStarHeuristic astarheuristic_;
@@ -1,6 +1,13 @@
 #ifndef __VALHALLA_THOR_SERVICE_H__
 #define __VALHALLA_THOR_SERVICE_H__
 
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <tuple>
 #include <vector>
 
@@ -23,7 +30,9 @@
 #include <valhalla/thor/centroid.h>
 #include <valhalla/thor/costmatrix.h>
 #include <valhalla/thor/isochrone.h>
+#include <valhalla/thor/matrix_cost_model.h>
 #include <valhalla/thor/multimodal.h>
+#include <valhalla/thor/route_session.h>
 #include <valhalla/thor/timedistancebssmatrix.h>
 #include <valhalla/thor/timedistancematrix.h>
 #include <valhalla/thor/triplegbuilder.h>
@@ -54,30 +63,146 @@ public:
   static void adjust_scores(valhalla::Options& options);
 
   void route(Api& request);
-  std::string matrix(Api& request);
+  std::string matrix(Api& request, const chunk_sink_t& sink = {});
   void optimized_route(Api& request);
   std::string isochrones(Api& request);
   void trace_route(Api& request);
   std::string trace_attributes(Api& request);
-  std::string expansion(Api& request);
+  std::string expansion(Api& request, const chunk_sink_t& sink = {});
   void centroid(Api& request);
   void status(Api& request) const;
 
   void set_interrupt(const std::function<void()>* interrupt) override;
 
 protected:
+  /**
+   * The legs of a multi-leg route which dont depend on each other can be found concurrently. Each
+   * thread doing so needs its own graph reader, costing and path algorithms. A worker has a thread
+   * of its own, started the first time it is handed a job, which waits for the next job for as
+   * long as the worker lives so routes don't start threads of their own
+   */
+  struct leg_worker_t {
+    explicit leg_worker_t(const boost::property_tree::ptree& config);
+    ~leg_worker_t();
+
+    /**
+     * Runs the job on the thread of the worker, the previous job must have been waited for
+     * @param job  what to run, it must not throw
+     */
+    void start(std::function<void()> job);
+
+    /**
+     * Waits until the thread of the worker is done with its job
+     */
+    void wait();
+
+    baldr::GraphReader reader;
+    BidirectionalAStar bidir_astar;
+    TimeDepForward timedep_forward;
+    sif::TravelMode mode;
+    sif::mode_costing_t mode_costing;
+
+  protected:
+    void work();
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::function<void()> job;
+    bool stop;
+    std::thread thread;
+  };
+
   std::vector<std::vector<thor::PathInfo>> get_path(PathAlgorithm* path_algorithm,
                                                     Location& origin,
                                                     Location& destination,
                                                     const std::string& costing,
-                                                    const Options& options);
+                                                    const Options& options,
+                                                    leg_worker_t* leg_worker = nullptr);
+
+  /**
+   * Finds the paths of all the legs of a route at once, the first leg worker on the calling thread
+   * and the others on their own threads. The legs must not depend on one another, no through
+   * locations or time to carry from one to the next.
+   * @param options     the request options with the correlated locations
+   * @param costing     the name of the costing
+   * @param algorithms  for each leg, which of bidir_astar or timedep_forward to use
+   * @param limits      for each leg, the hierarchy limits to set on the costing
+   * @return the paths of each leg or nothing if any of the legs needs to be found serially after
+   *         all, because it failed or had to relax the costing in a second pass
+   */
+  std::vector<std::vector<std::vector<thor::PathInfo>>>
+  get_leg_paths(const Options& options,
+                const std::string& costing,
+                const std::vector<PathAlgorithm*>& algorithms,
+                const std::vector<std::vector<HierarchyLimits>>& limits);
+
+  /**
+   * A forward tree from the origin of an earlier route, kept so that routes from the same origin
+   * with the same costing continue its expansion instead of starting a search from scratch
+   */
+  struct route_session_t {
+    std::string key;
+    std::chrono::steady_clock::time_point last_used;
+    std::unique_ptr<RouteSession> tree;
+  };
+
+  /**
+   * Finds the path between two locations in the route session of the origin. A session only
+   * stands in for the first pass of get_path, which keeps out of destination only areas. Whatever
+   * would take a second pass there, a failure or a short pedestrian route with a ferry, is left to
+   * get_path so that it relaxes the limits and adds the filtered edges the same way it always does.
+   * How many labels the session already had and how many sessions are kept are recorded in the
+   * statistics of the request.
+   * @param api          the request with its options and statistics
+   * @param origin       the correlated origin location
+   * @param destination  the correlated destination location
+   * @param costing      the name of the costing of the request
+   * @return the path or nothing if get_path has to find it
+   */
+  std::vector<std::vector<thor::PathInfo>> get_session_path(Api& api,
+                                                            const Location& origin,
+                                                            const Location& destination,
+                                                            const std::string& costing);
+
+  /**
+   * Gets the route session of an origin, starting a new one if there is none for the origin and
+   * costing yet. The least recently used session is evicted to make room for it.
+   * @param origin   the correlated origin location
+   * @param options  the request options with the costing
+   * @param now      the current time
+   * @return the session, which is moved to the front
+   */
+  route_session_t& get_route_session(const Location& origin,
+                                     const Options& options,
+                                     const std::chrono::steady_clock::time_point& now);
+
+  /**
+   * Drops the route sessions which have not been used within their ttl
+   * @param now  the current time
+   */
+  void expire_route_sessions(const std::chrono::steady_clock::time_point& now);
+
   void log_admin(const TripLeg&);
   thor::PathAlgorithm* get_path_algorithm(const std::string& routetype,
                                           const Location& origin,
                                           const Location& destination,
                                           const Options& options);
-  thor::MatrixAlgorithm*
-  get_matrix_algorithm(Api& request, const bool has_time, const std::string& costing);
+  thor::MatrixAlgorithm* get_matrix_algorithm(Api& request,
+                                              const bool has_time,
+                                              const std::string& costing,
+                                              const matrix_features_t& features);
+  /**
+   * Logs at debug level which matrix algorithm ran for the request, what the cost model predicted
+   * it would take and what it actually took
+   * @param request         the request after the matrix was computed
+   * @param features        what the prediction was made from
+   * @param elapsed_ms      how long the first pass of the algorithm took
+   * @param second_pass_ms  how long the second pass of CostMatrix took if it needed one
+   */
+  void log_matrix(const Api& request,
+                  const matrix_features_t& features,
+                  const float elapsed_ms,
+                  const boost::optional<float>& second_pass_ms = boost::none) const;
   void route_match(Api& request);
   /**
    * Returns the results of the map match where the first float is the normalized
@@ -129,12 +254,23 @@ protected:
   float max_timedep_distance;
   std::unordered_map<std::string, float> max_matrix_distance;
   SOURCE_TO_TARGET_ALGORITHM source_to_target_algorithm;
+  // predicts the faster matrix algorithm when source_to_target_algorithm is select_optimal
+  MatrixCostModel matrix_cost_model;
   bool costmatrix_allow_second_pass;
   std::shared_ptr<baldr::GraphReader> reader;
   meili::MapMatcherFactory matcher_factory;
   baldr::AttributesController controller;
   Centroid centroid_gen;
 
+  // Workers for finding independent route legs concurrently, none if they are found serially
+  std::vector<std::unique_ptr<leg_worker_t>> leg_workers;
+
+  // Route sessions, the most recently used one first, none are kept if max_route_sessions is 0
+  std::list<route_session_t> route_sessions;
+  size_t max_route_sessions;
+  std::chrono::seconds route_session_ttl;
+  uint32_t route_session_max_labels;
+
   // Hierarchy limits
   bool allow_hierarchy_limits_modifications;
   // ignored if allow_hierarchy_limits_modifications is false
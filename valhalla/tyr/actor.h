@@ -6,10 +6,24 @@
 
 #include <valhalla/baldr/graphreader.h>
 #include <valhalla/proto/api.pb.h>
+#include <valhalla/worker.h>
+
+#ifdef ENABLE_SERVICES
+#include <prime_server/prime_server.hpp>
+#endif
 
 namespace valhalla {
 namespace tyr {
 
+#ifdef ENABLE_SERVICES
+/**
+ * Runs loki, thor and odin as a single in-process pipeline stage. The request is handed from one
+ * worker to the next as a pointer instead of being serialized to protobuf bytes between stages.
+ * @param config  used to configure the workers and the endpoints to listen on
+ */
+void run_service(const boost::property_tree::ptree& config);
+#endif
+
 class actor_t {
 public:
   /**
@@ -44,6 +58,25 @@ public:
    */
   std::string act(Api& api, const std::function<void()>* interrupt = nullptr);
 
+#ifdef ENABLE_SERVICES
+  /**
+   * The work function for running the whole pipeline as a single prime_server stage. The http
+   * request is parsed into an Api object allocated in an arena owned by this actor, every worker
+   * then operates on that same object and the response goes straight back to the client. The
+   * arena is reset on cleanup.
+   *
+   * @param  job           the http request from the server
+   * @param  request_info  the http_request_info object used to communicate with the server about
+   *                       the state of the request
+   * @param  interrupt     a function that may be called periodically and will throw when processing
+   *                       should be interrupted
+   * @return result_t      the http response to send back to the client
+   */
+  prime_server::worker_t::result_t work(const std::list<zmq::message_t>& job,
+                                        void* request_info,
+                                        const std::function<void()>& interrupt);
+#endif
+
   /**
    * Perform the route action and return json or protobuf depending on which was requested. The
    * request may either be in the form of a json string provided by the request_str parameter or
@@ -80,11 +113,14 @@ public:
    * @param interrupt    allows the underlying computation to be aborted via the functor throwing
    * @param api          protobuffer object which can contain the input request via the options object
    *                     and will be filled out as the request is processed
+   * @param sink         optional, receives the response in chunks while it is serialized in which
+   *                     case the returned string is empty
    * @return json or pbf bytes depending on what was specified in the options object
    */
   std::string matrix(const std::string& request_str,
                      const std::function<void()>* interrupt = nullptr,
-                     Api* api = nullptr);
+                     Api* api = nullptr,
+                     const chunk_sink_t& sink = {});
 
   /**
    * Perform the optimized_route action and return json or protobuf depending on which was requested.
@@ -142,6 +178,24 @@ public:
                                const std::function<void()>* interrupt = nullptr,
                                Api* api = nullptr);
 
+  /**
+   * Perform the trace_route or trace_attributes action for each trace of a batch. The request is a
+   * regular trace request whose "traces" array holds an object per trace with its "shape" or
+   * "encoded_polyline" and anything else the trace should override in the rest of the request. The
+   * traces are matched by a pool of `meili.batch_threads` workers which share one tile cache and
+   * each have their own map matchers, or one after another by this actor if there is no pool.
+   * trace_route and trace_attributes hand requests with a "traces" array to this method, without
+   * filling out their api object.
+   * @param request_str  json string of the batch request
+   * @param action       trace_route or trace_attributes
+   * @param interrupt    allows the batch to be aborted via the functor throwing
+   * @return json with the response of each trace, in the order of the request, in a "traces"
+   *         array. A trace which fails gets the error response it would have gotten on its own
+   */
+  std::string trace_batch(const std::string& request_str,
+                          const Options::Action action,
+                          const std::function<void()>* interrupt = nullptr);
+
   /**
    * Perform the height action and return json or protobuf depending on which was requested. The
    * request may either be in the form of a json string provided by the request_str parameter or
@@ -178,11 +232,14 @@ public:
    * @param interrupt    allows the underlying computation to be aborted via the functor throwing
    * @param api          protobuffer object which can contain the input request via the options object
    *                     and will be filled out as the request is processed
+   * @param sink         optional, receives the response in chunks while the expansion runs in which
+   *                     case the returned string is empty
    * @return json or pbf bytes depending on what was specified in the options object
    */
   std::string expansion(const std::string& request_str,
                         const std::function<void()>* interrupt = nullptr,
-                        Api* api = nullptr);
+                        Api* api = nullptr,
+                        const chunk_sink_t& sink = {});
 
   /**
    * Perform the centroid action and return json or protobuf depending on which was requested. The
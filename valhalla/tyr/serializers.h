@@ -1,8 +1,10 @@
 #ifndef __VALHALLA_TYR_SERVICE_H__
 #define __VALHALLA_TYR_SERVICE_H__
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <valhalla/baldr/attributes_controller.h>
@@ -17,6 +19,7 @@
 #include <valhalla/proto/api.pb.h>
 #include <valhalla/proto_conversions.h>
 #include <valhalla/tyr/actor.h>
+#include <valhalla/worker.h>
 
 namespace valhalla {
 namespace tyr {
@@ -26,10 +29,38 @@ namespace tyr {
  */
 std::string serializeDirections(Api& request);
 
+/**
+ * Header of the columnar matrix format. It is followed by the times column and then the distances
+ * column, each holding sources * targets cells ordered by source then target and padded to
+ * column_bytes so that both start on an 8 byte boundary. Everything is little endian.
+ *
+ * raw:     float32 seconds and float32 distances in the requested units, NaN where unreachable
+ * float16: same as raw but half precision, times beyond 65504 seconds become infinite
+ * delta:   int32 whole seconds and int32 thousandths of the requested unit, -1 where unreachable,
+ *          each cell stored as the difference to the previous cell of its row
+ */
+struct columnar_matrix_header_t {
+  char magic[4];         // always "VMTX"
+  uint8_t version;       // kColumnarMatrixVersion
+  uint8_t encoding;      // Options::ColumnEncoding
+  uint8_t algorithm;     // Matrix::Algorithm
+  uint8_t units;         // Options::Units
+  uint32_t sources;      // number of rows
+  uint32_t targets;      // number of columns
+  uint64_t column_bytes; // size of each column including its padding
+  uint64_t reserved;
+};
+static_assert(sizeof(columnar_matrix_header_t) == 32, "Columnar matrix header must be 32 bytes");
+constexpr uint8_t kColumnarMatrixVersion = 1;
+
 /**
  * Turn a time distance matrix into json that one can look up location pair results from
+ *
+ * @param request  the request holding the matrix
+ * @param sink     optional, if set the response is handed to it in chunks as it is written and the
+ *                 returned string is empty. Only the columnar format is written in bounded chunks.
  */
-std::string serializeMatrix(Api& request);
+std::string serializeMatrix(Api& request, const chunk_sink_t& sink = {});
 
 /**
  * Turn grid data contours into geojson
@@ -45,6 +76,35 @@ std::string serializeIsochrones(Api& request,
  */
 std::string serializeExpansion(Api& request, const std::string& algo);
 
+/**
+ * Writes the expansion geojson incrementally. Every call to write serializes the edges recorded in
+ * the expansion, which the caller can then clear. Given a sink the output is handed off in chunks
+ * as well, so that neither the expansion nor the response have to grow with the size of the search.
+ */
+class expansion_writer_t {
+public:
+  expansion_writer_t(const Options& options, chunk_sink_t sink = {});
+
+  /**
+   * Serializes the edges recorded in the expansion
+   * @param expansion  the edges to write
+   */
+  void write(const Expansion& expansion);
+
+  /**
+   * Writes the remaining edges and closes the feature collection
+   * @param expansion  the remaining edges to write
+   * @param algo       the algorithm that did the expansion
+   * @return the whole geojson or, if there is a sink, an empty string
+   */
+  std::string finish(const Expansion& expansion, const std::string& algo);
+
+protected:
+  rapidjson::writer_wrapper_t writer;
+  std::unordered_set<Options::ExpansionProperties> exp_props;
+  chunk_sink_t sink;
+};
+
 /**
  * Turn heights and ranges into a height response
  *
@@ -1,9 +1,12 @@
 #ifndef __VALHALLA_SERVICE_H__
 #define __VALHALLA_SERVICE_H__
+#include <functional>
 #include <string>
+#include <string_view>
 
 #include <valhalla/baldr/json.h>
 #include <valhalla/baldr/rapidjson_utils.h>
+#include <valhalla/midgard/metrics.h>
 #include <valhalla/midgard/util.h>
 #include <valhalla/proto/api.pb.h>
 #include <valhalla/sif/dynamiccost.h>
@@ -18,6 +21,14 @@
 
 namespace valhalla {
 
+/**
+ * Receives a response in pieces while it is being serialized. Each piece is only valid for the
+ * duration of the call, so the sink has to write or copy it before returning. prime_server sends a
+ * worker's result as one message, so the service collects the pieces into a single response body
+ * and only library callers with their own sink avoid holding the whole response.
+ */
+using chunk_sink_t = std::function<void(std::string_view)>;
+
 struct hierarchy_limits_config_t {
   std::vector<HierarchyLimits> max_limits;
   std::vector<HierarchyLimits> default_limits;
@@ -66,6 +77,15 @@ struct valhalla_exception_t : public std::runtime_error {
  */
 void ParseApi(const std::string& json_request, Options::Action action, Api& api);
 
+/**
+ * Fill out the pbf request with a json request which has already been parsed and validate it.
+ *
+ * @param document  The json request in the APIs request format, it may be modified while parsing
+ * @param action    Which action to perform
+ * @param api       The pbf request, this will be cleared and filled out with the json provided
+ */
+void ParseApi(rapidjson::Document& document, Options::Action action, Api& api);
+
 /**
  * Parse hierarchy limits from config. Falls back to default values if none are found at the
  * given path.
@@ -131,13 +151,91 @@ const content_type JSON_MIME{"Content-type", "application/json;charset=utf-8"};
 const content_type JS_MIME{"Content-type", "application/javascript;charset=utf-8"};
 const content_type PBF_MIME{"Content-type", "application/x-protobuf"};
 const content_type GPX_MIME{"Content-type", "application/gpx+xml;charset=utf-8"};
+const content_type BINARY_MIME{"Content-type", "application/octet-stream"};
+const content_type PROMETHEUS_MIME{"Content-type", "text/plain;version=0.0.4;charset=utf-8"};
 } // namespace worker
 
 prime_server::worker_t::result_t to_response(const std::string& data,
                                              prime_server::http_request_info_t& request_info,
                                              const Api& options);
+
+/**
+ * Answers a scrape of the latency histograms, which is a GET of /metrics when they are recorded
+ *
+ * @param http_request  the request
+ * @param request_info  the info of the request
+ * @param result        set to the response if it was a scrape
+ * @return whether the request was a scrape
+ */
+bool serve_metrics(const prime_server::http_request_t& http_request,
+                   prime_server::http_request_info_t& request_info,
+                   prime_server::worker_t::result_t& result);
+
+/**
+ * Answers a dump of the trace points, which is a GET of /trace when they were compiled in. The
+ * optional seconds parameter limits the dump to the spans which ended in that many last seconds
+ *
+ * @param http_request  the request
+ * @param request_info  the info of the request
+ * @param result        set to the response if it was a dump
+ * @return whether the request was a dump
+ */
+bool serve_trace(const prime_server::http_request_t& http_request,
+                 prime_server::http_request_info_t& request_info,
+                 prime_server::worker_t::result_t& result);
 #endif
 
+/**
+ * The arena backing the request object of a worker. All of the messages hanging off of the request
+ * (legs, edges, names, maneuvers and so on) are carved out of a few big blocks instead of being heap
+ * allocated one by one and they are all freed in one go when the arena is reset between requests.
+ * The first block is owned by this object and survives resets so small requests don't touch the
+ * heap at all.
+ */
+class request_arena_t {
+public:
+  request_arena_t(size_t initial_block_size = kInitialBlockSize);
+
+  /**
+   * @return a new empty request allocated in the arena, valid until the next reset
+   */
+  Api& request();
+
+  /**
+   * Frees everything allocated in the arena since the last reset
+   */
+  void reset();
+
+  /**
+   * @return the number of blocks the arena had to get from the heap since the last reset
+   */
+  uint64_t blocks_allocated() const;
+
+  /**
+   * @return the number of bytes the arena holds, including the initial block
+   */
+  uint64_t bytes_allocated() const;
+
+  /**
+   * @return the number of bytes of the arena that are in use by messages
+   */
+  uint64_t bytes_used() const;
+
+  /**
+   * Adds the heap blocks and bytes this arena needed so far as gauges to the request statistics
+   * @param api      the request, nothing is recorded unless it lives in this arena
+   * @param service  name of the service used in the statistic keys
+   */
+  void record_statistics(Api& api, const std::string& service) const;
+
+  static constexpr size_t kInitialBlockSize = 64 * 1024;
+
+protected:
+  std::unique_ptr<char[]> initial_block_;
+  google::protobuf::Arena arena_;
+  uint64_t blocks_at_reset_;
+};
+
 struct statsd_client_t;
 class service_worker_t {
 public:
@@ -176,13 +274,13 @@ public:
    */
   virtual void set_interrupt(const std::function<void()>* interrupt);
 
-protected:
   /**
    * This converts each protobuf stat into a string and adds it to the queue of unsent stats
    * @param api  The request tracking object which has the tracked stats stored in it
    */
   void enqueue_statistics(Api& api) const;
 
+protected:
   /**
    * Returns name of the service used in statistics
    */
@@ -197,6 +295,15 @@ protected:
    */
   midgard::Finally<std::function<void()>> measure_scope_time(Api& api) const;
 
+  /**
+   * Used to measure the time it takes to serialize the response of a request, call it right before
+   * serializing in the same scope
+   *
+   * @param api  The request which is being serialized
+   * @return an object whose destructor records the elapsed time since construction
+   */
+  midgard::metrics::scoped_timer_t measure_serialization(const Api& api) const;
+
   /**
    * Signals the start of the worker, sends statsd message if so configured
    */
@@ -204,6 +311,10 @@ protected:
 
   const std::function<void()>* interrupt;
   std::unique_ptr<statsd_client_t> statsd_client;
+  // the request objects of this worker live here, reset in cleanup
+  request_arena_t arena;
+  // the service name as the category of the trace spans, interned the first time it's needed
+  mutable const char* trace_category;
 };
 } // namespace valhalla
 